@@ -0,0 +1,172 @@
+// Copyright (C) 2020 agent
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Bounding box tree query benchmark
+// =================================
+//
+// Locates random points in a tetrahedral mesh of the unit cube using
+// the binary BoundingBoxTree (point by point with compute_collisions,
+// and with compute_collisions_batch) and the 4-wide
+// WideBoundingBoxTree (with SAH and Morton construction), and reports
+// build and query times. The number of collisions found by each method
+// is checked against compute_collisions.
+//
+// Usage:
+//
+//   mpirun -np <p> ./bench_bvh_query [n] [num_points] [num_threads]
+//
+// where n is the number of cells in each direction of the unit cube
+// (default 32), num_points is the number of points per process
+// (default 1000000) and num_threads is the number of threads used by
+// compute_collisions_batch (default 1).
+
+#include "bvh_query.h"
+#include <dolfinx.h>
+#include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/WideBoundingBoxTree.h>
+#include <dolfinx/geometry/utils.h>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace dolfinx;
+
+namespace
+{
+// Return wall time (max over processes) of f, and the total number of
+// collisions it reports
+template <typename F>
+std::pair<double, std::int64_t> time_query(MPI_Comm comm,
+                                           const std::string& name, F&& f)
+{
+  MPI_Barrier(comm);
+  common::Timer timer("Bench BVH: " + name);
+  const std::int64_t num_local = f();
+  const double t_local = timer.stop();
+
+  double t;
+  std::int64_t num;
+  MPI_Allreduce(&t_local, &t, 1, MPI_DOUBLE, MPI_MAX, comm);
+  MPI_Allreduce(&num_local, &num, 1, MPI_INT64_T, MPI_SUM, comm);
+  return {t, num};
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  common::SubSystemsManager::init_logging(argc, argv);
+  common::SubSystemsManager::init_petsc(argc, argv);
+
+  const std::size_t n = argc > 1 ? std::stoul(argv[1]) : 32;
+  const std::int32_t num_points = argc > 2 ? std::stoi(argv[2]) : 1000000;
+  const int num_threads = argc > 3 ? std::stoi(argv[3]) : 1;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+
+  // Create mesh
+  auto cmap = fem::create_coordinate_map(create_coordinate_map_bvh_query);
+  std::array<Eigen::Vector3d, 2> pt
+      = {Eigen::Vector3d(0, 0, 0), Eigen::Vector3d(1, 1, 1)};
+  auto mesh = std::make_shared<mesh::Mesh>(generation::BoxMesh::create(
+      comm, pt, {{n, n, n}}, cmap, mesh::GhostMode::none));
+  const int tdim = mesh->topology().dim();
+
+  // Random points in a box slightly larger than the unit cube
+  std::mt19937 gen(rank);
+  std::uniform_real_distribution<double> dist(-0.05, 1.05);
+  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> x(num_points, 3);
+  for (Eigen::Index i = 0; i < x.size(); ++i)
+    x.data()[i] = dist(gen);
+
+  // Build trees
+  std::vector<std::pair<std::string, double>> build_times;
+  auto time_build = [&](const std::string& name, auto&& build) {
+    MPI_Barrier(comm);
+    common::Timer timer("Bench BVH: build " + name);
+    auto tree = build();
+    build_times.push_back({name, timer.stop()});
+    return tree;
+  };
+  auto tree = time_build("binary", [&]() {
+    return std::make_unique<geometry::BoundingBoxTree>(*mesh, tdim);
+  });
+  auto tree_sah = time_build("wide (SAH)", [&]() {
+    return geometry::WideBoundingBoxTree(
+        *mesh, tdim, geometry::WideBoundingBoxTree::Construction::sah);
+  });
+  auto tree_morton = time_build("wide (Morton)", [&]() {
+    return geometry::WideBoundingBoxTree(
+        *mesh, tdim, geometry::WideBoundingBoxTree::Construction::morton);
+  });
+
+  // Run queries
+  std::vector<std::pair<std::string, std::pair<double, std::int64_t>>> results;
+  results.push_back(
+      {"binary, compute_collisions", time_query(comm, "binary", [&]() {
+         std::int64_t num = 0;
+         for (Eigen::Index i = 0; i < x.rows(); ++i)
+         {
+           const Eigen::Vector3d p = x.row(i).transpose().matrix();
+           num += geometry::compute_collisions(*tree, p).size();
+         }
+         return num;
+       })});
+  results.push_back(
+      {"binary, batch", time_query(comm, "binary batch", [&]() {
+         return (std::int64_t)geometry::compute_collisions_batch(*tree, x,
+                                                                 num_threads)
+             .array()
+             .rows();
+       })});
+  results.push_back(
+      {"wide (SAH)", time_query(comm, "wide (SAH)", [&]() {
+         std::int64_t num = 0;
+         for (Eigen::Index i = 0; i < x.rows(); ++i)
+         {
+           const Eigen::Vector3d p = x.row(i).transpose().matrix();
+           num += tree_sah.compute_collisions(p).size();
+         }
+         return num;
+       })});
+  results.push_back(
+      {"wide (SAH), batch", time_query(comm, "wide (SAH) batch", [&]() {
+         return (std::int64_t)tree_sah.compute_collisions(x).array().rows();
+       })});
+  results.push_back(
+      {"wide (Morton), batch", time_query(comm, "wide (Morton) batch", [&]() {
+         return (std::int64_t)tree_morton.compute_collisions(x).array().rows();
+       })});
+
+  if (rank == 0)
+  {
+    std::cout << "BVH query benchmark: " << dolfinx::MPI::size(comm)
+              << " processes, "
+              << mesh->topology().index_map(tdim)->size_global()
+              << " cells, " << num_points << " points per process"
+              << std::endl;
+    for (auto& [name, t] : build_times)
+      std::cout << std::setw(32) << "build " + name << std::setw(12) << t
+                << " s" << std::endl;
+
+    const std::int64_t num_ref = results[0].second.second;
+    for (auto& [name, r] : results)
+    {
+      std::cout << std::setw(32) << name << std::setw(12) << r.first << " s"
+                << std::setw(16)
+                << num_points / (1.0e6 * r.first) << " Mpts/s";
+      if (r.second != num_ref)
+        std::cout << "  (collision count " << r.second << " != " << num_ref
+                  << ")";
+      std::cout << std::endl;
+    }
+  }
+
+  list_timings(comm, {TimingType::wall});
+
+  return 0;
+}
@@ -0,0 +1,167 @@
+// Copyright (C) 2020 agent
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// HDF5 write bandwidth benchmark
+// ==============================
+//
+// Writes a tetrahedral mesh and a P2 vector function to XDMF/HDF5 a
+// number of times using different HDF5 policies, and reports the write
+// bandwidth for the mesh and function datasets.
+//
+// Usage:
+//
+//   mpirun -np <p> ./bench_hdf5_write [n] [repeats] [alignment] [chunk_rows]
+//
+// where n is the number of cells in each direction of the unit cube
+// (default 32), repeats is the number of writes of each kind (default
+// 5), alignment is the HDF5 object alignment in bytes (default 1 MiB)
+// and chunk_rows is the number of rows per chunk for the
+// "aligned+coll_metadata" policy (default 0). If chunk_rows is
+// positive, that policy writes datasets with more than chunk_rows rows
+// with chunked storage, otherwise contiguous storage is used.
+
+#include "hdf5_write.h"
+#include <dolfinx.h>
+#include <dolfinx/io/XDMFFile.h>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace dolfinx;
+
+namespace
+{
+// Time num_repeats writes of a mesh and a function (on the mesh) to an
+// XDMF file opened with the given policy, and return the wall time (max
+// over processes) for the mesh and function writes
+std::array<double, 2> time_writes(MPI_Comm comm, const std::string& filename,
+                                  const io::HDF5Policy& policy,
+                                  bool asynchronous, int num_repeats,
+                                  mesh::Mesh& mesh,
+                                  const function::Function& u)
+{
+  std::array<double, 2> t = {0.0, 0.0};
+  {
+    io::XDMFFile file(comm, filename, "w", io::XDMFFile::Encoding::HDF5,
+                      policy);
+    file.set_asynchronous(asynchronous);
+
+    MPI_Barrier(comm);
+    common::Timer t_mesh("Bench HDF5: write mesh (" + filename + ")");
+    for (int i = 0; i < num_repeats; ++i)
+    {
+      mesh.name = "mesh_" + std::to_string(i);
+      file.write_mesh(mesh);
+    }
+    file.wait();
+    MPI_Barrier(comm);
+    t[0] = t_mesh.stop();
+
+    common::Timer t_func("Bench HDF5: write function (" + filename + ")");
+    for (int i = 0; i < num_repeats; ++i)
+      file.write_function(u, i);
+    file.wait();
+    MPI_Barrier(comm);
+    t[1] = t_func.stop();
+  }
+
+  std::array<double, 2> t_max;
+  MPI_Allreduce(t.data(), t_max.data(), 2, MPI_DOUBLE, MPI_MAX, comm);
+  return t_max;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  common::SubSystemsManager::init_logging(argc, argv);
+  common::SubSystemsManager::init_petsc(argc, argv);
+
+  const std::size_t n = argc > 1 ? std::stoul(argv[1]) : 32;
+  const int num_repeats = argc > 2 ? std::stoi(argv[2]) : 5;
+  const std::int64_t alignment = argc > 3 ? std::stoll(argv[3]) : 1048576;
+  const std::int64_t chunk_rows = argc > 4 ? std::stoll(argv[4]) : 0;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+
+  // Create mesh and function
+  auto cmap = fem::create_coordinate_map(create_coordinate_map_hdf5_write);
+  std::array<Eigen::Vector3d, 2> pt
+      = {Eigen::Vector3d(0, 0, 0), Eigen::Vector3d(1, 1, 1)};
+  auto mesh = std::make_shared<mesh::Mesh>(generation::BoxMesh::create(
+      comm, pt, {{n, n, n}}, cmap, mesh::GhostMode::none));
+  auto V = fem::create_functionspace(create_functionspace_form_hdf5_write_a,
+                                     "u", mesh);
+  function::Function u(V);
+  u.interpolate([](auto& x) { return x; });
+
+  // Estimate size (bytes) of datasets written for the mesh and the
+  // function (output is interpolated to vertices)
+  const int tdim = mesh->topology().dim();
+  const std::int64_t num_cells
+      = mesh->topology().index_map(tdim)->size_global();
+  const std::int64_t num_nodes = mesh->geometry().index_map()->size_global();
+  const std::int64_t num_vertices
+      = mesh->topology().index_map(0)->size_global();
+  const double mesh_bytes
+      = num_cells * (tdim + 1) * sizeof(std::int64_t)
+        + num_nodes * 3 * sizeof(double);
+  const double function_bytes = num_vertices * 3 * sizeof(PetscScalar);
+
+  if (rank == 0)
+  {
+    std::cout << "HDF5 write benchmark: " << dolfinx::MPI::size(comm)
+              << " processes, " << num_cells << " cells, " << num_repeats
+              << " repeats" << std::endl;
+    std::cout << std::setw(24) << "policy" << std::setw(16) << "mesh (MB/s)"
+              << std::setw(20) << "function (MB/s)" << std::endl;
+  }
+
+  // Policies to compare
+  std::vector<std::pair<std::string, io::HDF5Policy>> policies;
+  policies.push_back({"default", io::HDF5Policy()});
+  {
+    io::HDF5Policy p;
+    p.alignment = {{alignment, alignment}};
+    policies.push_back({"aligned", p});
+  }
+  {
+    io::HDF5Policy p;
+    p.alignment = {{alignment, alignment}};
+    p.collective_metadata_write = true;
+    p.collective_metadata_ops = true;
+    p.chunk_rows = chunk_rows;
+    policies.push_back({"aligned+coll_metadata", p});
+  }
+  {
+    io::HDF5Policy p;
+    p.collective_transfer = false;
+    policies.push_back({"independent", p});
+  }
+
+  for (const bool asynchronous : {false, true})
+  {
+    for (auto& [name, policy] : policies)
+    {
+      const std::string label = asynchronous ? name + " (async)" : name;
+      const std::array<double, 2> t = time_writes(
+          comm, "bench_hdf5_" + name + ".xdmf", policy, asynchronous,
+          num_repeats, *mesh, u);
+      if (rank == 0)
+      {
+        std::cout << std::setw(24) << label << std::setw(16)
+                  << num_repeats * mesh_bytes / (1.0e6 * t[0])
+                  << std::setw(20)
+                  << num_repeats * function_bytes / (1.0e6 * t[1])
+                  << std::endl;
+      }
+    }
+  }
+
+  list_timings(comm, {TimingType::wall});
+
+  return 0;
+}
@@ -0,0 +1,94 @@
+// Copyright (C) 2020 agent
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+//
+// Mesh refinement benchmark
+// =========================
+//
+// Uniformly refines a tetrahedral mesh of the unit cube several times
+// with refinement::refine, and reports the time and the refinement
+// throughput (new cells per second) for each level. Run with different
+// numbers of processes to measure parallel scaling.
+//
+// Usage:
+//
+//   mpirun -np <p> ./bench_refinement [n] [num_levels] [redistribute]
+//
+// where n is the number of cells in each direction of the initial unit
+// cube (default 16), num_levels is the number of successive uniform
+// refinements (default 3) and redistribute (0 or 1, default 0) sets
+// whether the refined meshes are redistributed.
+
+#include "refinement.h"
+#include <dolfinx.h>
+#include <dolfinx/refinement/refine.h>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace dolfinx;
+
+int main(int argc, char* argv[])
+{
+  common::SubSystemsManager::init_logging(argc, argv);
+  common::SubSystemsManager::init_petsc(argc, argv);
+
+  const std::size_t n = argc > 1 ? std::stoul(argv[1]) : 16;
+  const int num_levels = argc > 2 ? std::stoi(argv[2]) : 3;
+  const bool redistribute = argc > 3 ? std::stoi(argv[3]) != 0 : false;
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  const int rank = dolfinx::MPI::rank(comm);
+
+  // Create mesh
+  auto cmap = fem::create_coordinate_map(create_coordinate_map_refinement);
+  std::array<Eigen::Vector3d, 2> pt
+      = {Eigen::Vector3d(0, 0, 0), Eigen::Vector3d(1, 1, 1)};
+  auto mesh = std::make_shared<mesh::Mesh>(generation::BoxMesh::create(
+      comm, pt, {{n, n, n}}, cmap, mesh::GhostMode::none));
+  const int tdim = mesh->topology().dim();
+
+  if (rank == 0)
+  {
+    std::cout << "Refinement benchmark: " << dolfinx::MPI::size(comm)
+              << " processes, redistribute = " << redistribute << std::endl;
+    std::cout << std::setw(8) << "level" << std::setw(16) << "cells"
+              << std::setw(16) << "refined cells" << std::setw(12) << "time"
+              << std::setw(16) << "throughput" << std::endl;
+  }
+
+  for (int level = 0; level < num_levels; ++level)
+  {
+    // Edges are required for refinement
+    mesh->topology_mutable().create_entities(1);
+
+    MPI_Barrier(comm);
+    common::Timer timer("Bench refinement: level " + std::to_string(level));
+    auto refined_mesh = std::make_shared<mesh::Mesh>(
+        refinement::refine(*mesh, redistribute));
+    const double t_local = timer.stop();
+
+    double t;
+    MPI_Allreduce(&t_local, &t, 1, MPI_DOUBLE, MPI_MAX, comm);
+
+    const std::int64_t num_cells0
+        = mesh->topology().index_map(tdim)->size_global();
+    const std::int64_t num_cells1
+        = refined_mesh->topology().index_map(tdim)->size_global();
+    if (rank == 0)
+    {
+      std::cout << std::setw(8) << level << std::setw(16) << num_cells0
+                << std::setw(16) << num_cells1 << std::setw(10) << t << " s"
+                << std::setw(10) << num_cells1 / (1.0e6 * t) << " Mcells/s"
+                << std::endl;
+    }
+
+    mesh = refined_mesh;
+  }
+
+  list_timings(comm, {TimingType::wall});
+
+  return 0;
+}
@@ -47,12 +47,12 @@ add_test(NAME ${{PROJECT_NAME}}_serial COMMAND ${{PROJECT_NAME}})
 """
 
 # Subdirectories
-sub_directories = ["demo"]
+sub_directories = ["demo", "bench"]
 # Prefix map for subdirectories
-executable_prefixes = dict(demo="demo_")
+executable_prefixes = dict(demo="demo_", bench="bench_")
 
 # Main file name map for subdirectories
-main_file_names = dict(demo=set(["main.cpp"]))
+main_file_names = dict(demo=set(["main.cpp"]), bench=set(["main.cpp"]))
 
 # Projects that use custom CMakeLists.txt (shouldn't overwrite)
 exclude_projects = []
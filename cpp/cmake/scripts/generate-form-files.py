@@ -25,7 +25,7 @@ import ffcx
 complex_mode = (sys.argv[-1] == "1")
 
 # Directories to scan
-subdirs = ["demo", "test"]
+subdirs = ["demo", "bench", "test"]
 
 # Compile all form files
 topdir = os.getcwd()
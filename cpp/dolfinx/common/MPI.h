@@ -75,7 +75,9 @@ public:
 
   /// Neighbourhood all-to-all. Send data to neighbours using offsets
   /// into contiguous data array. Offset array should contain
-  /// (num_neighbours + 1) entries, starting from zero.
+  /// (num_destinations + 1) entries, starting from zero. The graph of
+  /// the communicator need not be symmetric: the data received from
+  /// each source is returned in the order of the sources.
   template <typename T>
   static graph::AdjacencyList<T>
   neighbor_all_to_all(MPI_Comm neighbor_comm,
@@ -225,9 +227,14 @@ dolfinx::MPI::neighbor_all_to_all(MPI_Comm neighbor_comm,
   assert((int)send_data.size() == send_offsets.back());
   assert(send_offsets[0] == 0);
 
-  // Get receive sizes
-  std::vector<int> send_sizes(send_offsets.size() - 1, 0);
-  std::vector<int> recv_sizes(send_sizes.size());
+  // Get receive sizes (the number of sources may differ from the
+  // number of destinations)
+  int indegree(-1), outdegree(-2), weighted(-1);
+  MPI_Dist_graph_neighbors_count(neighbor_comm, &indegree, &outdegree,
+                                 &weighted);
+  assert((int)send_offsets.size() == outdegree + 1);
+  std::vector<int> send_sizes(outdegree, 0);
+  std::vector<int> recv_sizes(indegree);
   std::adjacent_difference(send_offsets.begin() + 1, send_offsets.end(),
                            send_sizes.begin());
   MPI_Neighbor_alltoall(send_sizes.data(), 1, MPI::mpi_type<int>(),
@@ -7,6 +7,7 @@
 #include "DirichletBC.h"
 #include "DofMap.h"
 #include "FiniteElement.h"
+#include "utils.h"
 #include <algorithm>
 #include <array>
 #include <dolfinx/common/IndexMap.h>
@@ -499,6 +500,28 @@ Eigen::Array<std::int32_t, Eigen::Dynamic, 1> _locate_dofs_geometrical(
   return Eigen::Map<Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>(dofs.data(),
                                                                    dofs.size());
 }
+//-----------------------------------------------------------------------------
+// Mark the dofs (local and ghost) of V
+std::vector<bool> compute_dof_markers(
+    const function::FunctionSpace& V,
+    const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>&
+        dofs)
+{
+  assert(V.dofmap());
+  const fem::DofMap& dofmap = *V.dofmap();
+  assert(dofmap.index_map);
+  const int num_dofs
+      = dofmap.index_map->block_size()
+        * (dofmap.index_map->size_local() + dofmap.index_map->num_ghosts());
+  std::vector<bool> markers(num_dofs, false);
+  for (Eigen::Index i = 0; i < dofs.rows(); ++i)
+  {
+    assert(dofs[i] < num_dofs);
+    markers[dofs[i]] = true;
+  }
+
+  return markers;
+}
 } // namespace
 
 //-----------------------------------------------------------------------------
@@ -548,6 +571,8 @@ DirichletBC::DirichletBC(
   auto *it = std::lower_bound(_dofs.col(0).data(),
                              _dofs.col(0).data() + _dofs.rows(), owned_size);
   _owned_indices = std::distance(_dofs.col(0).data(), it);
+  _cells = fem::compute_bc_cells(
+      *_function_space, compute_dof_markers(*_function_space, _dofs.col(0)));
 }
 //-----------------------------------------------------------------------------
 DirichletBC::DirichletBC(
@@ -562,6 +587,8 @@ DirichletBC::DirichletBC(
   auto *it = std::lower_bound(_dofs.col(0).data(),
                              _dofs.col(0).data() + _dofs.rows(), owned_size);
   _owned_indices = std::distance(_dofs.col(0).data(), it);
+  _cells = fem::compute_bc_cells(
+      *_function_space, compute_dof_markers(*_function_space, _dofs.col(0)));
 }
 //-----------------------------------------------------------------------------
 std::shared_ptr<const function::FunctionSpace>
@@ -575,6 +602,8 @@ std::shared_ptr<const function::Function> DirichletBC::value() const
   return _g;
 }
 //-----------------------------------------------------------------------------
+const std::vector<std::int32_t>& DirichletBC::cells() const { return _cells; }
+//-----------------------------------------------------------------------------
 const Eigen::Array<std::int32_t, Eigen::Dynamic, 2>& DirichletBC::dofs() const
 {
   return _dofs;
@@ -161,6 +161,12 @@ public:
   const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 2>>
   dofs_owned() const;
 
+  /// Get cells (local and ghost) that have at least one dof to which
+  /// the boundary condition is applied. The list is sorted. It is
+  /// computed when the boundary condition is created, so that lifting
+  /// only needs to visit these cells.
+  const std::vector<std::int32_t>& cells() const;
+
   /// Set bc entries in x to scale*x_bc
   /// @todo Clarify w.r.t ghosts
   void set(Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> x,
@@ -196,6 +202,9 @@ private:
 
   // The first _owned_indices in _dofs are owned by this process
   int _owned_indices = -1;
+
+  // Cells with constrained dofs
+  std::vector<std::int32_t> _cells;
 };
 } // namespace fem
 } // namespace dolfinx
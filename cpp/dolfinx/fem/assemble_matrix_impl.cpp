@@ -415,3 +415,49 @@ void fem::impl::assemble_interior_facets(
   }
 }
 //-----------------------------------------------------------------------------
+// @cond
+// protect from Doxygen
+// Explicit instantiation with PetscScalar
+template void fem::impl::assemble_cells<PetscScalar>(
+    const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                            const std::int32_t*, const PetscScalar*)>&
+        mat_set_values_local,
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_cells,
+    const graph::AdjacencyList<std::int32_t>& dofmap0, int num_dofs_per_cell0,
+    const graph::AdjacencyList<std::int32_t>& dofmap1, int num_dofs_per_cell1,
+    const std::vector<bool>& bc0, const std::vector<bool>& bc1,
+    const std::function<void(PetscScalar*, const PetscScalar*,
+                             const PetscScalar*, const double*, const int*,
+                             const std::uint8_t*, const std::uint32_t)>& kernel,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& constant_values);
+template void fem::impl::assemble_exterior_facets<PetscScalar>(
+    const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                            const std::int32_t*, const PetscScalar*)>&
+        mat_set_values_local,
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_facets,
+    const DofMap& dofmap0, const DofMap& dofmap1, const std::vector<bool>& bc0,
+    const std::vector<bool>& bc1,
+    const std::function<void(PetscScalar*, const PetscScalar*,
+                             const PetscScalar*, const double*, const int*,
+                             const std::uint8_t*, const std::uint32_t)>& fn,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, 1> constant_values);
+template void fem::impl::assemble_interior_facets<PetscScalar>(
+    const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                            const std::int32_t*, const PetscScalar*)>&
+        mat_set_values_local,
+    const mesh::Mesh& mesh, const std::vector<std::int32_t>& active_facets,
+    const DofMap& dofmap0, const DofMap& dofmap1, const std::vector<bool>& bc0,
+    const std::vector<bool>& bc1,
+    const std::function<void(PetscScalar*, const PetscScalar*,
+                             const PetscScalar*, const double*, const int*,
+                             const std::uint8_t*, const std::uint32_t)>& fn,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>& coeffs,
+    const std::vector<int>& offsets,
+    const Eigen::Array<PetscScalar, Eigen::Dynamic, 1>& constant_values);
+// @endcond
+//-----------------------------------------------------------------------------
@@ -0,0 +1,292 @@
+// Copyright (C) 2020 agent
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "assemble_system_impl.h"
+#include "DirichletBC.h"
+#include "DofMap.h"
+#include "Form.h"
+#include "assemble_matrix_impl.h"
+#include "assemble_vector_impl.h"
+#include "utils.h"
+#include <algorithm>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/function/FunctionSpace.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+
+using namespace dolfinx;
+using namespace dolfinx::fem;
+
+//-----------------------------------------------------------------------------
+void fem::impl::assemble_system(
+    const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                            const std::int32_t*, const PetscScalar*)>&
+        mat_set_values_local,
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b,
+    const Form& a, const Form& L,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>& x0,
+    double scale)
+{
+  if (a.rank() != 2 or L.rank() != 1)
+    throw std::runtime_error("Expected a bilinear and a linear form.");
+  if (a.mesh() != L.mesh())
+    throw std::runtime_error("Bilinear and linear forms must share a mesh.");
+  assert(a.function_space(0));
+  assert(L.function_space(0));
+  if (*a.function_space(0) != *L.function_space(0))
+  {
+    throw std::runtime_error(
+        "Bilinear and linear forms must have the same test space.");
+  }
+
+  assert(a.mesh());
+  const mesh::Mesh& mesh = *a.mesh();
+  mesh.topology_mutable().create_entity_permutations();
+
+  // Get dofmap data
+  const fem::DofMap& dofmap0 = *a.function_space(0)->dofmap();
+  const fem::DofMap& dofmap1 = *a.function_space(1)->dofmap();
+  const graph::AdjacencyList<std::int32_t>& dofs0 = dofmap0.list();
+  const graph::AdjacencyList<std::int32_t>& dofs1 = dofmap1.list();
+  assert(dofmap0.element_dof_layout);
+  assert(dofmap1.element_dof_layout);
+  const int num_dofs_per_cell0 = dofmap0.element_dof_layout->num_dofs();
+  const int num_dofs_per_cell1 = dofmap1.element_dof_layout->num_dofs();
+
+  // Build dof markers for rows (bc0) and columns (bc1), bc values and
+  // the cells with bc dofs in the columns. The markers are empty if no
+  // bcs apply.
+  auto map0 = dofmap0.index_map;
+  auto map1 = dofmap1.index_map;
+  assert(map0);
+  assert(map1);
+  const std::int32_t dim0
+      = map0->block_size() * (map0->size_local() + map0->num_ghosts());
+  const std::int32_t dim1
+      = map1->block_size() * (map1->size_local() + map1->num_ghosts());
+  std::vector<bool> bc0, bc1;
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> bc_values1;
+  std::vector<std::int32_t> bc_cells;
+  for (const std::shared_ptr<const DirichletBC>& bc : bcs)
+  {
+    assert(bc);
+    assert(bc->function_space());
+    if (a.function_space(0)->contains(*bc->function_space()))
+    {
+      bc0.resize(dim0, false);
+      bc->mark_dofs(bc0);
+    }
+    if (a.function_space(1)->contains(*bc->function_space()))
+    {
+      if (bc1.empty())
+      {
+        bc1.resize(dim1, false);
+        bc_values1 = Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>::Zero(dim1);
+      }
+      bc->mark_dofs(bc1);
+      bc->dof_values(bc_values1);
+      bc_cells.insert(bc_cells.end(), bc->cells().begin(), bc->cells().end());
+    }
+  }
+  std::sort(bc_cells.begin(), bc_cells.end());
+  bc_cells.erase(std::unique(bc_cells.begin(), bc_cells.end()),
+                 bc_cells.end());
+
+  // Prepare constants and coefficients
+  if (!a.all_constants_set() or !L.all_constants_set())
+    throw std::runtime_error("Unset constant in Form");
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, 1> constants_a
+      = pack_constants(a);
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, 1> constants_L
+      = pack_constants(L);
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>
+      coeffs_a = pack_coefficients(a);
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>
+      coeffs_L = pack_coefficients(L);
+
+  // The first cell integrals of a and L are computed in the same loop
+  // if they are over the same cells
+  const FormIntegrals& integrals_a = a.integrals();
+  const FormIntegrals& integrals_L = L.integrals();
+  using type = fem::FormIntegrals::Type;
+  const bool fused = integrals_a.num_integrals(type::cell) > 0
+                     and integrals_L.num_integrals(type::cell) > 0
+                     and integrals_a.integral_domains(type::cell, 0)
+                             == integrals_L.integral_domains(type::cell, 0);
+
+  const int tdim = mesh.topology().dim();
+  auto cell_map = mesh.topology().index_map(tdim);
+  assert(cell_map);
+  std::vector<bool> lifted(cell_map->size_local() + cell_map->num_ghosts(),
+                           false);
+  if (fused)
+  {
+    const auto& fn_a = integrals_a.get_tabulate_tensor(type::cell, 0);
+    const auto& fn_L = integrals_L.get_tabulate_tensor(type::cell, 0);
+
+    // Prepare cell geometry
+    const int gdim = mesh.geometry().dim();
+    const graph::AdjacencyList<std::int32_t>& x_dofmap
+        = mesh.geometry().dofmap();
+
+    // FIXME: Add proper interface for num coordinate dofs
+    const int num_dofs_g = x_dofmap.num_links(0);
+    const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+        = mesh.geometry().x();
+
+    // Data structures used in assembly
+    Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        coordinate_dofs(num_dofs_g, gdim);
+    Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+        Ae(num_dofs_per_cell0, num_dofs_per_cell1);
+    Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be(num_dofs_per_cell0);
+
+    const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+        = mesh.topology().get_cell_permutation_info();
+
+    for (std::int32_t c : integrals_a.integral_domains(type::cell, 0))
+    {
+      // Get cell coordinates/geometry
+      auto x_dofs = x_dofmap.links(c);
+      for (int i = 0; i < num_dofs_g; ++i)
+        coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
+
+      // Tabulate element matrix and vector
+      Ae.setZero();
+      fn_a(Ae.data(), coeffs_a.row(c).data(), constants_a.data(),
+           coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
+      be.setZero();
+      fn_L(be.data(), coeffs_L.row(c).data(), constants_L.data(),
+           coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
+
+      auto cell_dofs0 = dofs0.links(c);
+      auto cell_dofs1 = dofs1.links(c);
+
+      // Lift and zero columns for bc dofs, then zero rows
+      if (!bc1.empty())
+      {
+        for (Eigen::Index j = 0; j < Ae.cols(); ++j)
+        {
+          const std::int32_t jj = cell_dofs1[j];
+          if (bc1[jj])
+          {
+            const PetscScalar bc = bc_values1[jj];
+            if (x0.rows() > 0)
+              be -= Ae.col(j) * scale * (bc - x0[jj]);
+            else
+              be -= Ae.col(j) * scale * bc;
+            Ae.col(j).setZero();
+          }
+        }
+        lifted[c] = true;
+      }
+      if (!bc0.empty())
+      {
+        for (Eigen::Index i = 0; i < Ae.rows(); ++i)
+        {
+          if (bc0[cell_dofs0[i]])
+            Ae.row(i).setZero();
+        }
+      }
+
+      mat_set_values_local(num_dofs_per_cell0, cell_dofs0.data(),
+                           num_dofs_per_cell1, cell_dofs1.data(), Ae.data());
+      for (Eigen::Index i = 0; i < num_dofs_per_cell0; ++i)
+        b[cell_dofs0[i]] += be[i];
+    }
+  }
+
+  // Remaining integrals of a
+  for (int i = fused ? 1 : 0; i < integrals_a.num_integrals(type::cell); ++i)
+  {
+    const auto& fn = integrals_a.get_tabulate_tensor(type::cell, i);
+    const std::vector<std::int32_t>& active_cells
+        = integrals_a.integral_domains(type::cell, i);
+    fem::impl::assemble_cells<PetscScalar>(
+        mat_set_values_local, mesh, active_cells, dofs0, num_dofs_per_cell0,
+        dofs1, num_dofs_per_cell1, bc0, bc1, fn, coeffs_a, constants_a);
+  }
+
+  for (int i = 0; i < integrals_a.num_integrals(type::exterior_facet); ++i)
+  {
+    const auto& fn = integrals_a.get_tabulate_tensor(type::exterior_facet, i);
+    const std::vector<std::int32_t>& active_facets
+        = integrals_a.integral_domains(type::exterior_facet, i);
+    fem::impl::assemble_exterior_facets<PetscScalar>(
+        mat_set_values_local, mesh, active_facets, dofmap0, dofmap1, bc0, bc1,
+        fn, coeffs_a, constants_a);
+  }
+
+  for (int i = 0; i < integrals_a.num_integrals(type::interior_facet); ++i)
+  {
+    const std::vector<int> c_offsets = a.coefficients().offsets();
+    const auto& fn = integrals_a.get_tabulate_tensor(type::interior_facet, i);
+    const std::vector<std::int32_t>& active_facets
+        = integrals_a.integral_domains(type::interior_facet, i);
+    fem::impl::assemble_interior_facets<PetscScalar>(
+        mat_set_values_local, mesh, active_facets, dofmap0, dofmap1, bc0, bc1,
+        fn, coeffs_a, c_offsets, constants_a);
+  }
+
+  // Remaining integrals of L
+  for (int i = fused ? 1 : 0; i < integrals_L.num_integrals(type::cell); ++i)
+  {
+    const auto& fn = integrals_L.get_tabulate_tensor(type::cell, i);
+    const std::vector<std::int32_t>& active_cells
+        = integrals_L.integral_domains(type::cell, i);
+    fem::impl::assemble_cells(b, mesh, active_cells, dofs0,
+                              num_dofs_per_cell0, fn, coeffs_L, constants_L);
+  }
+
+  for (int i = 0; i < integrals_L.num_integrals(type::exterior_facet); ++i)
+  {
+    const auto& fn = integrals_L.get_tabulate_tensor(type::exterior_facet, i);
+    const std::vector<std::int32_t>& active_facets
+        = integrals_L.integral_domains(type::exterior_facet, i);
+    fem::impl::assemble_exterior_facets(b, mesh, active_facets, dofmap0, fn,
+                                        coeffs_L, constants_L);
+  }
+
+  for (int i = 0; i < integrals_L.num_integrals(type::interior_facet); ++i)
+  {
+    const std::vector<int> c_offsets = L.coefficients().offsets();
+    const auto& fn = integrals_L.get_tabulate_tensor(type::interior_facet, i);
+    const std::vector<std::int32_t>& active_facets
+        = integrals_L.integral_domains(type::interior_facet, i);
+    fem::impl::assemble_interior_facets(b, mesh, active_facets, dofmap0, fn,
+                                        coeffs_L, c_offsets, constants_L);
+  }
+
+  // Lifting that is not covered by the fused loop (bc cells outside the
+  // domain of the first cell integral and exterior facets), computed as
+  // in apply_lifting
+  if (!bc_cells.empty())
+  {
+    if (integrals_a.num_integrals(type::cell) > 0)
+    {
+      std::vector<std::int32_t> remaining_cells;
+      for (std::int32_t c : bc_cells)
+        if (!lifted[c])
+          remaining_cells.push_back(c);
+      if (!remaining_cells.empty())
+      {
+        fem::impl::lift_bc_cells(b, a, remaining_cells, bc_values1, bc1, x0,
+                                 scale);
+      }
+    }
+    if (integrals_a.num_integrals(type::exterior_facet) > 0)
+    {
+      fem::impl::lift_bc_exterior_facets(b, a, bc_cells, bc_values1, bc1, x0,
+                                         scale);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
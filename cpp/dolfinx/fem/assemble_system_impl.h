@@ -0,0 +1,60 @@
+// Copyright (C) 2020 agent
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <functional>
+#include <memory>
+#include <petscsys.h>
+#include <vector>
+
+namespace dolfinx
+{
+namespace fem
+{
+class DirichletBC;
+class Form;
+
+namespace impl
+{
+
+/// Assemble a bilinear form into a matrix and a linear form into a
+/// vector, and apply Dirichlet boundary conditions symmetrically. Cell
+/// integrals of a and L over the same cells are computed in one loop,
+/// and for each cell the columns of the element matrix for bc dofs are
+/// lifted into the element vector before the rows and columns for bc
+/// dofs are zeroed, i.e.
+///
+///   b <- b + L - scale * A (g - x0)
+///
+/// The matrix is not finalised and its diagonal is not set. Ghost
+/// contributions to b are not accumulated and bc values are not set
+/// in b.
+/// @param[in] mat_set_values_local Function that adds values to the
+///                                 matrix using local indices
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+///                  before assembly.
+/// @param[in] a The bilinear form to assemble
+/// @param[in] L The linear form to assemble. It must have the same test
+///              space as a.
+/// @param[in] bcs The boundary conditions
+/// @param[in] x0 The array used in the lifting. If it is empty, it is
+///               treated as zero.
+/// @param[in] scale Scaling to apply to the lifting
+void assemble_system(
+    const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                            const std::int32_t*, const PetscScalar*)>&
+        mat_set_values_local,
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b,
+    const Form& a, const Form& L,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>& x0,
+    double scale);
+
+} // namespace impl
+} // namespace fem
+} // namespace dolfinx
@@ -9,6 +9,7 @@
 #include "DofMap.h"
 #include "Form.h"
 #include "utils.h"
+#include <algorithm>
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/types.h>
 #include <dolfinx/function/Constant.h>
@@ -25,328 +26,290 @@ using namespace dolfinx::fem;
 
 namespace
 {
-//-----------------------------------------------------------------------------
-// Implementation of bc application
-void _lift_bc_cells(
+//----------------------------------------------------------------------------
+void _lift_bc(
     Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& a,
+    const std::vector<std::int32_t>& bc_cells,
     const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>&
         bc_values1,
     const std::vector<bool>& bc_markers1,
     const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>& x0,
     double scale)
 {
-  assert(a.rank() == 2);
-
-  // Get mesh from form
-  assert(a.mesh());
-  const mesh::Mesh& mesh = *a.mesh();
-
-  mesh.topology_mutable().create_entity_permutations();
-
-  // Get dofmap for columns and rows of a
-  assert(a.function_space(0));
-  assert(a.function_space(0)->dofmap());
-  assert(a.function_space(1));
-  assert(a.function_space(1)->dofmap());
-  const fem::DofMap& dofmap0 = *a.function_space(0)->dofmap();
-  const fem::DofMap& dofmap1 = *a.function_space(1)->dofmap();
-
-  // Prepare coefficients
-  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      coeffs = pack_coefficients(a);
-
-  const std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
-                           const double*, const int*, const std::uint8_t*,
-                           const std::uint32_t)>& fn
-      = a.integrals().get_tabulate_tensor(FormIntegrals::Type::cell, 0);
+  if (a.integrals().num_integrals(fem::FormIntegrals::Type::cell) > 0)
+  {
+    fem::impl::lift_bc_cells(b, a, bc_cells, bc_values1, bc_markers1, x0,
+                             scale);
+  }
+  if (a.integrals().num_integrals(fem::FormIntegrals::Type::exterior_facet) > 0)
+  {
+    fem::impl::lift_bc_exterior_facets(b, a, bc_cells, bc_values1,
+                                       bc_markers1, x0, scale);
+  }
+}
+} // namespace
 
-  // Prepare cell geometry
-  const int gdim = mesh.geometry().dim();
-  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+//-----------------------------------------------------------------------------
+void fem::impl::assemble_vector(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L)
+{
+  assert(L.mesh());
+  const mesh::Mesh& mesh = *L.mesh();
 
-  // FIXME: Add proper interface for num coordinate dofs
-  const int num_dofs_g = x_dofmap.num_links(0);
-  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
-      = mesh.geometry().x();
+  // Get dofmap data
+  const fem::DofMap& dofmap = *L.function_space(0)->dofmap();
+  const graph::AdjacencyList<std::int32_t>& dofs = dofmap.list();
 
-  // Data structures used in bc application
-  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      coordinate_dofs(num_dofs_g, gdim);
-  Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      Ae;
-  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be;
+  assert(dofmap.element_dof_layout);
+  const int num_dofs_per_cell = dofmap.element_dof_layout->num_dofs();
 
   // Prepare constants
-  if (!a.all_constants_set())
+  if (!L.all_constants_set())
     throw std::runtime_error("Unset constant in Form");
   const Eigen::Array<PetscScalar, Eigen::Dynamic, 1> constant_values
-      = pack_constants(a);
+      = pack_constants(L);
 
-  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
-      = mesh.topology().get_cell_permutation_info();
+  // Prepare coefficients
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>
+      coeffs = pack_coefficients(L);
 
-  // Iterate over all cells
-  const int tdim = mesh.topology().dim();
-  auto map = mesh.topology().index_map(tdim);
-  assert(map);
-  const int num_cells = map->size_local() + map->num_ghosts();
-  for (int c = 0; c < num_cells; ++c)
+  const FormIntegrals& integrals = L.integrals();
+  using type = fem::FormIntegrals::Type;
+  for (int i = 0; i < integrals.num_integrals(type::cell); ++i)
   {
-    // Get dof maps for cell
-    auto dmap1 = dofmap1.cell_dofs(c);
-
-    // Check if bc is applied to cell
-    bool has_bc = false;
-    for (Eigen::Index j = 0; j < dmap1.size(); ++j)
-    {
-      if (bc_markers1[dmap1[j]])
-      {
-        has_bc = true;
-        break;
-      }
-    }
-
-    if (!has_bc)
-      continue;
-
-    // Get cell vertex coordinates
-    auto x_dofs = x_dofmap.links(c);
-    for (int i = 0; i < num_dofs_g; ++i)
-      coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
-
-    // Size data structure for assembly
-    auto dmap0 = dofmap0.cell_dofs(c);
-
-    auto coeff_array = coeffs.row(c);
-    Ae.setZero(dmap0.size(), dmap1.size());
-    fn(Ae.data(), coeff_array.data(), constant_values.data(),
-       coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
+    const auto& fn
+        = integrals.get_tabulate_tensor(FormIntegrals::Type::cell, i);
+    const std::vector<std::int32_t>& active_cells
+        = integrals.integral_domains(type::cell, i);
+    fem::impl::assemble_cells(b, mesh, active_cells, dofs, num_dofs_per_cell,
+                              fn, coeffs, constant_values);
+  }
 
-    // Size data structure for assembly
-    be.setZero(dmap0.size());
-    for (Eigen::Index j = 0; j < dmap1.size(); ++j)
-    {
-      const std::int32_t jj = dmap1[j];
-      if (bc_markers1[jj])
-      {
-        const PetscScalar bc = bc_values1[jj];
-        if (x0.rows() > 0)
-          be -= Ae.col(j) * scale * (bc - x0[jj]);
-        else
-          be -= Ae.col(j) * scale * bc;
-      }
-    }
+  for (int i = 0; i < integrals.num_integrals(type::exterior_facet); ++i)
+  {
+    const auto& fn
+        = integrals.get_tabulate_tensor(FormIntegrals::Type::exterior_facet, i);
+    const std::vector<std::int32_t>& active_facets
+        = integrals.integral_domains(type::exterior_facet, i);
+    fem::impl::assemble_exterior_facets(b, mesh, active_facets, dofmap, fn,
+                                        coeffs, constant_values);
+  }
 
-    for (Eigen::Index k = 0; k < dmap0.size(); ++k)
-      b[dmap0[k]] += be[k];
+  for (int i = 0; i < integrals.num_integrals(type::interior_facet); ++i)
+  {
+    const std::vector<int> c_offsets = L.coefficients().offsets();
+    const auto& fn
+        = integrals.get_tabulate_tensor(FormIntegrals::Type::interior_facet, i);
+    const std::vector<std::int32_t>& active_facets
+        = integrals.integral_domains(type::interior_facet, i);
+    fem::impl::assemble_interior_facets(b, mesh, active_facets, dofmap, fn,
+                                        coeffs, c_offsets, constant_values);
   }
 }
-//----------------------------------------------------------------------------
-void _lift_bc_exterior_facets(
-    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& a,
-    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>&
-        bc_values1,
-    const std::vector<bool>& bc_markers1,
+//-----------------------------------------------------------------------------
+void fem::impl::assemble_vector(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L,
+    const Form& a, const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
     const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>& x0,
     double scale)
 {
-  assert(a.rank() == 2);
-
-  // Get mesh from form
-  assert(a.mesh());
-  const mesh::Mesh& mesh = *a.mesh();
+  assert(L.rank() == 1);
+  if (a.rank() != 2)
+    throw std::runtime_error("Form for lifting must be bilinear.");
+  if (L.mesh() != a.mesh())
+    throw std::runtime_error("Linear and bilinear forms must share a mesh.");
+  assert(L.function_space(0));
+  assert(a.function_space(0));
+  if (*L.function_space(0) != *a.function_space(0))
+  {
+    throw std::runtime_error(
+        "Linear and bilinear forms must have the same test space.");
+  }
 
-  mesh.topology_mutable().create_entity_permutations();
+  // Build bc markers, values and cells for the trial space of a
+  auto V1 = a.function_space(1);
+  assert(V1);
+  auto map1 = V1->dofmap()->index_map;
+  assert(map1);
+  const int crange
+      = map1->block_size() * (map1->size_local() + map1->num_ghosts());
+  std::vector<bool> bc_markers1(crange, false);
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> bc_values1
+      = Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>::Zero(crange);
+  std::vector<std::int32_t> bc_cells;
+  for (const std::shared_ptr<const DirichletBC>& bc : bcs)
+  {
+    assert(bc);
+    if (V1->contains(*bc->function_space()))
+    {
+      bc->mark_dofs(bc_markers1);
+      bc->dof_values(bc_values1);
+      bc_cells.insert(bc_cells.end(), bc->cells().begin(), bc->cells().end());
+    }
+  }
+  std::sort(bc_cells.begin(), bc_cells.end());
+  bc_cells.erase(std::unique(bc_cells.begin(), bc_cells.end()),
+                 bc_cells.end());
 
-  const int gdim = mesh.geometry().dim();
-  const int tdim = mesh.topology().dim();
+  const FormIntegrals& integrals = L.integrals();
+  using type = fem::FormIntegrals::Type;
+  if (bc_cells.empty() or integrals.num_integrals(type::cell) == 0
+      or a.integrals().num_integrals(type::cell) == 0)
+  {
+    // Nothing to fuse
+    fem::impl::assemble_vector(b, L);
+    if (!bc_cells.empty())
+      _lift_bc(b, a, bc_cells, bc_values1, bc_markers1, x0, scale);
+    return;
+  }
 
-  // FIXME: cleanup these calls? Some of the happen internally again.
-  mesh.topology_mutable().create_entities(tdim - 1);
-  mesh.topology_mutable().create_connectivity(tdim - 1, tdim);
-  // FIXME: Why again -- appears already See 8 lines above.
+  assert(L.mesh());
+  const mesh::Mesh& mesh = *L.mesh();
   mesh.topology_mutable().create_entity_permutations();
+  const int tdim = mesh.topology().dim();
 
-  // Get dofmap for columns and rows of a
-  assert(a.function_space(0));
-  assert(a.function_space(0)->dofmap());
-  assert(a.function_space(1));
-  assert(a.function_space(1)->dofmap());
-  const fem::DofMap& dofmap0 = *a.function_space(0)->dofmap();
-  const fem::DofMap& dofmap1 = *a.function_space(1)->dofmap();
+  // Position of each cell in bc_cells (-1 if the cell has no bc dofs)
+  auto cell_map = mesh.topology().index_map(tdim);
+  assert(cell_map);
+  std::vector<std::int32_t> bc_cell_pos(
+      cell_map->size_local() + cell_map->num_ghosts(), -1);
+  for (std::size_t i = 0; i < bc_cells.size(); ++i)
+    bc_cell_pos[bc_cells[i]] = i;
 
-  // Prepare coefficients
-  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
-      coeffs = pack_coefficients(a);
+  // Get dofmap data
+  const fem::DofMap& dofmap0 = *L.function_space(0)->dofmap();
+  const fem::DofMap& dofmap1 = *V1->dofmap();
+  assert(dofmap0.element_dof_layout);
+  const int num_dofs_per_cell = dofmap0.element_dof_layout->num_dofs();
+
+  // Prepare constants and coefficients. The coefficients of a are
+  // packed for the bc cells only (row i is for bc_cells[i]).
+  if (!L.all_constants_set() or !a.all_constants_set())
+    throw std::runtime_error("Unset constant in Form");
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, 1> constants_L
+      = pack_constants(L);
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, 1> constants_a
+      = pack_constants(a);
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>
+      coeffs_L = pack_coefficients(L);
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>
+      coeffs_a = pack_coefficients(a, bc_cells);
 
-  const std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
-                           const double*, const int*, const std::uint8_t*,
-                           const std::uint32_t)>& fn
-      = a.integrals().get_tabulate_tensor(FormIntegrals::Type::exterior_facet,
-                                          0);
+  const auto& fn_L = integrals.get_tabulate_tensor(type::cell, 0);
+  const auto& fn_a = a.integrals().get_tabulate_tensor(type::cell, 0);
 
   // Prepare cell geometry
+  const int gdim = mesh.geometry().dim();
   const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+
   // FIXME: Add proper interface for num coordinate dofs
   const int num_dofs_g = x_dofmap.num_links(0);
   const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
       = mesh.geometry().x();
 
-  // Data structures used in bc application
+  // Create data structures used in assembly
   Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       coordinate_dofs(num_dofs_g, gdim);
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be(num_dofs_per_cell);
   Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
       Ae;
-  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be;
 
-  // Prepare constants
-  if (!a.all_constants_set())
-    throw std::runtime_error("Unset constant in Form");
-  const Eigen::Array<PetscScalar, Eigen::Dynamic, 1> constant_values
-      = pack_constants(a);
-
-  // Iterate over owned facets
-  const mesh::Topology& topology = mesh.topology();
-  auto connectivity = topology.connectivity(tdim - 1, tdim);
-  assert(connectivity);
-  auto c_to_f = topology.connectivity(tdim, tdim - 1);
-  assert(c_to_f);
-  auto map = topology.index_map(tdim - 1);
-  assert(map);
-
-  const Eigen::Array<std::uint8_t, Eigen::Dynamic, Eigen::Dynamic>& perms
-      = mesh.topology().get_facet_permutations();
   const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
       = mesh.topology().get_cell_permutation_info();
 
-  for (int f = 0; f < map->size_local(); ++f)
+  // Assemble the first cell integral of L, and lift bcs on the same
+  // cells with the geometry gathered once per cell
+  std::vector<bool> lifted(bc_cells.size(), false);
+  for (std::int32_t c : integrals.integral_domains(type::cell, 0))
   {
-    // Move to next facet if this one is an interior facet
-    if (topology.interior_facets()[f])
-      continue;
-
-    // Create attached cell
-    assert(connectivity->num_links(f) == 1);
-    const std::int32_t cell = connectivity->links(f)[0];
-
-    // Get local index of facet with respect to the cell
-    auto facets = c_to_f->links(cell);
-    const auto* it = std::find(facets.data(), facets.data() + facets.rows(), f);
-    assert(it != (facets.data() + facets.rows()));
-    const int local_facet = std::distance(facets.data(), it);
-
-    const std::uint8_t perm = perms(local_facet, cell);
-
-    // Get dof maps for cell
-    auto dmap1 = dofmap1.cell_dofs(cell);
-
-    // Check if bc is applied to cell
-    bool has_bc = false;
-    for (Eigen::Index j = 0; j < dmap1.size(); ++j)
-    {
-      if (bc_markers1[dmap1[j]])
-      {
-        has_bc = true;
-        break;
-      }
-    }
-
-    if (!has_bc)
-      continue;
-
-    // Get cell vertex coordinates
-    auto x_dofs = x_dofmap.links(cell);
+    // Get cell coordinates/geometry
+    auto x_dofs = x_dofmap.links(c);
     for (int i = 0; i < num_dofs_g; ++i)
       coordinate_dofs.row(i) = x_g.row(x_dofs[i]).head(gdim);
 
-    // Size data structure for assembly
-    auto dmap0 = dofmap0.cell_dofs(cell);
-
-    // TODO: Move gathering of coefficients outside of main assembly
-    // loop
-
-    auto coeff_array = coeffs.row(cell);
-    Ae.setZero(dmap0.size(), dmap1.size());
-    fn(Ae.data(), coeff_array.data(), constant_values.data(),
-       coordinate_dofs.data(), &local_facet, &perm, cell_info[cell]);
+    // Tabulate vector for cell
+    auto coeff_cell = coeffs_L.row(c);
+    be.setZero();
+    fn_L(be.data(), coeff_cell.data(), constants_L.data(),
+         coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
 
-    // Size data structure for assembly
-    be.setZero(dmap0.size());
-    for (Eigen::Index j = 0; j < dmap1.size(); ++j)
+    // Lift bcs
+    const std::int32_t pos = bc_cell_pos[c];
+    if (pos >= 0)
     {
-      const std::int32_t jj = dmap1[j];
-      if (bc_markers1[jj])
+      auto dmap1 = dofmap1.cell_dofs(c);
+      Ae.setZero(num_dofs_per_cell, dmap1.size());
+      fn_a(Ae.data(), coeffs_a.row(pos).data(), constants_a.data(),
+           coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
+      for (Eigen::Index j = 0; j < dmap1.size(); ++j)
       {
-        const PetscScalar bc = bc_values1[jj];
-        if (x0.rows() > 0)
-          be -= Ae.col(j) * scale * (bc - x0[jj]);
-        else
-          be -= Ae.col(j) * scale * bc;
+        const std::int32_t jj = dmap1[j];
+        if (bc_markers1[jj])
+        {
+          const PetscScalar bc = bc_values1[jj];
+          if (x0.rows() > 0)
+            be -= Ae.col(j) * scale * (bc - x0[jj]);
+          else
+            be -= Ae.col(j) * scale * bc;
+        }
       }
+      lifted[pos] = true;
     }
 
-    for (Eigen::Index k = 0; k < dmap0.size(); ++k)
-      b[dmap0[k]] += be[k];
+    // Scatter cell vector to 'global' vector array
+    auto dofs = dofmap0.cell_dofs(c);
+    for (Eigen::Index i = 0; i < num_dofs_per_cell; ++i)
+      b[dofs[i]] += be[i];
   }
-}
-} // namespace
 
-//-----------------------------------------------------------------------------
-void fem::impl::assemble_vector(
-    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L)
-{
-  assert(L.mesh());
-  const mesh::Mesh& mesh = *L.mesh();
-
-  // Get dofmap data
-  const fem::DofMap& dofmap = *L.function_space(0)->dofmap();
-  const graph::AdjacencyList<std::int32_t>& dofs = dofmap.list();
-
-  assert(dofmap.element_dof_layout);
-  const int num_dofs_per_cell = dofmap.element_dof_layout->num_dofs();
-
-  // Prepare constants
-  if (!L.all_constants_set())
-    throw std::runtime_error("Unset constant in Form");
-  const Eigen::Array<PetscScalar, Eigen::Dynamic, 1> constant_values
-      = pack_constants(L);
-
-  // Prepare coefficients
-  const Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
-                     Eigen::RowMajor>
-      coeffs = pack_coefficients(L);
+  // Lift bcs on cells that are not in the first cell integral of L
+  // (e.g. ghost cells)
+  std::vector<std::int32_t> remaining_cells;
+  for (std::size_t i = 0; i < bc_cells.size(); ++i)
+    if (!lifted[i])
+      remaining_cells.push_back(bc_cells[i]);
+  if (!remaining_cells.empty())
+  {
+    fem::impl::lift_bc_cells(b, a, remaining_cells, bc_values1, bc_markers1,
+                             x0, scale);
+  }
+  if (a.integrals().num_integrals(type::exterior_facet) > 0)
+  {
+    fem::impl::lift_bc_exterior_facets(b, a, bc_cells, bc_values1,
+                                       bc_markers1, x0, scale);
+  }
 
-  const FormIntegrals& integrals = L.integrals();
-  using type = fem::FormIntegrals::Type;
-  for (int i = 0; i < integrals.num_integrals(type::cell); ++i)
+  // Remaining integrals of L
+  const graph::AdjacencyList<std::int32_t>& dofs = dofmap0.list();
+  for (int i = 1; i < integrals.num_integrals(type::cell); ++i)
   {
-    const auto& fn
-        = integrals.get_tabulate_tensor(FormIntegrals::Type::cell, i);
+    const auto& fn = integrals.get_tabulate_tensor(type::cell, i);
     const std::vector<std::int32_t>& active_cells
         = integrals.integral_domains(type::cell, i);
     fem::impl::assemble_cells(b, mesh, active_cells, dofs, num_dofs_per_cell,
-                              fn, coeffs, constant_values);
+                              fn, coeffs_L, constants_L);
   }
 
   for (int i = 0; i < integrals.num_integrals(type::exterior_facet); ++i)
   {
-    const auto& fn
-        = integrals.get_tabulate_tensor(FormIntegrals::Type::exterior_facet, i);
+    const auto& fn = integrals.get_tabulate_tensor(type::exterior_facet, i);
     const std::vector<std::int32_t>& active_facets
         = integrals.integral_domains(type::exterior_facet, i);
-    fem::impl::assemble_exterior_facets(b, mesh, active_facets, dofmap, fn,
-                                        coeffs, constant_values);
+    fem::impl::assemble_exterior_facets(b, mesh, active_facets, dofmap0, fn,
+                                        coeffs_L, constants_L);
   }
 
   for (int i = 0; i < integrals.num_integrals(type::interior_facet); ++i)
   {
     const std::vector<int> c_offsets = L.coefficients().offsets();
-    const auto& fn
-        = integrals.get_tabulate_tensor(FormIntegrals::Type::interior_facet, i);
+    const auto& fn = integrals.get_tabulate_tensor(type::interior_facet, i);
     const std::vector<std::int32_t>& active_facets
         = integrals.integral_domains(type::interior_facet, i);
-    fem::impl::assemble_interior_facets(b, mesh, active_facets, dofmap, fn,
-                                        coeffs, c_offsets, constant_values);
+    fem::impl::assemble_interior_facets(b, mesh, active_facets, dofmap0, fn,
+                                        coeffs_L, c_offsets, constants_L);
   }
 }
 //-----------------------------------------------------------------------------
@@ -619,17 +582,259 @@ void fem::impl::apply_lifting(
           = map1->block_size() * (map1->size_local() + map1->num_ghosts());
       bc_markers1.assign(crange, false);
       bc_values1 = Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>::Zero(crange);
+      std::vector<std::int32_t> bc_cells;
       for (const std::shared_ptr<const DirichletBC>& bc : bcs1[j])
       {
         bc->mark_dofs(bc_markers1);
         bc->dof_values(bc_values1);
+        bc_cells.insert(bc_cells.end(), bc->cells().begin(),
+                        bc->cells().end());
+      }
+
+      // Cells with bc dofs (cached by the bcs)
+      if (bcs1[j].size() > 1)
+      {
+        std::sort(bc_cells.begin(), bc_cells.end());
+        bc_cells.erase(std::unique(bc_cells.begin(), bc_cells.end()),
+                       bc_cells.end());
       }
 
       // Modify (apply lifting) vector
       if (!x0.empty())
-        fem::impl::lift_bc(b, *a[j], bc_values1, bc_markers1, x0[j], scale);
+        _lift_bc(b, *a[j], bc_cells, bc_values1, bc_markers1, x0[j], scale);
       else
-        fem::impl::lift_bc(b, *a[j], bc_values1, bc_markers1, scale);
+      {
+        const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> x0_empty(0);
+        _lift_bc(b, *a[j], bc_cells, bc_values1, bc_markers1, x0_empty,
+                 scale);
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void fem::impl::lift_bc_cells(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& a,
+    const std::vector<std::int32_t>& bc_cells,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>&
+        bc_values1,
+    const std::vector<bool>& bc_markers1,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>& x0,
+    double scale)
+{
+  assert(a.rank() == 2);
+
+  // Get mesh from form
+  assert(a.mesh());
+  const mesh::Mesh& mesh = *a.mesh();
+
+  mesh.topology_mutable().create_entity_permutations();
+
+  // Get dofmap for columns and rows of a
+  assert(a.function_space(0));
+  assert(a.function_space(0)->dofmap());
+  assert(a.function_space(1));
+  assert(a.function_space(1)->dofmap());
+  const fem::DofMap& dofmap0 = *a.function_space(0)->dofmap();
+  const fem::DofMap& dofmap1 = *a.function_space(1)->dofmap();
+
+  // Prepare coefficients (row i is for bc_cells[i])
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coeffs = pack_coefficients(a, bc_cells);
+
+  const std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                           const double*, const int*, const std::uint8_t*,
+                           const std::uint32_t)>& fn
+      = a.integrals().get_tabulate_tensor(FormIntegrals::Type::cell, 0);
+
+  // Prepare cell geometry
+  const int gdim = mesh.geometry().dim();
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+
+  // FIXME: Add proper interface for num coordinate dofs
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().x();
+
+  // Data structures used in bc application
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(num_dofs_g, gdim);
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      Ae;
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be;
+
+  // Prepare constants
+  if (!a.all_constants_set())
+    throw std::runtime_error("Unset constant in Form");
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, 1> constant_values
+      = pack_constants(a);
+
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh.topology().get_cell_permutation_info();
+
+  // Iterate over cells with bcs
+  for (std::size_t i = 0; i < bc_cells.size(); ++i)
+  {
+    const std::int32_t c = bc_cells[i];
+
+    // Get dof maps for cell
+    auto dmap1 = dofmap1.cell_dofs(c);
+
+    // Get cell vertex coordinates
+    auto x_dofs = x_dofmap.links(c);
+    for (int k = 0; k < num_dofs_g; ++k)
+      coordinate_dofs.row(k) = x_g.row(x_dofs[k]).head(gdim);
+
+    // Size data structure for assembly
+    auto dmap0 = dofmap0.cell_dofs(c);
+
+    auto coeff_array = coeffs.row(i);
+    Ae.setZero(dmap0.size(), dmap1.size());
+    fn(Ae.data(), coeff_array.data(), constant_values.data(),
+       coordinate_dofs.data(), nullptr, nullptr, cell_info[c]);
+
+    // Size data structure for assembly
+    be.setZero(dmap0.size());
+    for (Eigen::Index j = 0; j < dmap1.size(); ++j)
+    {
+      const std::int32_t jj = dmap1[j];
+      if (bc_markers1[jj])
+      {
+        const PetscScalar bc = bc_values1[jj];
+        if (x0.rows() > 0)
+          be -= Ae.col(j) * scale * (bc - x0[jj]);
+        else
+          be -= Ae.col(j) * scale * bc;
+      }
+    }
+
+    for (Eigen::Index k = 0; k < dmap0.size(); ++k)
+      b[dmap0[k]] += be[k];
+  }
+}
+//-----------------------------------------------------------------------------
+void fem::impl::lift_bc_exterior_facets(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& a,
+    const std::vector<std::int32_t>& bc_cells,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>&
+        bc_values1,
+    const std::vector<bool>& bc_markers1,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>& x0,
+    double scale)
+{
+  assert(a.rank() == 2);
+
+  // Get mesh from form
+  assert(a.mesh());
+  const mesh::Mesh& mesh = *a.mesh();
+
+  mesh.topology_mutable().create_entity_permutations();
+
+  const int gdim = mesh.geometry().dim();
+  const int tdim = mesh.topology().dim();
+
+  // FIXME: cleanup these calls? Some of the happen internally again.
+  mesh.topology_mutable().create_entities(tdim - 1);
+  mesh.topology_mutable().create_connectivity(tdim - 1, tdim);
+  // FIXME: Why again -- appears already See 8 lines above.
+  mesh.topology_mutable().create_entity_permutations();
+
+  // Get dofmap for columns and rows of a
+  assert(a.function_space(0));
+  assert(a.function_space(0)->dofmap());
+  assert(a.function_space(1));
+  assert(a.function_space(1)->dofmap());
+  const fem::DofMap& dofmap0 = *a.function_space(0)->dofmap();
+  const fem::DofMap& dofmap1 = *a.function_space(1)->dofmap();
+
+  // Prepare coefficients (row i is for bc_cells[i])
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coeffs = pack_coefficients(a, bc_cells);
+
+  const std::function<void(PetscScalar*, const PetscScalar*, const PetscScalar*,
+                           const double*, const int*, const std::uint8_t*,
+                           const std::uint32_t)>& fn
+      = a.integrals().get_tabulate_tensor(FormIntegrals::Type::exterior_facet,
+                                          0);
+
+  // Prepare cell geometry
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+  // FIXME: Add proper interface for num coordinate dofs
+  const int num_dofs_g = x_dofmap.num_links(0);
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g
+      = mesh.geometry().x();
+
+  // Data structures used in bc application
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs(num_dofs_g, gdim);
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      Ae;
+  Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> be;
+
+  // Prepare constants
+  if (!a.all_constants_set())
+    throw std::runtime_error("Unset constant in Form");
+  const Eigen::Array<PetscScalar, Eigen::Dynamic, 1> constant_values
+      = pack_constants(a);
+
+  // Iterate over owned exterior facets of cells with bcs. An exterior
+  // facet is attached to one cell only, so each facet is visited once.
+  const mesh::Topology& topology = mesh.topology();
+  auto c_to_f = topology.connectivity(tdim, tdim - 1);
+  assert(c_to_f);
+  auto map = topology.index_map(tdim - 1);
+  assert(map);
+  const std::vector<bool>& interior_facets = topology.interior_facets();
+
+  const Eigen::Array<std::uint8_t, Eigen::Dynamic, Eigen::Dynamic>& perms
+      = mesh.topology().get_facet_permutations();
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info
+      = mesh.topology().get_cell_permutation_info();
+
+  for (std::size_t i = 0; i < bc_cells.size(); ++i)
+  {
+    const std::int32_t cell = bc_cells[i];
+    auto facets = c_to_f->links(cell);
+    for (int local_facet = 0; local_facet < facets.rows(); ++local_facet)
+    {
+      const std::int32_t f = facets[local_facet];
+      if (f >= map->size_local() or interior_facets[f])
+        continue;
+
+      const std::uint8_t perm = perms(local_facet, cell);
+
+      // Get dof maps for cell
+      auto dmap1 = dofmap1.cell_dofs(cell);
+
+      // Get cell vertex coordinates
+      auto x_dofs = x_dofmap.links(cell);
+      for (int k = 0; k < num_dofs_g; ++k)
+        coordinate_dofs.row(k) = x_g.row(x_dofs[k]).head(gdim);
+
+      // Size data structure for assembly
+      auto dmap0 = dofmap0.cell_dofs(cell);
+
+      auto coeff_array = coeffs.row(i);
+      Ae.setZero(dmap0.size(), dmap1.size());
+      fn(Ae.data(), coeff_array.data(), constant_values.data(),
+         coordinate_dofs.data(), &local_facet, &perm, cell_info[cell]);
+
+      // Size data structure for assembly
+      be.setZero(dmap0.size());
+      for (Eigen::Index j = 0; j < dmap1.size(); ++j)
+      {
+        const std::int32_t jj = dmap1[j];
+        if (bc_markers1[jj])
+        {
+          const PetscScalar bc = bc_values1[jj];
+          if (x0.rows() > 0)
+            be -= Ae.col(j) * scale * (bc - x0[jj]);
+          else
+            be -= Ae.col(j) * scale * bc;
+        }
+      }
+
+      for (Eigen::Index k = 0; k < dmap0.size(); ++k)
+        b[dmap0[k]] += be[k];
     }
   }
 }
@@ -641,10 +846,7 @@ void fem::impl::lift_bc(
     const std::vector<bool>& bc_markers1, double scale)
 {
   const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> x0(0);
-  if (a.integrals().num_integrals(fem::FormIntegrals::Type::cell) > 0)
-    _lift_bc_cells(b, a, bc_values1, bc_markers1, x0, scale);
-  if (a.integrals().num_integrals(fem::FormIntegrals::Type::exterior_facet) > 0)
-    _lift_bc_exterior_facets(b, a, bc_values1, bc_markers1, x0, scale);
+  fem::impl::lift_bc(b, a, bc_values1, bc_markers1, x0, scale);
 }
 //-----------------------------------------------------------------------------
 void fem::impl::lift_bc(
@@ -655,9 +857,8 @@ void fem::impl::lift_bc(
     const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>& x0,
     double scale)
 {
-  if (a.integrals().num_integrals(fem::FormIntegrals::Type::cell) > 0)
-    _lift_bc_cells(b, a, bc_values1, bc_markers1, x0, scale);
-  if (a.integrals().num_integrals(fem::FormIntegrals::Type::exterior_facet) > 0)
-    _lift_bc_exterior_facets(b, a, bc_values1, bc_markers1, x0, scale);
+  assert(a.function_space(1));
+  _lift_bc(b, a, fem::compute_bc_cells(*a.function_space(1), bc_markers1),
+           bc_values1, bc_markers1, x0, scale);
 }
 //-----------------------------------------------------------------------------
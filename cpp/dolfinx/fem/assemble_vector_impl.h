@@ -49,6 +49,30 @@ namespace impl
 void assemble_vector(
     Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L);
 
+/// Assemble linear form into an Eigen vector and lift boundary
+/// conditions in the same loop over cells, i.e.
+///
+///   b <- b + L - scale * A (g - x0)
+///
+/// The element tensor of a is computed only for cells with bc dofs,
+/// reusing the cell geometry gathered for L. Ghost contributions are
+/// not accumulated and bc values are not set.
+/// @param[in,out] b The vector to be assembled. It will not be zeroed
+///                  before assembly.
+/// @param[in] L The linear form to assemble into b
+/// @param[in] a The bilinear form that generates A. It must have the
+///              same test space as L.
+/// @param[in] bcs The boundary conditions. Conditions that are not on
+///                the trial space of a are ignored.
+/// @param[in] x0 The array used in the lifting. If it is empty, it is
+///               treated as zero.
+/// @param[in] scale Scaling to apply to the lifting
+void assemble_vector(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L,
+    const Form& a, const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>& x0,
+    double scale);
+
 /// Execute kernel over cells and accumulate result in vector
 void assemble_cells(
     Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b,
@@ -147,6 +171,56 @@ void lift_bc(
     const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>& x0,
     double scale);
 
+/// Modify b such that:
+///
+///   b <- b - scale * A_c (x_bc - x0)
+///
+/// where A_c is the contribution of the first cell integral of a from
+/// the given cells
+/// @param[in,out] b The vector to be modified
+/// @param[in] a The bilinear form that generates A
+/// @param[in] bc_cells The cells to visit, typically the cells with
+///                     bc dofs
+/// @param[in] bc_values1 The boundary condition 'values'
+/// @param[in] bc_markers1 The indices (columns of A, rows of x) to
+///                        which bcs belong
+/// @param[in] x0 The array used in the lifting. If it is empty, it is
+///               treated as zero.
+/// @param[in] scale Scaling to apply
+void lift_bc_cells(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& a,
+    const std::vector<std::int32_t>& bc_cells,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>&
+        bc_values1,
+    const std::vector<bool>& bc_markers1,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>& x0,
+    double scale);
+
+/// Modify b such that:
+///
+///   b <- b - scale * A_f (x_bc - x0)
+///
+/// where A_f is the contribution of the first exterior facet integral
+/// of a from the owned exterior facets of the given cells
+/// @param[in,out] b The vector to be modified
+/// @param[in] a The bilinear form that generates A
+/// @param[in] bc_cells The cells whose exterior facets are visited,
+///                     typically the cells with bc dofs
+/// @param[in] bc_values1 The boundary condition 'values'
+/// @param[in] bc_markers1 The indices (columns of A, rows of x) to
+///                        which bcs belong
+/// @param[in] x0 The array used in the lifting. If it is empty, it is
+///               treated as zero.
+/// @param[in] scale Scaling to apply
+void lift_bc_exterior_facets(
+    Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& a,
+    const std::vector<std::int32_t>& bc_cells,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>&
+        bc_values1,
+    const std::vector<bool>& bc_markers1,
+    const Eigen::Ref<const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>>& x0,
+    double scale);
+
 } // namespace impl
 } // namespace fem
 } // namespace dolfinx
@@ -10,6 +10,7 @@
 #include "Form.h"
 #include "assemble_matrix_impl.h"
 #include "assemble_scalar_impl.h"
+#include "assemble_system_impl.h"
 #include "assemble_vector_impl.h"
 #include "utils.h"
 #include <Eigen/Sparse>
@@ -92,6 +93,39 @@ void fem::assemble_vector(
   fem::impl::assemble_vector(b, L);
 }
 //-----------------------------------------------------------------------------
+void fem::assemble_vector(
+    Vec b, const Form& L, const Form& a,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs, const Vec x0,
+    double scale)
+{
+  {
+    la::VecWrapper _b(b);
+    if (x0)
+    {
+      la::VecReadWrapper _x0(x0);
+      fem::impl::assemble_vector(_b.x, L, a, bcs, _x0.x, scale);
+    }
+    else
+    {
+      const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> x0_empty(0);
+      fem::impl::assemble_vector(_b.x, L, a, bcs, x0_empty, scale);
+    }
+  }
+
+  VecGhostUpdateBegin(b, ADD_VALUES, SCATTER_REVERSE);
+  VecGhostUpdateEnd(b, ADD_VALUES, SCATTER_REVERSE);
+
+  // Set bc values on the test space
+  std::vector<std::shared_ptr<const DirichletBC>> bcs0;
+  for (const std::shared_ptr<const DirichletBC>& bc : bcs)
+  {
+    assert(bc);
+    if (L.function_space(0)->contains(*bc->function_space()))
+      bcs0.push_back(bc);
+  }
+  fem::set_bc(b, bcs0, x0, scale);
+}
+//-----------------------------------------------------------------------------
 void fem::apply_lifting(
     Vec b, const std::vector<std::shared_ptr<const Form>>& a,
     const std::vector<std::vector<std::shared_ptr<const DirichletBC>>>& bcs1,
@@ -278,6 +312,51 @@ void fem::add_diagonal(
   }
 }
 //-----------------------------------------------------------------------------
+void fem::assemble_system(
+    Mat A, Vec b, const Form& a, const Form& L,
+    const std::vector<std::shared_ptr<const DirichletBC>>& bcs, const Vec x0,
+    double scale)
+{
+  std::vector<PetscInt> tmp_dofs_petsc64;
+  const std::function<int(std::int32_t, const std::int32_t*, std::int32_t,
+                          const std::int32_t*, const PetscScalar*)>
+      mat_set_values_local = make_petsc_lambda(A, tmp_dofs_petsc64);
+
+  {
+    la::VecWrapper _b(b);
+    if (x0)
+    {
+      la::VecReadWrapper _x0(x0);
+      impl::assemble_system(mat_set_values_local, _b.x, a, L, bcs, _x0.x,
+                            scale);
+    }
+    else
+    {
+      const Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1> x0_empty(0);
+      impl::assemble_system(mat_set_values_local, _b.x, a, L, bcs, x0_empty,
+                            scale);
+    }
+  }
+
+  // Set diagonal for bc rows
+  assert(a.function_space(0));
+  if (*a.function_space(0) == *a.function_space(1))
+    add_diagonal(A, *a.function_space(0), bcs, 1.0);
+
+  VecGhostUpdateBegin(b, ADD_VALUES, SCATTER_REVERSE);
+  VecGhostUpdateEnd(b, ADD_VALUES, SCATTER_REVERSE);
+
+  // Set bc values on the test space
+  std::vector<std::shared_ptr<const DirichletBC>> bcs0;
+  for (const std::shared_ptr<const DirichletBC>& bc : bcs)
+  {
+    assert(bc);
+    if (a.function_space(0)->contains(*bc->function_space()))
+      bcs0.push_back(bc);
+  }
+  fem::set_bc(b, bcs0, x0, scale);
+}
+//-----------------------------------------------------------------------------
 void fem::set_bc(Vec b,
                  const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
                  const Vec x0, double scale)
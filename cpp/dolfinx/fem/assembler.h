@@ -55,6 +55,28 @@ void assemble_vector(Vec b, const Form& L);
 void assemble_vector(
     Eigen::Ref<Eigen::Matrix<PetscScalar, Eigen::Dynamic, 1>> b, const Form& L);
 
+/// Assemble linear form into an already allocated PETSc vector, apply
+/// lifting of boundary conditions and set boundary condition values.
+/// The result is the same as calling assemble_vector, apply_lifting
+/// (with a, bcs, x0 and scale), VecGhostUpdateBegin/End and set_bc (with
+/// bcs, x0 and scale), but L is assembled and the lifting is applied in
+/// a single loop over cells. Ghost contributions are accumulated on the
+/// owning process, but ghost values are not updated.
+/// @param[in,out] b The PETSc vector to assemble the form into. It is
+///                  not zeroed before assembly.
+/// @param[in] L The linear form to assemble
+/// @param[in] a The bilinear form used in the lifting. It must have the
+///              same test space as L.
+/// @param[in] bcs The boundary conditions. Conditions on the trial space
+///                of a are lifted and conditions on the test space of L
+///                are set.
+/// @param[in] x0 The vector used in the lifting and in setting bc
+///               values. It is treated as zero if it is null.
+/// @param[in] scale Scaling to apply
+void assemble_vector(Vec b, const Form& L, const Form& a,
+                     const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
+                     const Vec x0 = nullptr, double scale = 1.0);
+
 // FIXME: clarify how x0 is used
 // FIXME: if bcs entries are set
 
@@ -177,6 +199,35 @@ void add_diagonal(
     const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>& rows,
     PetscScalar diagonal = 1.0);
 
+// -- Systems ----------------------------------------------------------------
+
+/// Assemble a bilinear form into a matrix and a linear form into a
+/// vector, with Dirichlet boundary conditions applied symmetrically.
+/// Cell contributions to A and b are computed in one loop over cells.
+/// For each cell, the columns of the element matrix for bc dofs are
+/// lifted into the element vector and the rows and columns for bc dofs
+/// are zeroed. If the test and trial spaces are the same, the diagonal
+/// of A is then set to one for bc dofs. Ghost contributions to b are
+/// accumulated on the owning process and bc values are set in b. The
+/// result is the same as assembling A with assemble_matrix and
+/// add_diagonal, and b with assemble_vector, apply_lifting and set_bc
+/// (with x0 and scale).
+/// @param[in,out] A The matrix to assemble into. It must be
+///                  initialised. It is not zeroed and it is not
+///                  finalised.
+/// @param[in,out] b The vector to assemble into. It is not zeroed
+///                  before assembly.
+/// @param[in] a The bilinear form to assemble
+/// @param[in] L The linear form to assemble. It must have the same test
+///              space as a.
+/// @param[in] bcs The boundary conditions
+/// @param[in] x0 The vector used in the lifting and in setting bc
+///               values. It is treated as zero if it is null.
+/// @param[in] scale Scaling to apply to the lifting and bc values
+void assemble_system(Mat A, Vec b, const Form& a, const Form& L,
+                     const std::vector<std::shared_ptr<const DirichletBC>>& bcs,
+                     const Vec x0 = nullptr, double scale = 1.0);
+
 // -- Setting bcs ------------------------------------------------------------
 
 // FIXME: Move these function elsewhere?
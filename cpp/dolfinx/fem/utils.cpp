@@ -13,6 +13,7 @@
 #include <dolfinx/common/types.h>
 #include <dolfinx/fem/DofMap.h>
 #include <dolfinx/fem/DofMapBuilder.h>
+#include <dolfinx/fem/FiniteElement.h>
 #include <dolfinx/fem/Form.h>
 #include <dolfinx/fem/SparsityPatternBuilder.h>
 #include <dolfinx/function/Constant.h>
@@ -21,10 +22,12 @@
 #include <dolfinx/la/PETScMatrix.h>
 #include <dolfinx/la/PETScVector.h>
 #include <dolfinx/la/SparsityPattern.h>
+#include <dolfinx/la/utils.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/Topology.h>
 #include <dolfinx/mesh/TopologyComputation.h>
 #include <memory>
+#include <numeric>
 #include <petscsys.h>
 #include <string>
 #include <ufc.h>
@@ -351,6 +354,145 @@ la::PETScMatrix fem::create_matrix_nest(
   return la::PETScMatrix(_A);
 }
 //-----------------------------------------------------------------------------
+la::PETScMatrix
+fem::create_prolongation_matrix(const function::FunctionSpace& V0,
+                                const function::FunctionSpace& V1,
+                                const std::vector<std::int32_t>& parent_cells)
+{
+  common::Timer timer("Create prolongation matrix");
+
+  assert(V0.mesh());
+  assert(V1.mesh());
+  const mesh::Mesh& mesh0 = *V0.mesh();
+  const mesh::Mesh& mesh1 = *V1.mesh();
+  const int tdim = mesh1.topology().dim();
+  const int gdim = mesh1.geometry().dim();
+  if (mesh0.topology().dim() != tdim or mesh0.geometry().dim() != gdim)
+    throw std::runtime_error("Meshes for prolongation must be nested.");
+
+  auto map1 = mesh1.topology().index_map(tdim);
+  assert(map1);
+  const std::int32_t num_cells1 = map1->size_local() + map1->num_ghosts();
+  if ((std::int32_t)parent_cells.size() != num_cells1)
+  {
+    throw std::runtime_error(
+        "Number of parent cells does not match number of cells in the "
+        "refined mesh.");
+  }
+
+  assert(V0.element());
+  assert(V1.element());
+  const fem::FiniteElement& element0 = *V0.element();
+  const fem::FiniteElement& element1 = *V1.element();
+  if (!element1.has_dof_reference_coordinates())
+  {
+    throw std::runtime_error("Prolongation requires point evaluation "
+                             "degrees-of-freedom on the refined mesh.");
+  }
+  const int value_size = element0.value_size();
+  if (element1.value_size() != value_size)
+    throw std::runtime_error("Function space value sizes do not match.");
+
+  const int space_dim0 = element0.space_dimension();
+  const int space_dim1 = element1.space_dimension();
+  const int num_points = space_dim1 / value_size;
+
+  assert(V0.dofmap());
+  assert(V1.dofmap());
+  const fem::DofMap& dofmap0 = *V0.dofmap();
+  const fem::DofMap& dofmap1 = *V1.dofmap();
+
+  // Build sparsity pattern: the dofs of a refined cell couple to the
+  // dofs of its parent
+  const std::array<std::shared_ptr<const common::IndexMap>, 2> index_maps
+      = {{dofmap1.index_map, dofmap0.index_map}};
+  la::SparsityPattern pattern(mesh1.mpi_comm(), index_maps);
+  for (std::int32_t c = 0; c < num_cells1; ++c)
+    pattern.insert(dofmap1.cell_dofs(c), dofmap0.cell_dofs(parent_cells[c]));
+  pattern.assemble();
+
+  la::PETScMatrix P(mesh1.mpi_comm(), pattern);
+
+  // Geometry data
+  const graph::AdjacencyList<std::int32_t>& x_dofmap0
+      = mesh0.geometry().dofmap();
+  const graph::AdjacencyList<std::int32_t>& x_dofmap1
+      = mesh1.geometry().dofmap();
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g0
+      = mesh0.geometry().x();
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x_g1
+      = mesh1.geometry().x();
+  const fem::CoordinateElement& cmap0 = mesh0.geometry().cmap();
+  const fem::CoordinateElement& cmap1 = mesh1.geometry().cmap();
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs0(x_dofmap0.num_links(0), gdim);
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      coordinate_dofs1(x_dofmap1.num_links(0), gdim);
+
+  mesh0.topology_mutable().create_entity_permutations();
+  const Eigen::Array<std::uint32_t, Eigen::Dynamic, 1>& cell_info0
+      = mesh0.topology().get_cell_permutation_info();
+
+  // Physical and coarse reference coordinates of the fine dof points
+  const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>&
+      X1 = element1.dof_reference_coordinates();
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> x(
+      space_dim1, gdim);
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> X0(
+      space_dim1, tdim);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> J(space_dim1, gdim, tdim);
+  Eigen::Array<double, Eigen::Dynamic, 1> detJ(space_dim1);
+  Eigen::Tensor<double, 3, Eigen::RowMajor> K(space_dim1, tdim, gdim);
+
+  // Coarse basis functions at the fine dof points
+  Eigen::Tensor<double, 3, Eigen::RowMajor> basis_reference_values(
+      space_dim1, space_dim0, element0.reference_value_size());
+  Eigen::Tensor<double, 3, Eigen::RowMajor> basis_values(
+      space_dim1, space_dim0, value_size);
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      Pe(space_dim1, space_dim0);
+
+  Mat _P = P.mat();
+  std::vector<PetscInt> rows, cols;
+  for (std::int32_t c = 0; c < num_cells1; ++c)
+  {
+    const std::int32_t p = parent_cells[c];
+
+    auto x_dofs1 = x_dofmap1.links(c);
+    for (int i = 0; i < coordinate_dofs1.rows(); ++i)
+      coordinate_dofs1.row(i) = x_g1.row(x_dofs1[i]).head(gdim);
+    auto x_dofs0 = x_dofmap0.links(p);
+    for (int i = 0; i < coordinate_dofs0.rows(); ++i)
+      coordinate_dofs0.row(i) = x_g0.row(x_dofs0[i]).head(gdim);
+
+    // Pull fine dof points back to the reference cell of the parent
+    cmap1.push_forward(x, X1, coordinate_dofs1);
+    cmap0.compute_reference_geometry(X0, J, detJ, K, x, coordinate_dofs0);
+    element0.evaluate_reference_basis(basis_reference_values, X0);
+    element0.transform_reference_basis(basis_values, basis_reference_values,
+                                       X0, J, detJ, K, cell_info0[p]);
+
+    // Fine dof i evaluates component i / num_points
+    for (int i = 0; i < space_dim1; ++i)
+      for (int j = 0; j < space_dim0; ++j)
+        Pe(i, j) = basis_values(i, j, i / num_points);
+
+    // Rows shared between cells receive identical values
+    auto dofs1 = dofmap1.cell_dofs(c);
+    auto dofs0 = dofmap0.cell_dofs(p);
+    rows.assign(dofs1.data(), dofs1.data() + dofs1.size());
+    cols.assign(dofs0.data(), dofs0.data() + dofs0.size());
+    PetscErrorCode ierr
+        = MatSetValuesLocal(_P, rows.size(), rows.data(), cols.size(),
+                            cols.data(), Pe.data(), INSERT_VALUES);
+    if (ierr != 0)
+      la::petsc_error(ierr, __FILE__, "MatSetValuesLocal");
+  }
+  P.apply(la::PETScMatrix::AssemblyType::FINAL);
+
+  return P;
+}
+//-----------------------------------------------------------------------------
 la::PETScVector
 fem::create_vector_block(const std::vector<const common::IndexMap*>& maps)
 {
@@ -724,6 +866,20 @@ fem::create_functionspace(ufc_function_space* (*fptr)(const char*),
 //-----------------------------------------------------------------------------
 Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
 fem::pack_coefficients(const fem::Form& form)
+{
+  assert(form.mesh());
+  const mesh::Mesh& mesh = *form.mesh();
+  const int tdim = mesh.topology().dim();
+  const int num_cells = mesh.topology().index_map(tdim)->size_local()
+                        + mesh.topology().index_map(tdim)->num_ghosts();
+  std::vector<std::int32_t> cells(num_cells);
+  std::iota(cells.begin(), cells.end(), 0);
+  return fem::pack_coefficients(form, cells);
+}
+//-----------------------------------------------------------------------------
+Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+fem::pack_coefficients(const fem::Form& form,
+                       const std::vector<std::int32_t>& cells)
 {
   // Get form coefficient offsets amd dofmaps
   const fem::FormCoefficients& coefficients = form.coefficients();
@@ -732,11 +888,6 @@ fem::pack_coefficients(const fem::Form& form)
   for (int i = 0; i < coefficients.size(); ++i)
     dofmaps[i] = coefficients.get(i)->function_space()->dofmap().get();
 
-  // Get mesh
-  assert(form.mesh());
-  const mesh::Mesh& mesh = *form.mesh();
-  const int tdim = mesh.topology().dim();
-
   // Unwrap PETSc vectors
   std::vector<const PetscScalar*> v(coefficients.size(), nullptr);
   std::vector<Vec> x(coefficients.size(), nullptr),
@@ -748,22 +899,19 @@ fem::pack_coefficients(const fem::Form& form)
     VecGetArrayRead(x_local[i], &v[i]);
   }
 
-  const int num_cells = mesh.topology().index_map(tdim)->size_local()
-                        + mesh.topology().index_map(tdim)->num_ghosts();
-
   // Copy data into coefficient array
   Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> c(
-      num_cells, offsets.back());
+      cells.size(), offsets.back());
   if (coefficients.size() > 0)
   {
-    for (int cell = 0; cell < num_cells; ++cell)
+    for (std::size_t i = 0; i < cells.size(); ++i)
     {
       for (std::size_t coeff = 0; coeff < dofmaps.size(); ++coeff)
       {
-        auto dofs = dofmaps[coeff]->cell_dofs(cell);
+        auto dofs = dofmaps[coeff]->cell_dofs(cells[i]);
         const PetscScalar* _v = v[coeff];
         for (Eigen::Index k = 0; k < dofs.size(); ++k)
-          c(cell, k + offsets[coeff]) = _v[dofs[k]];
+          c(i, k + offsets[coeff]) = _v[dofs[k]];
       }
     }
   }
@@ -796,3 +944,31 @@ fem::pack_constants(const fem::Form& form)
       constant_values.data(), constant_values.size(), 1);
 }
 //-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+fem::compute_bc_cells(const function::FunctionSpace& V,
+                      const std::vector<bool>& markers)
+{
+  assert(V.dofmap());
+  const fem::DofMap& dofmap = *V.dofmap();
+  assert(V.mesh());
+  const mesh::Topology& topology = V.mesh()->topology();
+  auto map = topology.index_map(topology.dim());
+  assert(map);
+  const int num_cells = map->size_local() + map->num_ghosts();
+  std::vector<std::int32_t> cells;
+  for (int c = 0; c < num_cells; ++c)
+  {
+    auto cell_dofs = dofmap.cell_dofs(c);
+    for (Eigen::Index j = 0; j < cell_dofs.size(); ++j)
+    {
+      if (markers[cell_dofs[j]])
+      {
+        cells.push_back(c);
+        break;
+      }
+    }
+  }
+
+  return cells;
+}
+//-----------------------------------------------------------------------------
@@ -82,6 +82,29 @@ la::PETScMatrix create_matrix_nest(
     const Eigen::Ref<const Eigen::Array<const fem::Form*, Eigen::Dynamic,
                                         Eigen::Dynamic, Eigen::RowMajor>>& a);
 
+/// Create the prolongation (interpolation) matrix from a function
+/// space on a coarse mesh to a function space on a nested refined
+/// mesh, e.g. for geometric multigrid. Entry (i, j) is the value of
+/// coarse basis function j at the point of fine degree-of-freedom i.
+/// The restriction matrix is the transpose of the prolongation matrix.
+///
+/// The fine space must have point evaluation (Lagrange)
+/// degrees-of-freedom. For vector-valued spaces the
+/// degrees-of-freedom of a cell are assumed to be ordered by
+/// component.
+///
+/// @param[in] V0 The function space on the coarse mesh
+/// @param[in] V1 The function space on the refined mesh
+/// @param[in] parent_cells The (process-local) index of the coarse
+///   cell containing each (process-local) cell of the refined mesh, as
+///   computed by refinement::refine_with_parent_cells
+/// @return The prolongation matrix, with rows for V1 and columns for
+///   V0
+la::PETScMatrix
+create_prolongation_matrix(const function::FunctionSpace& V0,
+                           const function::FunctionSpace& V1,
+                           const std::vector<std::int32_t>& parent_cells);
+
 /// Initialise monolithic vector. Vector is not zeroed.
 la::PETScVector
 create_vector_block(const std::vector<const common::IndexMap*>& maps);
@@ -166,10 +189,29 @@ create_functionspace(ufc_function_space* (*fptr)(const char*),
 Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
 pack_coefficients(const fem::Form& form);
 
+// NOTE: This is subject to change
+/// Pack form coefficients ready for assembly over a subset of cells
+/// @param[in] form The form
+/// @param[in] cells The cells (local to the process)
+/// @return Coefficients, where row i holds the coefficients for
+///   cells[i]
+Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+pack_coefficients(const fem::Form& form,
+                  const std::vector<std::int32_t>& cells);
+
 // NOTE: This is subject to change
 /// Pack form constants ready for assembly
 Eigen::Array<PetscScalar, Eigen::Dynamic, 1>
 pack_constants(const fem::Form& form);
 
+/// Compute the cells (local and ghost) that have at least one marked
+/// degree-of-freedom, e.g. a dof with a boundary condition applied
+/// @param[in] V The function space
+/// @param[in] markers Marker for each (local and ghost) dof of V
+/// @return The cells, in increasing order
+std::vector<std::int32_t>
+compute_bc_cells(const function::FunctionSpace& V,
+                 const std::vector<bool>& markers);
+
 } // namespace fem
 } // namespace dolfinx
@@ -272,6 +272,13 @@ void Function::interpolate(const Function& v)
   _function_space->interpolate(x.x, v);
 }
 //-----------------------------------------------------------------------------
+void Function::interpolate(const Function& v, const PointEvaluator& evaluator)
+{
+  assert(_function_space);
+  la::VecWrapper x(_vector.vec());
+  _function_space->interpolate(x.x, v, evaluator);
+}
+//-----------------------------------------------------------------------------
 void Function::interpolate(
     const std::function<Eigen::Array<PetscScalar, Eigen::Dynamic,
                                      Eigen::Dynamic, Eigen::RowMajor>(
@@ -31,6 +31,8 @@ class Mesh;
 
 namespace function
 {
+class PointEvaluator;
+
 /// This class represents a function \f$ u_h \f$ in a finite
 /// element function space \f$ V_h \f$, given by
 ///
@@ -89,10 +91,20 @@ public:
   /// @return The vector of expansion coefficients
   const la::PETScVector& vector() const;
 
-  /// Interpolate a Function (on possibly non-matching meshes)
+  /// Interpolate a Function (on possibly non-matching meshes). If the
+  /// meshes differ, the dof coordinates of this Function are located
+  /// in the mesh of v (in parallel) and the call is collective. Use
+  /// the PointEvaluator version for repeated interpolation.
   /// @param[in] v The function to be interpolated.
   void interpolate(const Function& v);
 
+  /// Interpolate a Function on a non-matching mesh using a cached
+  /// point evaluator. See FunctionSpace::interpolate. Collective.
+  /// @param[in] v The function to be interpolated.
+  /// @param[in] evaluator Evaluator created on the mesh of v for the
+  ///   dof coordinates of this Function's space
+  void interpolate(const Function& v, const PointEvaluator& evaluator);
+
   /// Interpolate an expression
   /// @cond Work around doxygen bug for std::function
   /// @param[in] f The expression to be interpolated
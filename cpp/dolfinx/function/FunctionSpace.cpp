@@ -6,6 +6,7 @@
 
 #include "FunctionSpace.h"
 #include "Function.h"
+#include "PointEvaluator.h"
 #include <dolfinx/common/IndexMap.h>
 #include <dolfinx/common/UniqueIdGenerator.h>
 #include <dolfinx/common/types.h>
@@ -13,6 +14,7 @@
 #include <dolfinx/fem/CoordinateElement.h>
 #include <dolfinx/fem/DofMap.h>
 #include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/geometry/BoundingBoxTree.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
@@ -64,19 +66,24 @@ void FunctionSpace::interpolate_from_any(
         expansion_coefficients,
     const Function& v) const
 {
+  assert(_mesh);
   assert(v.function_space());
-  if (!v.function_space()->has_element(*_element))
+  std::shared_ptr<const mesh::Mesh> mesh_v = v.function_space()->mesh();
+  assert(mesh_v);
+  if (_mesh->id() != mesh_v->id())
   {
-    throw std::runtime_error("Restricting finite elements function in "
-                             "different elements not supported.");
+    // Evaluate v at the dof coordinates by locating them in the mesh
+    // of v (on any process)
+    geometry::BoundingBoxTree tree(*mesh_v, mesh_v->topology().dim());
+    PointEvaluator evaluator(mesh_v, tree, tabulate_dof_coordinates());
+    interpolate(expansion_coefficients, v, evaluator);
+    return;
   }
 
-  assert(_mesh);
-  assert(v.function_space()->mesh());
-  if (_mesh->id() != v.function_space()->mesh()->id())
+  if (!v.function_space()->has_element(*_element))
   {
-    throw std::runtime_error(
-        "Interpolation on different meshes not supported (yet).");
+    throw std::runtime_error("Restricting finite elements function in "
+                             "different elements not supported.");
   }
 
   const int tdim = _mesh->topology().dim();
@@ -142,6 +149,28 @@ void FunctionSpace::interpolate(
   interpolate_from_any(expansion_coefficients, v);
 }
 //-----------------------------------------------------------------------------
+void FunctionSpace::interpolate(
+    Eigen::Ref<Eigen::Array<PetscScalar, Eigen::Dynamic, 1>> coefficients,
+    const Function& v, const PointEvaluator& evaluator) const
+{
+  assert(_element);
+  assert(v.function_space());
+  assert(v.function_space()->element());
+  if (_element->value_size() != v.function_space()->element()->value_size())
+  {
+    throw std::runtime_error("Cannot interpolate function into function space. "
+                             "Value sizes do not match.");
+  }
+
+  if (evaluator.num_points() != coefficients.rows())
+  {
+    throw std::runtime_error(
+        "Point evaluator does not match the dof coordinates of the space.");
+  }
+
+  interpolate(coefficients, evaluator.eval(v));
+}
+//-----------------------------------------------------------------------------
 void FunctionSpace::interpolate(
     Eigen::Ref<Eigen::Array<PetscScalar, Eigen::Dynamic, 1>> coefficients,
     const std::function<Eigen::Array<PetscScalar, Eigen::Dynamic,
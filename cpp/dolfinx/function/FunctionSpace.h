@@ -31,6 +31,7 @@ class Mesh;
 namespace function
 {
 class Function;
+class PointEvaluator;
 
 /// This class represents a finite element function space defined by a
 /// mesh, a finite element, and a local-to-global map of the degrees of
@@ -85,6 +86,22 @@ public:
       Eigen::Ref<Eigen::Array<PetscScalar, Eigen::Dynamic, 1>> coefficients,
       const Function& v) const;
 
+  /// Interpolate a finite element Function on another mesh into this
+  /// function space, using a cached point evaluator. The evaluator must
+  /// have been created on the mesh of v for the points returned by
+  /// tabulate_dof_coordinates(), and can be reused for repeated
+  /// interpolation (e.g. at each time step) while neither mesh changes.
+  /// This is collective.
+  /// @param[in,out] coefficients The expansion coefficients. It must be
+  ///                             correctly sized by the calling
+  ///                             function.
+  /// @param[in] v The function to be interpolated
+  /// @param[in] evaluator Evaluator for the dof coordinates of this
+  ///                      space on the mesh of v
+  void interpolate(
+      Eigen::Ref<Eigen::Array<PetscScalar, Eigen::Dynamic, 1>> coefficients,
+      const Function& v, const PointEvaluator& evaluator) const;
+
   /// Interpolation function
   using interpolation_function = std::function<void(
       Eigen::Ref<Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
@@ -0,0 +1,230 @@
+// Copyright (C) 2020 agent
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "PointEvaluator.h"
+#include "Function.h"
+#include "FunctionSpace.h"
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/log.h>
+#include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/geometry/BoundingBoxTree.h>
+#include <dolfinx/geometry/utils.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/Topology.h>
+#include <numeric>
+
+using namespace dolfinx;
+using namespace dolfinx::function;
+
+//-----------------------------------------------------------------------------
+PointEvaluator::PointEvaluator(
+    std::shared_ptr<const mesh::Mesh> mesh,
+    const geometry::BoundingBoxTree& tree,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& x)
+    : _mesh(mesh), _comm(MPI_COMM_NULL), _num_points(x.rows())
+{
+  common::Timer timer("Build point evaluator");
+
+  assert(_mesh);
+  const int tdim = _mesh->topology().dim();
+  if (tree.tdim() != tdim)
+  {
+    throw std::runtime_error(
+        "Bounding box tree for point evaluation must be built for cells.");
+  }
+
+  MPI_Comm comm = _mesh->mpi_comm();
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  // Find processes whose part of the mesh may contain each point. The
+  // leaves of the global tree are process ranks.
+  std::vector<std::vector<double>> send_x(size);
+  std::vector<std::vector<std::int32_t>> sent_points(size);
+  if (tree.global_tree)
+  {
+    const graph::AdjacencyList<std::int32_t> candidates
+        = geometry::compute_collisions_batch(*tree.global_tree, x);
+    for (std::int32_t i = 0; i < _num_points; ++i)
+    {
+      for (std::int32_t p : candidates.links(i))
+      {
+        send_x[p].insert(send_x[p].end(), x.row(i).data(),
+                         x.row(i).data() + 3);
+        sent_points[p].push_back(i);
+      }
+    }
+  }
+  else
+  {
+    send_x[rank].assign(x.data(), x.data() + 3 * _num_points);
+    sent_points[rank].resize(_num_points);
+    std::iota(sent_points[rank].begin(), sent_points[rank].end(), 0);
+  }
+
+  // Send points to candidate processes
+  const graph::AdjacencyList<double> recv_x = dolfinx::MPI::all_to_all(
+      comm, graph::AdjacencyList<double>(send_x));
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& recv_offsets
+      = recv_x.offsets();
+  Eigen::Map<const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>
+      x_recv(recv_x.array().data(), recv_x.array().rows() / 3, 3);
+
+  // Find an owned cell containing each received point (ghost cells are
+  // skipped since the point will be found by the owner)
+  const std::int32_t num_owned_cells
+      = _mesh->topology().index_map(tdim)->size_local();
+  const graph::AdjacencyList<std::int32_t> collisions
+      = geometry::compute_entity_collisions_batch(tree, x_recv, *_mesh);
+  std::vector<std::int32_t> recv_cells(x_recv.rows(), -1);
+  for (Eigen::Index i = 0; i < x_recv.rows(); ++i)
+  {
+    for (std::int32_t c : collisions.links(i))
+    {
+      if (c < num_owned_cells)
+      {
+        recv_cells[i] = c;
+        break;
+      }
+    }
+  }
+
+  // Report back which points were found
+  std::vector<std::vector<std::int32_t>> found(size);
+  for (int p = 0; p < size; ++p)
+  {
+    for (int i = recv_offsets[p] / 3; i < recv_offsets[p + 1] / 3; ++i)
+      found[p].push_back(recv_cells[i] >= 0);
+  }
+  const graph::AdjacencyList<std::int32_t> recv_found
+      = dolfinx::MPI::all_to_all(comm,
+                                 graph::AdjacencyList<std::int32_t>(found));
+
+  // Assign each point to the lowest ranked process that found it, and
+  // tell each process which of the points it was sent it should
+  // evaluate (by position in the list of points it received)
+  std::vector<int> owner(_num_points, -1);
+  std::vector<std::vector<std::int32_t>> selected(size);
+  for (int p = 0; p < size; ++p)
+  {
+    auto found_p = recv_found.links(p);
+    for (std::size_t j = 0; j < sent_points[p].size(); ++j)
+    {
+      const std::int32_t i = sent_points[p][j];
+      if (found_p[j] and owner[i] < 0)
+      {
+        owner[i] = p;
+        selected[p].push_back(j);
+      }
+    }
+  }
+  for (std::int32_t i = 0; i < _num_points; ++i)
+    if (owner[i] < 0)
+      _not_found.push_back(i);
+
+  if (!_not_found.empty())
+  {
+    LOG(WARNING) << _not_found.size()
+                 << " point(s) for evaluation not found in mesh.";
+  }
+
+  const graph::AdjacencyList<std::int32_t> recv_selected
+      = dolfinx::MPI::all_to_all(comm,
+                                 graph::AdjacencyList<std::int32_t>(selected));
+
+  // Processes that evaluate points for this process, and the local
+  // index of each value they send (in order)
+  std::vector<int> sources;
+  for (int p = 0; p < size; ++p)
+  {
+    if (!selected[p].empty())
+    {
+      sources.push_back(p);
+      for (std::int32_t j : selected[p])
+        _recv_points.push_back(sent_points[p][j]);
+    }
+  }
+
+  // Processes for which this process evaluates points, and the points
+  // and cells to evaluate
+  std::vector<int> destinations;
+  _send_offsets = {0};
+  _x.resize(recv_selected.array().rows(), 3);
+  _cells.resize(recv_selected.array().rows());
+  std::int32_t pos = 0;
+  for (int p = 0; p < size; ++p)
+  {
+    auto selected_p = recv_selected.links(p);
+    if (selected_p.rows() == 0)
+      continue;
+
+    destinations.push_back(p);
+    for (Eigen::Index j = 0; j < selected_p.rows(); ++j)
+    {
+      const std::int32_t i = recv_offsets[p] / 3 + selected_p[j];
+      _x.row(pos) = x_recv.row(i);
+      _cells[pos] = recv_cells[i];
+      ++pos;
+    }
+    _send_offsets.push_back(pos);
+  }
+
+  // Create neighbourhood communicator for evaluation
+  MPI_Comm neighbor_comm;
+  MPI_Dist_graph_create_adjacent(comm, sources.size(), sources.data(),
+                                 MPI_UNWEIGHTED, destinations.size(),
+                                 destinations.data(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, false, &neighbor_comm);
+  _comm = dolfinx::MPI::Comm(neighbor_comm);
+  MPI_Comm_free(&neighbor_comm);
+}
+//-----------------------------------------------------------------------------
+Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+PointEvaluator::eval(const Function& u) const
+{
+  assert(u.function_space());
+  if (u.function_space()->mesh() != _mesh)
+  {
+    throw std::runtime_error(
+        "Function must be defined on the mesh of the point evaluator.");
+  }
+
+  assert(u.function_space()->element());
+  const int value_size = u.function_space()->element()->value_size();
+
+  // Evaluate at points owned by this process
+  std::vector<PetscScalar> send_values(_cells.rows() * value_size);
+  Eigen::Map<
+      Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
+      values(send_values.data(), _cells.rows(), value_size);
+  u.eval(_x, _cells, values);
+
+  // Send values to the processes that requested them
+  std::vector<int> send_offsets(_send_offsets);
+  for (int& offset : send_offsets)
+    offset *= value_size;
+  const graph::AdjacencyList<PetscScalar> recv_values
+      = dolfinx::MPI::neighbor_all_to_all(_comm.comm(), send_offsets,
+                                          send_values);
+  assert(recv_values.array().rows()
+         == (Eigen::Index)_recv_points.size() * value_size);
+
+  // Unpack values
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> u_x
+      = Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>::Zero(_num_points, value_size);
+  for (std::size_t k = 0; k < _recv_points.size(); ++k)
+  {
+    u_x.row(_recv_points[k])
+        = recv_values.array().segment(k * value_size, value_size).transpose();
+  }
+
+  return u_x;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,120 @@
+// Copyright (C) 2020 agent
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstdint>
+#include <dolfinx/common/MPI.h>
+#include <memory>
+#include <petscsys.h>
+#include <vector>
+
+namespace dolfinx
+{
+namespace geometry
+{
+class BoundingBoxTree;
+}
+
+namespace mesh
+{
+class Mesh;
+}
+
+namespace function
+{
+class Function;
+
+/// Evaluation of Functions at points that may lie on any process.
+///
+/// On construction, each point is sent to the processes whose part of
+/// the mesh it may lie in (determined from the global bounding box
+/// tree), and the owning process and cell of each point are found. A
+/// point that lies in cells on more than one process is assigned to
+/// the lowest ranked process. The resulting communication pattern is
+/// stored, so repeated evaluation at a fixed set of points (e.g.
+/// probes) needs a single neighbourhood exchange of Function values.
+
+class PointEvaluator
+{
+public:
+  /// Create evaluator for points. This is collective on the mesh
+  /// communicator.
+  /// @param[in] mesh The mesh
+  /// @param[in] tree Bounding box tree for the cells of the mesh
+  /// @param[in] x The points on this process at which Functions are to
+  ///   be evaluated. It has shape (num_points, 3).
+  PointEvaluator(
+      std::shared_ptr<const mesh::Mesh> mesh,
+      const geometry::BoundingBoxTree& tree,
+      const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                          Eigen::RowMajor>>& x);
+
+  /// Copy constructor
+  PointEvaluator(const PointEvaluator& evaluator) = default;
+
+  /// Move constructor
+  PointEvaluator(PointEvaluator&& evaluator) = default;
+
+  /// Destructor
+  ~PointEvaluator() = default;
+
+  /// Assignment operator
+  PointEvaluator& operator=(const PointEvaluator& evaluator) = delete;
+
+  /// Move assignment operator
+  PointEvaluator& operator=(PointEvaluator&& evaluator) = default;
+
+  /// Evaluate a Function at the points. This is collective on the mesh
+  /// communicator.
+  /// @param[in] u The Function to evaluate. It must be defined on the
+  ///   mesh of the evaluator.
+  /// @return The values at the points on this process, with shape
+  ///   (num_points, value_size). Rows for points that were not found on
+  ///   any process are zero.
+  Eigen::Array<PetscScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+  eval(const Function& u) const;
+
+  /// Number of points on this process
+  std::int32_t num_points() const { return _num_points; }
+
+  /// Indices of points on this process that were not found in the
+  /// mesh on any process
+  const std::vector<std::int32_t>& points_not_found() const
+  {
+    return _not_found;
+  }
+
+  /// Number of points (sent by all processes) that are evaluated on
+  /// this process
+  std::int32_t num_owned_points() const { return _cells.rows(); }
+
+private:
+  // The mesh
+  std::shared_ptr<const mesh::Mesh> _mesh;
+
+  // Neighbourhood communicator. Sources are the processes that evaluate
+  // points for this process and destinations are the processes for
+  // which this process evaluates points.
+  dolfinx::MPI::Comm _comm;
+
+  // Number of points on this process and points not found
+  std::int32_t _num_points;
+  std::vector<std::int32_t> _not_found;
+
+  // Points evaluated on this process, the cells that contain them, and
+  // offsets into these arrays for each destination process
+  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> _x;
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> _cells;
+  std::vector<int> _send_offsets;
+
+  // Local point index for each value received from source processes
+  // (in order of receipt)
+  std::vector<std::int32_t> _recv_points;
+};
+} // namespace function
+} // namespace dolfinx
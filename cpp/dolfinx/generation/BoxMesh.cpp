@@ -5,6 +5,7 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "BoxMesh.h"
+#include "utils.h"
 #include <Eigen/Dense>
 #include <cfloat>
 #include <cmath>
@@ -202,3 +203,79 @@ mesh::Mesh BoxMesh::create(MPI_Comm comm,
     throw std::runtime_error("Generate rectangle mesh. Wrong cell type");
 }
 //-----------------------------------------------------------------------------
+mesh::Mesh BoxMesh::create_structured(MPI_Comm comm,
+                                      const std::array<Eigen::Vector3d, 2>& p,
+                                      std::array<std::size_t, 3> n,
+                                      const fem::CoordinateElement& element,
+                                      const mesh::GhostMode ghost_mode)
+{
+  const Eigen::Vector3d x0 = p[0].cwiseMin(p[1]);
+  const Eigen::Vector3d x1 = p[0].cwiseMax(p[1]);
+  if (((x1 - x0).array() < 2.0 * DBL_EPSILON).any())
+  {
+    throw std::runtime_error(
+        "Box seems to have zero width, height or depth. Check dimensions");
+  }
+
+  const std::int64_t nx = n[0];
+  const std::int64_t ny = n[1];
+  const std::int64_t nz = n[2];
+  if (nx < 1 || ny < 1 || nz < 1)
+  {
+    throw std::runtime_error(
+        "BoxMesh has non-positive number of vertices in some dimension");
+  }
+
+  const Eigen::Vector3d h
+      = (x1 - x0).cwiseQuotient(Eigen::Vector3d(nx, ny, nz));
+  auto vertex_coordinates = [&](std::int64_t v, double* x) {
+    const std::int64_t iz = v / ((nx + 1) * (ny + 1));
+    const std::int64_t iy = (v / (nx + 1)) % (ny + 1);
+    const std::int64_t ix = v % (nx + 1);
+    x[0] = x0[0] + h[0] * static_cast<double>(ix);
+    x[1] = x0[1] + h[1] * static_cast<double>(iy);
+    x[2] = x0[2] + h[2] * static_cast<double>(iz);
+  };
+
+  // Vertices of cube (ix, iy, iz), numbered as in build_tet and
+  // build_hex
+  auto cube_vertices = [nx, ny](const std::array<std::int64_t, 3>& b) {
+    std::array<std::int64_t, 8> v;
+    v[0] = (b[2] * (ny + 1) + b[1]) * (nx + 1) + b[0];
+    v[1] = v[0] + 1;
+    v[2] = v[0] + (nx + 1);
+    v[3] = v[1] + (nx + 1);
+    for (int i = 0; i < 4; ++i)
+      v[i + 4] = v[i] + (nx + 1) * (ny + 1);
+    return v;
+  };
+
+  std::vector<std::int64_t> nc = {nx, ny, nz};
+  if (element.cell_shape() == mesh::CellType::tetrahedron)
+  {
+    auto block_cells = [&cube_vertices](const std::array<std::int64_t, 3>& b,
+                                        std::vector<std::int64_t>& cells) {
+      const std::array<std::int64_t, 8> v = cube_vertices(b);
+      cells.insert(cells.end(),
+                   {v[0], v[1], v[3], v[7], v[0], v[1], v[7], v[5],
+                    v[0], v[5], v[7], v[4], v[0], v[3], v[2], v[7],
+                    v[0], v[6], v[4], v[7], v[0], v[2], v[6], v[7]});
+    };
+    return create_structured_mesh(comm, nc, element, ghost_mode, 6,
+                                  block_cells, 3, vertex_coordinates);
+  }
+  else if (element.cell_shape() == mesh::CellType::hexahedron)
+  {
+    auto block_cells = [&cube_vertices](const std::array<std::int64_t, 3>& b,
+                                        std::vector<std::int64_t>& cells) {
+      const std::array<std::int64_t, 8> v = cube_vertices(b);
+      cells.insert(cells.end(),
+                   {v[0], v[4], v[2], v[6], v[1], v[5], v[3], v[7]});
+    };
+    return create_structured_mesh(comm, nc, element, ghost_mode, 1,
+                                  block_cells, 3, vertex_coordinates);
+  }
+  else
+    throw std::runtime_error("Generate box mesh. Wrong cell type");
+}
+//-----------------------------------------------------------------------------
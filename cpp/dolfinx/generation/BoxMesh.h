@@ -46,6 +46,25 @@ public:
                            std::array<std::size_t, 3> n,
                            const fem::CoordinateElement& element,
                            const mesh::GhostMode ghost_mode);
+
+  /// Create a uniform finite element _Mesh_ over the rectangular prism
+  /// spanned by the two points p0 and p1, with the cells divided
+  /// between the processes of a Cartesian process grid. Each process
+  /// creates its own cells, and ghost cells, directly. The mesh is not
+  /// built on one process and no graph partitioning is performed.
+  ///
+  /// @param[in] comm MPI communicator to build mesh on
+  /// @param[in] p Points of box
+  /// @param[in] n Number of cells in each direction.
+  /// @param[in] element Element that describes the geometry of a cell
+  ///   (affine only)
+  /// @param[in] ghost_mode Ghost mode
+  /// @return Mesh
+  static mesh::Mesh create_structured(MPI_Comm comm,
+                                      const std::array<Eigen::Vector3d, 2>& p,
+                                      std::array<std::size_t, 3> n,
+                                      const fem::CoordinateElement& element,
+                                      const mesh::GhostMode ghost_mode);
 };
 } // namespace generation
 } // namespace dolfinx
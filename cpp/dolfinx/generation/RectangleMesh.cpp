@@ -5,6 +5,7 @@
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
 #include "RectangleMesh.h"
+#include "utils.h"
 #include <Eigen/Dense>
 #include <cfloat>
 #include <cmath>
@@ -272,3 +273,95 @@ mesh::Mesh RectangleMesh::create(MPI_Comm comm,
     throw std::runtime_error("Generate rectangle mesh. Wrong cell type");
 }
 //-----------------------------------------------------------------------------
+mesh::Mesh RectangleMesh::create_structured(
+    MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
+    std::array<std::size_t, 2> n, const fem::CoordinateElement& element,
+    const mesh::GhostMode ghost_mode, std::string diagonal)
+{
+  if (diagonal != "left" && diagonal != "right" && diagonal != "right/left"
+      && diagonal != "left/right" && diagonal != "crossed")
+  {
+    throw std::runtime_error("Unknown mesh diagonal definition.");
+  }
+
+  const Eigen::Vector2d x0 = p[0].head<2>().cwiseMin(p[1].head<2>());
+  const Eigen::Vector2d x1 = p[0].head<2>().cwiseMax(p[1].head<2>());
+  if (((x1 - x0).array() < DBL_EPSILON).any())
+  {
+    throw std::runtime_error("Rectangle seems to have zero width, height or "
+                             "depth. Check dimensions");
+  }
+
+  const std::int64_t nx = n[0];
+  const std::int64_t ny = n[1];
+  if (nx < 1 || ny < 1)
+  {
+    throw std::runtime_error(
+        "Rectangle has non-positive number of vertices in some dimension: "
+        "number of vertices must be at least 1 in each dimension");
+  }
+
+  // Vertices are numbered as in build_tri, with the midpoint vertices
+  // of the "crossed" diagonal after the main vertices
+  const Eigen::Vector2d h = (x1 - x0).cwiseQuotient(Eigen::Vector2d(nx, ny));
+  const std::int64_t num_main = (nx + 1) * (ny + 1);
+  auto vertex_coordinates = [&](std::int64_t v, double* x) {
+    if (v < num_main)
+    {
+      x[0] = x0[0] + h[0] * static_cast<double>(v % (nx + 1));
+      x[1] = x0[1] + h[1] * static_cast<double>(v / (nx + 1));
+    }
+    else
+    {
+      x[0] = x0[0] + h[0] * (static_cast<double>((v - num_main) % nx) + 0.5);
+      x[1] = x0[1] + h[1] * (static_cast<double>((v - num_main) / nx) + 0.5);
+    }
+  };
+
+  std::vector<std::int64_t> nc = {nx, ny};
+  if (element.cell_shape() == mesh::CellType::triangle)
+  {
+    auto block_cells = [&](const std::array<std::int64_t, 3>& b,
+                           std::vector<std::int64_t>& cells) {
+      const std::int64_t v0 = b[1] * (nx + 1) + b[0];
+      const std::int64_t v1 = v0 + 1;
+      const std::int64_t v2 = v0 + (nx + 1);
+      const std::int64_t v3 = v1 + (nx + 1);
+      if (diagonal == "crossed")
+      {
+        const std::int64_t vmid = num_main + b[1] * nx + b[0];
+        cells.insert(cells.end(), {v0, v1, vmid, v0, v2, vmid, v1, v3, vmid,
+                                   v2, v3, vmid});
+        return;
+      }
+
+      // Alternating diagonals start with "left" ("right/left") or
+      // "right" ("left/right") in the first square of even rows
+      bool left = diagonal == "left";
+      if (diagonal == "right/left")
+        left = (b[0] + b[1]) % 2 == 0;
+      else if (diagonal == "left/right")
+        left = (b[0] + b[1]) % 2 == 1;
+      if (left)
+        cells.insert(cells.end(), {v0, v1, v2, v1, v2, v3});
+      else
+        cells.insert(cells.end(), {v0, v1, v3, v0, v2, v3});
+    };
+    return create_structured_mesh(comm, nc, element, ghost_mode,
+                                  diagonal == "crossed" ? 4 : 2, block_cells,
+                                  2, vertex_coordinates);
+  }
+  else if (element.cell_shape() == mesh::CellType::quadrilateral)
+  {
+    auto block_cells = [nx](const std::array<std::int64_t, 3>& b,
+                            std::vector<std::int64_t>& cells) {
+      const std::int64_t v0 = b[1] * (nx + 1) + b[0];
+      cells.insert(cells.end(), {v0, v0 + nx + 1, v0 + 1, v0 + nx + 2});
+    };
+    return create_structured_mesh(comm, nc, element, ghost_mode, 1,
+                                  block_cells, 2, vertex_coordinates);
+  }
+  else
+    throw std::runtime_error("Generate rectangle mesh. Wrong cell type");
+}
+//-----------------------------------------------------------------------------
@@ -41,6 +41,27 @@ public:
   create(MPI_Comm comm, const std::array<Eigen::Vector3d, 2>& p,
          std::array<std::size_t, 2> n, const fem::CoordinateElement& element,
          const mesh::GhostMode ghost_mode, std::string diagonal = "right");
+
+  /// Create a mesh of the rectangle with the cells divided between the
+  /// processes of a Cartesian process grid. Each process creates its
+  /// own cells, and ghost cells, directly. The mesh is not built on one
+  /// process and no graph partitioning is performed.
+  ///
+  /// @param[in] comm MPI communicator to build the mesh on
+  /// @param[in] p Two corner points
+  /// @param[in] n Number of cells in each direction
+  /// @param[in] element Element that describes the geometry of a cell
+  ///   (affine only)
+  /// @param[in] ghost_mode Mesh ghosting mode
+  /// @param[in] diagonal Direction of diagonals: "left", "right",
+  ///   "left/right", "right/left", "crossed"
+  /// @return Mesh
+  static mesh::Mesh create_structured(MPI_Comm comm,
+                                      const std::array<Eigen::Vector3d, 2>& p,
+                                      std::array<std::size_t, 2> n,
+                                      const fem::CoordinateElement& element,
+                                      const mesh::GhostMode ghost_mode,
+                                      std::string diagonal = "right");
 };
 } // namespace generation
 } // namespace dolfinx
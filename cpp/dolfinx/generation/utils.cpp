@@ -0,0 +1,191 @@
+// Copyright (C) 2020 agent
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "utils.h"
+#include <algorithm>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/fem/CoordinateElement.h>
+#include <dolfinx/fem/ElementDofLayout.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/cell_types.h>
+#include <string>
+
+using namespace dolfinx;
+
+//-----------------------------------------------------------------------------
+mesh::Mesh generation::create_structured_mesh(
+    MPI_Comm comm, const std::vector<std::int64_t>& n,
+    const fem::CoordinateElement& element, mesh::GhostMode ghost_mode,
+    int num_block_cells,
+    const std::function<void(const std::array<std::int64_t, 3>&,
+                             std::vector<std::int64_t>&)>& block_cells,
+    int gdim,
+    const std::function<void(std::int64_t, double*)>& vertex_coordinates)
+{
+  common::Timer timer("Build structured mesh");
+
+  const int tdim = n.size();
+  assert(tdim > 0 and tdim <= 3);
+  const int rank = dolfinx::MPI::rank(comm);
+  const int size = dolfinx::MPI::size(comm);
+
+  const int num_vertices = mesh::num_cell_vertices(element.cell_shape());
+  if (element.dof_layout().num_dofs() != num_vertices)
+  {
+    throw std::runtime_error(
+        "Structured mesh generation supports affine (P1) geometry only.");
+  }
+
+  // Create process grid. Of the factorisations of the number of
+  // processes with at most n[d] processes in direction d, so that
+  // every process owns at least one block, use the one that minimises
+  // the area of the interfaces between processes.
+  std::array<std::int64_t, 3> nb = {1, 1, 1};
+  std::copy(n.begin(), n.end(), nb.begin());
+  std::array<int, 3> pdims = {0, 0, 0};
+  double min_area = -1.0;
+  for (int p0 = 1; p0 <= std::min<std::int64_t>(size, nb[0]); ++p0)
+  {
+    if (size % p0 != 0)
+      continue;
+    for (int p1 = 1; p1 <= std::min<std::int64_t>(size / p0, nb[1]); ++p1)
+    {
+      const int p2 = size / (p0 * p1);
+      if ((size / p0) % p1 != 0 or p2 > nb[2])
+        continue;
+      const double area = (p0 - 1) * double(nb[1] * nb[2])
+                          + (p1 - 1) * double(nb[0] * nb[2])
+                          + (p2 - 1) * double(nb[0] * nb[1]);
+      if (min_area < 0.0 or area < min_area)
+      {
+        pdims = {p0, p1, p2};
+        min_area = area;
+      }
+    }
+  }
+  if (min_area < 0.0)
+  {
+    throw std::runtime_error(
+        "Cannot divide the blocks of a structured mesh between "
+        + std::to_string(size)
+        + " processes. Use more cells or a different number of processes.");
+  }
+
+  // Position of this process in the process grid, and its range of
+  // blocks in each direction
+  std::array<std::array<std::int64_t, 2>, 3> range;
+  for (int d = 0, r = rank; d < 3; r /= pdims[d], ++d)
+    range[d] = dolfinx::MPI::local_range(r % pdims[d], nb[d], pdims[d]);
+
+  std::vector<std::int64_t> cells;
+  std::vector<std::int64_t> original_cell_index;
+
+  // Create cells of owned blocks
+  std::array<std::int64_t, 3> b;
+  for (b[2] = range[2][0]; b[2] < range[2][1]; ++b[2])
+  {
+    for (b[1] = range[1][0]; b[1] < range[1][1]; ++b[1])
+    {
+      for (b[0] = range[0][0]; b[0] < range[0][1]; ++b[0])
+      {
+        block_cells(b, cells);
+        const std::int64_t block = (b[2] * nb[1] + b[1]) * nb[0] + b[0];
+        for (int c = 0; c < num_block_cells; ++c)
+          original_cell_index.push_back(block * num_block_cells + c);
+      }
+    }
+  }
+  assert(cells.size() == original_cell_index.size() * num_vertices);
+
+  // Add cells of neighbouring blocks that share a vertex (or a facet)
+  // with an owned cell as ghosts. Since the mesh is conforming, a cell
+  // with as many vertices on the boundary of the owned blocks as a
+  // facet shares that facet with an owned cell.
+  std::vector<int> ghost_owners;
+  if (ghost_mode != mesh::GhostMode::none)
+  {
+    std::vector<std::int64_t> owned_vertices(cells);
+    std::sort(owned_vertices.begin(), owned_vertices.end());
+    owned_vertices.erase(
+        std::unique(owned_vertices.begin(), owned_vertices.end()),
+        owned_vertices.end());
+
+    int num_shared = 1;
+    if (ghost_mode == mesh::GhostMode::shared_facet)
+    {
+      num_shared = mesh::num_cell_vertices(
+          mesh::cell_entity_type(element.cell_shape(), tdim - 1));
+    }
+
+    std::array<std::array<std::int64_t, 2>, 3> ghost_range;
+    for (int d = 0; d < 3; ++d)
+    {
+      ghost_range[d] = {std::max<std::int64_t>(range[d][0] - 1, 0),
+                        std::min(range[d][1] + 1, nb[d])};
+    }
+
+    std::vector<std::int64_t> block_vertices;
+    for (b[2] = ghost_range[2][0]; b[2] < ghost_range[2][1]; ++b[2])
+    {
+      for (b[1] = ghost_range[1][0]; b[1] < ghost_range[1][1]; ++b[1])
+      {
+        for (b[0] = ghost_range[0][0]; b[0] < ghost_range[0][1]; ++b[0])
+        {
+          // Skip owned blocks, and compute owner of other blocks
+          bool owned = true;
+          int owner = 0;
+          for (int d = 2; d >= 0; --d)
+          {
+            owned = owned and b[d] >= range[d][0] and b[d] < range[d][1];
+            owner = owner * pdims[d]
+                    + dolfinx::MPI::index_owner(pdims[d], b[d], nb[d]);
+          }
+          if (owned)
+            continue;
+
+          block_vertices.clear();
+          block_cells(b, block_vertices);
+          const std::int64_t block = (b[2] * nb[1] + b[1]) * nb[0] + b[0];
+          for (int c = 0; c < num_block_cells; ++c)
+          {
+            auto v0 = block_vertices.begin() + c * num_vertices;
+            auto v1 = v0 + num_vertices;
+            const int count = std::count_if(v0, v1, [&](std::int64_t v) {
+              return std::binary_search(owned_vertices.begin(),
+                                        owned_vertices.end(), v);
+            });
+            if (count >= num_shared)
+            {
+              cells.insert(cells.end(), v0, v1);
+              original_cell_index.push_back(block * num_block_cells + c);
+              ghost_owners.push_back(owner);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Compute coordinates of the vertices of all cells
+  std::vector<std::int64_t> nodes(cells);
+  std::sort(nodes.begin(), nodes.end());
+  nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+  Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> x(
+      nodes.size(), gdim);
+  for (std::size_t i = 0; i < nodes.size(); ++i)
+    vertex_coordinates(nodes[i], x.row(i).data());
+
+  const std::int32_t num_cells = original_cell_index.size();
+  std::vector<std::int32_t> offsets(num_cells + 1);
+  for (std::int32_t c = 0; c <= num_cells; ++c)
+    offsets[c] = c * num_vertices;
+
+  return mesh::create(comm, graph::AdjacencyList<std::int64_t>(cells, offsets),
+                      original_cell_index, ghost_owners, element, nodes, x,
+                      ghost_mode);
+}
+//-----------------------------------------------------------------------------
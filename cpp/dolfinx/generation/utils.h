@@ -0,0 +1,60 @@
+// Copyright (C) 2020 agent
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <dolfinx/mesh/Mesh.h>
+#include <functional>
+#include <mpi.h>
+#include <vector>
+
+namespace dolfinx
+{
+namespace fem
+{
+class CoordinateElement;
+}
+
+namespace generation
+{
+
+/// Create a mesh of a structured grid of blocks, e.g. the squares of a
+/// rectangle or the cubes of a box, without building the mesh on one
+/// process and without graph partitioning. The blocks are divided
+/// between the processes of a Cartesian process grid, and each process
+/// creates the cells of its own blocks and the ghost cells required by
+/// @p ghost_mode. The process grid is chosen so that every process owns
+/// at least one block, and an error is thrown if this is not possible.
+///
+/// The original global index of cell c of block (i, j, k) is
+/// ((k * n[1] + j) * n[0] + i) * num_block_cells + c.
+///
+/// @param[in] comm MPI communicator to build the mesh on
+/// @param[in] n Number of blocks in each direction (one entry per
+///   topological dimension)
+/// @param[in] element Element that describes the geometry of a cell
+/// @param[in] ghost_mode Mesh ghosting mode
+/// @param[in] num_block_cells Number of cells in each block
+/// @param[in] block_cells Function that appends the vertices (global
+///   indices, DOLFINX ordering) of the cells of block (i, j, k) to a
+///   list
+/// @param[in] gdim Geometric dimension
+/// @param[in] vertex_coordinates Function that computes the gdim
+///   coordinates of the vertex with a given global index
+/// @return Mesh
+mesh::Mesh create_structured_mesh(
+    MPI_Comm comm, const std::vector<std::int64_t>& n,
+    const fem::CoordinateElement& element, mesh::GhostMode ghost_mode,
+    int num_block_cells,
+    const std::function<void(const std::array<std::int64_t, 3>&,
+                             std::vector<std::int64_t>&)>& block_cells,
+    int gdim,
+    const std::function<void(std::int64_t, double*)>& vertex_coordinates);
+
+} // namespace generation
+} // namespace dolfinx
@@ -13,67 +13,13 @@
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshEntity.h>
 #include <dolfinx/mesh/utils.h>
+#include <limits>
 
 using namespace dolfinx;
 using namespace dolfinx::geometry;
 
 namespace
 {
-//-----------------------------------------------------------------------------
-// Compute bounding box of mesh entity
-Eigen::Array<double, 2, 3, Eigen::RowMajor>
-compute_bbox_of_entity(const mesh::MeshEntity& entity)
-{
-  // Get mesh entity data
-  const int tdim = entity.mesh().topology().dim();
-  const int dim = entity.dim();
-  const mesh::Geometry& geometry = entity.mesh().geometry();
-  const graph::AdjacencyList<std::int32_t>& x_dofmap = geometry.dofmap();
-
-  entity.mesh().topology_mutable().create_connectivity(dim, tdim);
-
-  // Find attached cell
-  auto e_to_c = entity.mesh().topology().connectivity(dim, tdim);
-  assert(e_to_c);
-  assert(e_to_c->num_links(entity.index()) > 0);
-  const std::int32_t c = e_to_c->links(entity.index())[0];
-
-  auto dofs = x_dofmap.links(c);
-  auto c_to_v = entity.mesh().topology().connectivity(tdim, 0);
-  assert(c_to_v);
-  auto cell_vertices = c_to_v->links(c);
-
-  auto vertices = entity.entities(0);
-  assert(vertices.rows() >= 2);
-  const auto* it
-      = std::find(cell_vertices.data(),
-                  cell_vertices.data() + cell_vertices.rows(), vertices[0]);
-  assert(it != (cell_vertices.data() + cell_vertices.rows()));
-  const int local_vertex = std::distance(cell_vertices.data(), it);
-
-  const Eigen::Vector3d x0 = geometry.node(dofs(local_vertex));
-  Eigen::Array<double, 2, 3, Eigen::RowMajor> b;
-  b.row(0) = x0;
-  b.row(1) = x0;
-
-  // Compute min and max over remaining vertices
-  for (int i = 1; i < vertices.rows(); ++i)
-  {
-    const auto* it
-        = std::find(cell_vertices.data(),
-                    cell_vertices.data() + cell_vertices.rows(), vertices[i]);
-    assert(it != (cell_vertices.data() + cell_vertices.rows()));
-    const int local_vertex = std::distance(cell_vertices.data(), it);
-
-    const Eigen::Vector3d x = geometry.node(dofs(local_vertex));
-    b.row(0) = b.row(0).min(x.transpose().array());
-    b.row(1) = b.row(1).max(x.transpose().array());
-  }
-
-  return b;
-}
-//-----------------------------------------------------------------------------
-
 //-----------------------------------------------------------------------------
 // Compute bounding box of points
 Eigen::Array<double, 2, 3, Eigen::RowMajor>
@@ -241,6 +187,48 @@ int _build_from_point(const std::vector<Eigen::Vector3d>& points,
   return bboxes.size() - 1;
 }
 //-----------------------------------------------------------------------------
+// Compute bounding boxes of all mesh entities of dimension tdim. Entry
+// 6 * e + j is the lower corner (j < 3) or the upper corner (j >= 3) of
+// the box for entity e.
+std::vector<double> compute_leaf_bboxes(const mesh::Mesh& mesh, int tdim)
+{
+  auto map = mesh.topology().index_map(tdim);
+  assert(map);
+  const std::int32_t num_leaves = map->size_local() + map->num_ghosts();
+  std::vector<double> leaf_bboxes(6 * num_leaves);
+  Eigen::Map<Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>
+      _leaf_bboxes(leaf_bboxes.data(), 2 * num_leaves, 3);
+  for (int e = 0; e < num_leaves; ++e)
+  {
+    _leaf_bboxes.block<2, 3>(2 * e, 0)
+        = compute_bbox_of_entity(mesh::MeshEntity(mesh, tdim, e));
+  }
+
+  return leaf_bboxes;
+}
+//-----------------------------------------------------------------------------
+// Gather the root bounding box from all processes. A process with an
+// empty tree sends an inverted box, which contains no points and does
+// not enlarge the boxes of the global tree.
+std::vector<double> gather_root_bboxes(MPI_Comm comm,
+                                       const BoundingBoxTree& tree)
+{
+  Eigen::Array<double, 2, 3, Eigen::RowMajor> b;
+  if (tree.num_bboxes() > 0)
+    b = tree.get_bbox(tree.num_bboxes() - 1);
+  else
+  {
+    b.row(0) = std::numeric_limits<double>::max();
+    b.row(1) = std::numeric_limits<double>::lowest();
+  }
+
+  std::vector<double> send_bbox(b.data(), b.data() + 6);
+  std::vector<double> recv_bbox(send_bbox.size() * dolfinx::MPI::size(comm));
+  MPI_Allgather(send_bbox.data(), send_bbox.size(), MPI_DOUBLE,
+                recv_bbox.data(), send_bbox.size(), MPI_DOUBLE, comm);
+  return recv_bbox;
+}
+//-----------------------------------------------------------------------------
 
 } // namespace
 
@@ -263,6 +251,7 @@ BoundingBoxTree::BoundingBoxTree(const std::vector<double>& leaf_bboxes,
   _bbox_coordinates
       = Eigen::Map<Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>(
           bbox_coordinates.data(), bbox_coordinates.size() / 3, 3);
+  _build_cost = compute_cost();
 }
 //-----------------------------------------------------------------------------
 BoundingBoxTree::BoundingBoxTree(const mesh::Mesh& mesh, int tdim) : _tdim(tdim)
@@ -277,31 +266,11 @@ BoundingBoxTree::BoundingBoxTree(const mesh::Mesh& mesh, int tdim) : _tdim(tdim)
   // Initialize entities of given dimension if they don't exist
   mesh.topology_mutable().create_entities(tdim);
 
-  // Create bounding boxes for all mesh entities (leaves)
-  auto map = mesh.topology().index_map(tdim);
-  assert(map);
-  const std::int32_t num_leaves = map->size_local() + map->num_ghosts();
-  std::vector<double> leaf_bboxes(6 * num_leaves);
-  Eigen::Map<Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>
-      _leaf_bboxes(leaf_bboxes.data(), 2 * num_leaves, 3);
-  for (int e = 0; e < num_leaves; ++e)
-  {
-    _leaf_bboxes.block<2, 3>(2 * e, 0)
-        = compute_bbox_of_entity(mesh::MeshEntity(mesh, tdim, e));
-  }
-
-  // Create leaf partition (to be sorted)
-  std::vector<int> leaf_partition(num_leaves);
-  std::iota(leaf_partition.begin(), leaf_partition.end(), 0);
-
-  // Recursively build the bounding box tree from the leaves
-  std::vector<std::array<int, 2>> bboxes;
-  std::vector<double> bbox_coordinates;
-  _build_from_leaf(leaf_bboxes, leaf_partition.begin(), leaf_partition.end(),
-                   bboxes, bbox_coordinates);
+  // Create bounding boxes for all mesh entities (leaves) and build tree
+  build(compute_leaf_bboxes(mesh, tdim));
 
   LOG(INFO) << "Computed bounding box tree with " << num_bboxes()
-            << " nodes for " << num_leaves << " entities.";
+            << " nodes for " << (num_bboxes() + 1) / 2 << " entities.";
 
   // Build tree for each process
   MPI_Comm comm = mesh.mpi_comm();
@@ -309,12 +278,7 @@ BoundingBoxTree::BoundingBoxTree(const mesh::Mesh& mesh, int tdim) : _tdim(tdim)
   if (mpi_size > 1)
   {
     // Send root node coordinates to all processes
-    std::vector<double> send_bbox(bbox_coordinates.end() - 6,
-                                  bbox_coordinates.end());
-    std::vector<double> recv_bbox(send_bbox.size() * mpi_size);
-    MPI_Allgather(send_bbox.data(), send_bbox.size(), MPI_DOUBLE,
-                  recv_bbox.data(), send_bbox.size(), MPI_DOUBLE, comm);
-
+    std::vector<double> recv_bbox = gather_root_bboxes(comm, *this);
     std::vector<int> global_leaves(mpi_size);
     std::iota(global_leaves.begin(), global_leaves.end(), 0);
     global_tree.reset(new BoundingBoxTree(recv_bbox, global_leaves.begin(),
@@ -322,6 +286,25 @@ BoundingBoxTree::BoundingBoxTree(const mesh::Mesh& mesh, int tdim) : _tdim(tdim)
     LOG(INFO) << "Computed global bounding box tree with "
               << global_tree->num_bboxes() << " boxes.";
   }
+}
+//-----------------------------------------------------------------------------
+BoundingBoxTree::BoundingBoxTree(const std::vector<Eigen::Vector3d>& points)
+    : _tdim(0)
+{
+  // Create leaf partition (to be sorted)
+  const int num_leaves = points.size();
+  std::vector<int> leaf_partition(num_leaves);
+  std::iota(leaf_partition.begin(), leaf_partition.end(), 0);
+
+  // Recursively build the bounding box tree from the leaves (an empty
+  // point set gives an empty tree)
+  std::vector<std::array<int, 2>> bboxes;
+  std::vector<double> bbox_coordinates;
+  if (num_leaves > 0)
+  {
+    _build_from_point(points, leaf_partition.begin(), leaf_partition.end(),
+                      bboxes, bbox_coordinates);
+  }
 
   _bboxes.resize(bboxes.size(), 2);
   for (std::size_t i = 0; i < bboxes.size(); ++i)
@@ -332,21 +315,76 @@ BoundingBoxTree::BoundingBoxTree(const mesh::Mesh& mesh, int tdim) : _tdim(tdim)
   _bbox_coordinates
       = Eigen::Map<Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>(
           bbox_coordinates.data(), bbox_coordinates.size() / 3, 3);
+
+  LOG(INFO) << "Computed bounding box tree with " << num_bboxes()
+            << " nodes for " << num_leaves << " points.";
 }
 //-----------------------------------------------------------------------------
-BoundingBoxTree::BoundingBoxTree(const std::vector<Eigen::Vector3d>& points)
+BoundingBoxTree::BoundingBoxTree(const std::vector<double>& leaf_bboxes)
     : _tdim(0)
+{
+  if (!leaf_bboxes.empty())
+    build(leaf_bboxes);
+}
+//-----------------------------------------------------------------------------
+bool BoundingBoxTree::refit(const mesh::Mesh& mesh, double rebuild_ratio)
+{
+  if (_tdim < 1)
+  {
+    throw std::runtime_error(
+        "Only bounding box trees for mesh entities can be refitted.");
+  }
+
+  auto map = mesh.topology().index_map(_tdim);
+  assert(map);
+  const std::int32_t num_leaves = map->size_local() + map->num_ghosts();
+  const int num_expected = num_leaves > 0 ? 2 * num_leaves - 1 : 0;
+  if (num_expected != num_bboxes())
+    throw std::runtime_error("Mesh does not match bounding box tree.");
+
+  // Recompute boxes, and rebuild if the tree has degraded too much
+  const std::vector<double> leaf_bboxes = compute_leaf_bboxes(mesh, _tdim);
+  refit_from_leaves(leaf_bboxes);
+  bool rebuilt = false;
+  if (rebuild_ratio > 0.0 and cost_ratio() > rebuild_ratio)
+  {
+    LOG(INFO) << "Rebuilding bounding box tree (cost ratio " << cost_ratio()
+              << ").";
+    build(leaf_bboxes);
+    rebuilt = true;
+  }
+
+  // Update global tree (its structure does not change)
+  if (global_tree)
+  {
+    global_tree->refit_from_leaves(
+        gather_root_bboxes(mesh.mpi_comm(), *this));
+  }
+
+  return rebuilt;
+}
+//-----------------------------------------------------------------------------
+double BoundingBoxTree::cost_ratio() const
+{
+  return _build_cost > 0.0 ? compute_cost() / _build_cost : 1.0;
+}
+//-----------------------------------------------------------------------------
+void BoundingBoxTree::build(const std::vector<double>& leaf_bboxes)
 {
   // Create leaf partition (to be sorted)
-  const int num_leaves = points.size();
+  const int num_leaves = leaf_bboxes.size() / 6;
   std::vector<int> leaf_partition(num_leaves);
   std::iota(leaf_partition.begin(), leaf_partition.end(), 0);
 
-  // Recursively build the bounding box tree from the leaves
+  // Recursively build the bounding box tree from the leaves (a process
+  // without leaves gets an empty tree)
   std::vector<std::array<int, 2>> bboxes;
   std::vector<double> bbox_coordinates;
-  _build_from_point(points, leaf_partition.begin(), leaf_partition.end(),
-                    bboxes, bbox_coordinates);
+  if (num_leaves > 0)
+  {
+    _build_from_leaf(leaf_bboxes, leaf_partition.begin(),
+                     leaf_partition.end(), bboxes, bbox_coordinates);
+  }
 
   _bboxes.resize(bboxes.size(), 2);
   for (std::size_t i = 0; i < bboxes.size(); ++i)
@@ -357,9 +395,64 @@ BoundingBoxTree::BoundingBoxTree(const std::vector<Eigen::Vector3d>& points)
   _bbox_coordinates
       = Eigen::Map<Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>(
           bbox_coordinates.data(), bbox_coordinates.size() / 3, 3);
-
-  LOG(INFO) << "Computed bounding box tree with " << num_bboxes()
-            << " nodes for " << num_leaves << " points.";
+  _build_cost = compute_cost();
+}
+//-----------------------------------------------------------------------------
+void BoundingBoxTree::refit_from_leaves(const std::vector<double>& leaf_bboxes)
+{
+  // Children are always stored before their parent, so a single pass
+  // over the nodes updates the tree bottom-up
+  for (int i = 0; i < _bboxes.rows(); ++i)
+  {
+    if (_bboxes(i, 0) == i)
+    {
+      const int e = _bboxes(i, 1);
+      for (int j = 0; j < 3; ++j)
+      {
+        _bbox_coordinates(2 * i, j) = leaf_bboxes[6 * e + j];
+        _bbox_coordinates(2 * i + 1, j) = leaf_bboxes[6 * e + 3 + j];
+      }
+    }
+    else
+    {
+      const int c0 = _bboxes(i, 0);
+      const int c1 = _bboxes(i, 1);
+      assert(c0 < i and c1 < i);
+      _bbox_coordinates.row(2 * i) = _bbox_coordinates.row(2 * c0).min(
+          _bbox_coordinates.row(2 * c1));
+      _bbox_coordinates.row(2 * i + 1) = _bbox_coordinates.row(2 * c0 + 1).max(
+          _bbox_coordinates.row(2 * c1 + 1));
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+double BoundingBoxTree::compute_cost() const
+{
+  const int root = _bboxes.rows() - 1;
+  if (root < 0)
+    return 0.0;
+
+  // Half surface area of boxes, or sum of extents if the root box is
+  // flat
+  const Eigen::Array<double, 1, 3> h
+      = _bbox_coordinates.row(2 * root + 1) - _bbox_coordinates.row(2 * root);
+  const bool use_area = h[0] * h[1] + h[1] * h[2] + h[2] * h[0] > 0.0;
+  auto measure = [&](int i) {
+    const Eigen::Array<double, 1, 3> d
+        = _bbox_coordinates.row(2 * i + 1) - _bbox_coordinates.row(2 * i);
+    return use_area ? d[0] * d[1] + d[1] * d[2] + d[2] * d[0] : d.sum();
+  };
+
+  const double root_measure = measure(root);
+  if (root_measure <= 0.0)
+    return 0.0;
+
+  double cost = 0.0;
+  for (int i = 0; i < root; ++i)
+    if (_bboxes(i, 0) != i)
+      cost += measure(i);
+
+  return cost / root_measure;
 }
 //-----------------------------------------------------------------------------
 int BoundingBoxTree::num_bboxes() const { return _bboxes.rows(); }
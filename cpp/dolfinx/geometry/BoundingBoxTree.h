@@ -42,6 +42,12 @@ public:
   ///                   around
   BoundingBoxTree(const std::vector<Eigen::Vector3d>& points);
 
+  /// Constructor
+  /// @param[in] leaf_bboxes Bounding boxes of the leaves, with 6 values
+  ///                        (lower and upper corner) per leaf. The
+  ///                        entity index of leaf i is i.
+  explicit BoundingBoxTree(const std::vector<double>& leaf_bboxes);
+
   /// Move constructor
   BoundingBoxTree(BoundingBoxTree&& tree) = default;
 
@@ -60,6 +66,24 @@ public:
   ///         row(1) is the upper corner
   Eigen::Array<double, 2, 3, Eigen::RowMajor> get_bbox(int node) const;
 
+  /// Recompute the bounding boxes of all nodes from the current
+  /// geometry of the mesh, keeping the tree structure. This is cheaper
+  /// than building a new tree when the mesh moves but its topology is
+  /// unchanged (e.g. ALE). If the mesh is distributed, the global tree
+  /// is updated too and the call is collective.
+  /// @param[in] mesh The mesh that the tree was built for
+  /// @param[in] rebuild_ratio If positive, the tree is rebuilt when
+  ///   cost_ratio() after refitting exceeds this value
+  /// @return True if the tree was rebuilt
+  bool refit(const mesh::Mesh& mesh, double rebuild_ratio = 0.0);
+
+  /// Measure of tree quality relative to when the tree was built. It is
+  /// the summed size (half surface area) of internal node boxes,
+  /// relative to the size of the root box, divided by the same quantity
+  /// for the tree when built. Values well above one indicate that
+  /// boxes overlap more than in the built tree (slower queries).
+  double cost_ratio() const;
+
   /// Return number of bounding boxes
   int num_bboxes() const;
 
@@ -87,9 +111,21 @@ private:
                   const std::vector<int>::iterator partition_begin,
                   const std::vector<int>::iterator partition_end);
 
+  // Build tree from leaf boxes (6 values per leaf)
+  void build(const std::vector<double>& leaf_bboxes);
+
+  // Recompute node boxes bottom-up from leaf boxes (6 values per leaf)
+  void refit_from_leaves(const std::vector<double>& leaf_bboxes);
+
+  // Summed size of internal node boxes relative to the root box size
+  double compute_cost() const;
+
   // Topological dimension of leaf entities
   int _tdim;
 
+  // Value of compute_cost() when the tree was built
+  double _build_cost = 0.0;
+
   // Print out recursively, for debugging
   void tree_print(std::stringstream& s, int i) const;
 
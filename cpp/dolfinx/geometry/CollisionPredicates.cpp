@@ -7,7 +7,9 @@
 #include "CollisionPredicates.h"
 #include "predicates.h"
 #include <Eigen/Dense>
+#include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Geometry.h>
+#include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshEntity.h>
 #include <dolfinx/mesh/cell_types.h>
 
@@ -47,11 +49,12 @@ bool CollisionPredicates::collides(const mesh::MeshEntity& entity,
 
   // Intersection is only implemented for simplex meshes
   if (!mesh::is_simplex(cell_type)
-      and !(cell_type == mesh::CellType::quadrilateral))
+      and !(cell_type == mesh::CellType::quadrilateral)
+      and !(cell_type == mesh::CellType::hexahedron))
   {
-    throw std::runtime_error(
-        "Cannot intersect cell and point. "
-        "Intersection is only implemented for simplex meshes and quads");
+    throw std::runtime_error("Cannot intersect cell and point. "
+                             "Intersection is only implemented for simplex "
+                             "meshes, quads and hexes");
   }
 
   // Get data
@@ -96,6 +99,21 @@ bool CollisionPredicates::collides(const mesh::MeshEntity& entity,
     return collides_quad_point_2d(g.node(_v[0]), g.node(_v[1]), g.node(_v[2]),
                                   g.node(_v[3]), point);
   }
+  else if (cell_type == mesh::CellType::hexahedron)
+  {
+    if (entity.dim() != tdim)
+    {
+      throw std::runtime_error("Cannot compute entity-point collision. "
+                               "Only implemented for hexahedral cells");
+    }
+
+    // The first dofs of a cell in the geometry dofmap are the vertices
+    auto dofs = g.dofmap().links(entity.index());
+    Eigen::Array<double, 8, 3, Eigen::RowMajor> vertices;
+    for (int i = 0; i < 8; ++i)
+      vertices.row(i) = g.x().row(dofs[i]);
+    return collides_hexahedron_point_3d(vertices, point);
+  }
   else if (tdim == 1 and gdim == 1)
   {
     std::array<int, 4> _v = comp_vertices(entity, 2);
@@ -257,6 +275,140 @@ bool CollisionPredicates::collides(const mesh::MeshEntity& entity_0,
   }
 }
 //-----------------------------------------------------------------------------
+Eigen::Array<bool, Eigen::Dynamic, 1> CollisionPredicates::collides_batch(
+    const mesh::Mesh& mesh,
+    const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>&
+        cells,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points)
+{
+  assert(cells.rows() == points.rows());
+  const mesh::CellType cell_type = mesh.topology().cell_type();
+  const int tdim = mesh.topology().dim();
+  const int gdim = mesh.geometry().dim();
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = mesh.geometry().dofmap();
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x
+      = mesh.geometry().x();
+
+  // Pack vertex coordinates of simplex cells. The first dofs of a cell
+  // in the geometry dofmap are the cell vertices.
+  auto pack = [&](auto& coords) {
+    const int num_vertices = coords.cols() / 3;
+    for (Eigen::Index i = 0; i < cells.rows(); ++i)
+    {
+      auto dofs = x_dofmap.links(cells[i]);
+      for (int v = 0; v < num_vertices; ++v)
+        coords.row(i).segment(3 * v, 3) = x.row(dofs[v]);
+    }
+  };
+
+  if (cell_type == mesh::CellType::triangle and gdim == 2)
+  {
+    Eigen::Array<double, Eigen::Dynamic, 9, Eigen::RowMajor> triangles(
+        cells.rows(), 9);
+    pack(triangles);
+    return collides_triangle_point_2d_batch(triangles, points);
+  }
+  else if (cell_type == mesh::CellType::tetrahedron)
+  {
+    Eigen::Array<double, Eigen::Dynamic, 12, Eigen::RowMajor> tetrahedra(
+        cells.rows(), 12);
+    pack(tetrahedra);
+    return collides_tetrahedron_point_3d_batch(tetrahedra, points);
+  }
+
+  // Test other cells one by one
+  Eigen::Array<bool, Eigen::Dynamic, 1> collides(cells.rows());
+  for (Eigen::Index i = 0; i < cells.rows(); ++i)
+  {
+    collides[i] = CollisionPredicates::collides(
+        mesh::MeshEntity(mesh, tdim, cells[i]),
+        points.row(i).transpose().matrix());
+  }
+
+  return collides;
+}
+//-----------------------------------------------------------------------------
+// Batch collision detection predicates
+//-----------------------------------------------------------------------------
+Eigen::Array<bool, Eigen::Dynamic, 1>
+CollisionPredicates::collides_triangle_point_2d_batch(
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 9,
+                                        Eigen::RowMajor>>& triangles,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points)
+{
+  assert(triangles.rows() == points.rows());
+  auto p0 = triangles.leftCols<3>();
+  auto p1 = triangles.middleCols<3>(3);
+  auto p2 = triangles.rightCols<3>();
+
+  const Eigen::ArrayXd ref = orient2d_batch(p0, p1, p2);
+  const Eigen::ArrayXd o0 = orient2d_batch(p1, p2, points);
+  const Eigen::ArrayXd o1 = orient2d_batch(p2, p0, points);
+  const Eigen::ArrayXd o2 = orient2d_batch(p0, p1, points);
+
+  Eigen::Array<bool, Eigen::Dynamic, 1> collides(triangles.rows());
+  for (Eigen::Index i = 0; i < triangles.rows(); ++i)
+  {
+    if (ref[i] > 0.0)
+      collides[i] = o0[i] >= 0.0 and o1[i] >= 0.0 and o2[i] >= 0.0;
+    else if (ref[i] < 0.0)
+      collides[i] = o0[i] <= 0.0 and o1[i] <= 0.0 and o2[i] <= 0.0;
+    else
+    {
+      // Degenerate triangle
+      collides[i] = collides_triangle_point_2d(
+          p0.row(i).transpose().matrix(), p1.row(i).transpose().matrix(),
+          p2.row(i).transpose().matrix(), points.row(i).transpose().matrix());
+    }
+  }
+
+  return collides;
+}
+//-----------------------------------------------------------------------------
+Eigen::Array<bool, Eigen::Dynamic, 1>
+CollisionPredicates::collides_tetrahedron_point_3d_batch(
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 12,
+                                        Eigen::RowMajor>>& tetrahedra,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points)
+{
+  assert(tetrahedra.rows() == points.rows());
+  auto p0 = tetrahedra.leftCols<3>();
+  auto p1 = tetrahedra.middleCols<3>(3);
+  auto p2 = tetrahedra.middleCols<3>(6);
+  auto p3 = tetrahedra.rightCols<3>();
+
+  const Eigen::ArrayXd ref = orient3d_batch(p0, p1, p2, p3);
+  const Eigen::ArrayXd o0 = orient3d_batch(p0, p1, p2, points);
+  const Eigen::ArrayXd o1 = orient3d_batch(p0, p3, p1, points);
+  const Eigen::ArrayXd o2 = orient3d_batch(p0, p2, p3, points);
+  const Eigen::ArrayXd o3 = orient3d_batch(p1, p3, p2, points);
+
+  Eigen::Array<bool, Eigen::Dynamic, 1> collides(tetrahedra.rows());
+  for (Eigen::Index i = 0; i < tetrahedra.rows(); ++i)
+  {
+    if (ref[i] > 0.0)
+    {
+      collides[i] = o0[i] >= 0.0 and o1[i] >= 0.0 and o2[i] >= 0.0
+                    and o3[i] >= 0.0;
+    }
+    else if (ref[i] < 0.0)
+    {
+      collides[i] = o0[i] <= 0.0 and o1[i] <= 0.0 and o2[i] <= 0.0
+                    and o3[i] <= 0.0;
+    }
+    else
+    {
+      throw std::runtime_error("Cannot compute tetrahedron point collision. "
+                               "Not implemented for degenerate tetrahedron");
+    }
+  }
+
+  return collides;
+}
+//-----------------------------------------------------------------------------
 // Low-level collision detection predicates
 //-----------------------------------------------------------------------------
 bool CollisionPredicates::collides_segment_point(const Eigen::Vector3d& p0,
@@ -844,6 +996,29 @@ bool CollisionPredicates::collides_tetrahedron_point_3d(
   return false;
 }
 //-----------------------------------------------------------------------------
+bool CollisionPredicates::collides_hexahedron_point_3d(
+    const Eigen::Ref<const Eigen::Array<double, 8, 3, Eigen::RowMajor>>&
+        vertices,
+    const Eigen::Vector3d& point)
+{
+  // Each tetrahedron is 0-a-b-7 for consecutive vertices a, b on the
+  // ring of vertices around the diagonal 0-7. Neighbouring hexahedra
+  // split their shared face along the same diagonal, so the
+  // tetrahedra of a conforming mesh leave no gaps.
+  static const std::array<int, 7> ring = {1, 3, 2, 6, 4, 5, 1};
+  const Eigen::Vector3d p0 = vertices.row(0).transpose().matrix();
+  const Eigen::Vector3d p7 = vertices.row(7).transpose().matrix();
+  for (int i = 0; i < 6; ++i)
+  {
+    const Eigen::Vector3d a = vertices.row(ring[i]).transpose().matrix();
+    const Eigen::Vector3d b = vertices.row(ring[i + 1]).transpose().matrix();
+    if (collides_tetrahedron_point_3d(p0, a, b, p7, point))
+      return true;
+  }
+
+  return false;
+}
+//-----------------------------------------------------------------------------
 bool CollisionPredicates::collides_tetrahedron_segment_3d(
     const Eigen::Vector3d& p0, const Eigen::Vector3d& p1,
     const Eigen::Vector3d& p2, const Eigen::Vector3d& p3,
@@ -8,13 +8,15 @@
 
 #include <Eigen/Dense>
 #include <cstddef>
+#include <cstdint>
 
 namespace dolfinx
 {
 namespace mesh
 {
+class Mesh;
 class MeshEntity;
-}
+} // namespace mesh
 
 namespace geometry
 {
@@ -43,6 +45,52 @@ public:
   static bool collides(const mesh::MeshEntity& entity_0,
                        const mesh::MeshEntity& entity_1);
 
+  /// Check whether each cell in a batch collides with the
+  /// corresponding point. For triangle cells in 2D and tetrahedral
+  /// cells, the vertex coordinates are packed and the batch predicates
+  /// are used. Other cells are tested one by one.
+  ///
+  /// @param[in] mesh The mesh
+  /// @param[in] cells The cell indices
+  /// @param[in] points The points (one point per row, one point per
+  ///   cell)
+  /// @return For each cell, true iff the cell collides with the point
+  static Eigen::Array<bool, Eigen::Dynamic, 1> collides_batch(
+      const mesh::Mesh& mesh,
+      const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>&
+          cells,
+      const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                          Eigen::RowMajor>>& points);
+
+  //--- Batch collision detection predicates ---
+
+  /// Check whether each triangle in a batch collides with the
+  /// corresponding point (2D version)
+  ///
+  /// @param[in] triangles The triangle vertex coordinates, packed with
+  ///   one triangle (x0, y0, z0, x1, ..., z2) per row
+  /// @param[in] points The points (one point per row)
+  /// @return For each triangle, true iff it collides with the point
+  static Eigen::Array<bool, Eigen::Dynamic, 1> collides_triangle_point_2d_batch(
+      const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 9,
+                                          Eigen::RowMajor>>& triangles,
+      const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                          Eigen::RowMajor>>& points);
+
+  /// Check whether each tetrahedron in a batch collides with the
+  /// corresponding point
+  ///
+  /// @param[in] tetrahedra The tetrahedron vertex coordinates, packed
+  ///   with one tetrahedron (x0, y0, z0, x1, ..., z3) per row
+  /// @param[in] points The points (one point per row)
+  /// @return For each tetrahedron, true iff it collides with the point
+  static Eigen::Array<bool, Eigen::Dynamic, 1>
+  collides_tetrahedron_point_3d_batch(
+      const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 12,
+                                          Eigen::RowMajor>>& tetrahedra,
+      const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                          Eigen::RowMajor>>& points);
+
   //--- Low-level collision detection predicates ---
 
   /// Check whether segment p0-p1 collides with point
@@ -171,6 +219,17 @@ public:
                                             const Eigen::Vector3d& p3,
                                             const Eigen::Vector3d& point);
 
+  /// Check whether hexahedron collides with point. The hexahedron is
+  /// split into six tetrahedra around the diagonal from vertex 0 to
+  /// vertex 7, so non-planar faces are approximated by two triangles.
+  /// @param[in] vertices The eight vertices (DOLFINX ordering), one per
+  ///   row
+  /// @param[in] point The point
+  static bool collides_hexahedron_point_3d(
+      const Eigen::Ref<const Eigen::Array<double, 8, 3, Eigen::RowMajor>>&
+          vertices,
+      const Eigen::Vector3d& point);
+
   /// Check whether tetrahedron p0-p1-p2-p3 collides with segment q0-q1
   static bool collides_tetrahedron_segment_3d(const Eigen::Vector3d& p0,
                                               const Eigen::Vector3d& p1,
@@ -0,0 +1,485 @@
+// Copyright (C) 2020 agent
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "WideBoundingBoxTree.h"
+#include "CollisionPredicates.h"
+#include "utils.h"
+#include <algorithm>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/common/log.h>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/MeshEntity.h>
+#include <dolfinx/mesh/Topology.h>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+using namespace dolfinx;
+using namespace dolfinx::geometry;
+
+namespace
+{
+// Relative tolerance used to pad leaf boxes (same as the default for
+// geometry::point_in_bbox)
+constexpr double rtol = 1e-14;
+
+// Number of bins used by the surface area heuristic
+constexpr int num_bins = 16;
+
+// Box with lower corner b[0:3] and upper corner b[3:6]
+using Box = std::array<double, 6>;
+
+//-----------------------------------------------------------------------------
+Box empty_box()
+{
+  const double inf = std::numeric_limits<double>::infinity();
+  return {inf, inf, inf, -inf, -inf, -inf};
+}
+//-----------------------------------------------------------------------------
+void expand(Box& b, const Box& c)
+{
+  for (int j = 0; j < 3; ++j)
+  {
+    b[j] = std::min(b[j], c[j]);
+    b[3 + j] = std::max(b[3 + j], c[3 + j]);
+  }
+}
+//-----------------------------------------------------------------------------
+// Half surface area of box. If the leaves are flat (2D) or lie on a
+// line (1D), the area of boxes can be zero and the sum of extents is
+// used instead.
+double measure(const Box& b, bool use_area)
+{
+  if (b[0] > b[3])
+    return 0.0;
+  const double dx = b[3] - b[0], dy = b[4] - b[1], dz = b[5] - b[2];
+  return use_area ? dx * dy + dy * dz + dz * dx : dx + dy + dz;
+}
+//-----------------------------------------------------------------------------
+// Partition leaves in [begin, end) into two non-empty sets using the
+// binned surface area heuristic, and return the split point
+std::vector<std::int32_t>::iterator
+split_sah(const std::vector<Box>& leaf_bboxes,
+          const std::vector<std::array<double, 3>>& midpoints,
+          std::vector<std::int32_t>::iterator begin,
+          std::vector<std::int32_t>::iterator end)
+{
+  const std::int32_t n = std::distance(begin, end);
+  assert(n > 1);
+
+  // Bounds of box midpoints, and split axis
+  Box c = empty_box();
+  Box b = empty_box();
+  for (auto it = begin; it != end; ++it)
+  {
+    const std::array<double, 3>& m = midpoints[*it];
+    expand(c, {m[0], m[1], m[2], m[0], m[1], m[2]});
+    expand(b, leaf_bboxes[*it]);
+  }
+  int axis = 0;
+  for (int j = 1; j < 3; ++j)
+    if (c[3 + j] - c[j] > c[3 + axis] - c[axis])
+      axis = j;
+  const double extent = c[3 + axis] - c[axis];
+  if (extent <= 0.0)
+    return begin + n / 2;
+
+  // Bin leaves by midpoint
+  auto bin = [&midpoints, axis, x0 = c[axis], extent](std::int32_t i) {
+    const int k = static_cast<int>(num_bins * (midpoints[i][axis] - x0)
+                                   / extent);
+    return std::min(k, num_bins - 1);
+  };
+  std::array<std::int32_t, num_bins> count;
+  count.fill(0);
+  std::array<Box, num_bins> bin_box;
+  bin_box.fill(empty_box());
+  for (auto it = begin; it != end; ++it)
+  {
+    const int k = bin(*it);
+    ++count[k];
+    expand(bin_box[k], leaf_bboxes[*it]);
+  }
+
+  // Sweep from the right to compute cost of right hand sides, then
+  // from the left to find the split with lowest cost
+  const bool use_area = measure(b, true) > 0.0;
+  std::array<double, num_bins> cost_right;
+  Box box = empty_box();
+  std::int32_t num = 0;
+  for (int k = num_bins - 1; k > 0; --k)
+  {
+    expand(box, bin_box[k]);
+    num += count[k];
+    cost_right[k] = num * measure(box, use_area);
+  }
+
+  int best_split = -1;
+  double best_cost = std::numeric_limits<double>::max();
+  box = empty_box();
+  num = 0;
+  for (int k = 1; k < num_bins; ++k)
+  {
+    expand(box, bin_box[k - 1]);
+    num += count[k - 1];
+    if (num == 0 or num == n)
+      continue;
+    const double cost = num * measure(box, use_area) + cost_right[k];
+    if (cost < best_cost)
+    {
+      best_cost = cost;
+      best_split = k;
+    }
+  }
+
+  // Fall back to median split if all midpoints are in one bin
+  if (best_split < 0)
+  {
+    auto mid = begin + n / 2;
+    std::nth_element(begin, mid, end,
+                     [&midpoints, axis](std::int32_t i, std::int32_t j) {
+                       return midpoints[i][axis] < midpoints[j][axis];
+                     });
+    return mid;
+  }
+
+  return std::partition(begin, end, [&bin, best_split](std::int32_t i) {
+    return bin(i) < best_split;
+  });
+}
+//-----------------------------------------------------------------------------
+// Partition leaves in [begin, end), which are sorted by Morton code,
+// at the highest bit in which the codes differ, and return the split
+// point
+std::vector<std::int32_t>::iterator
+split_morton(const std::vector<std::uint64_t>& codes,
+             std::vector<std::int32_t>::iterator begin,
+             std::vector<std::int32_t>::iterator end)
+{
+  const std::int32_t n = std::distance(begin, end);
+  assert(n > 1);
+  const std::uint64_t diff = codes[*begin] ^ codes[*(end - 1)];
+  if (diff == 0)
+    return begin + n / 2;
+
+  std::uint64_t mask = std::uint64_t(1) << 63;
+  while (!(diff & mask))
+    mask >>= 1;
+  return std::partition_point(begin, end, [&codes, mask](std::int32_t i) {
+    return !(codes[i] & mask);
+  });
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
+//-----------------------------------------------------------------------------
+WideBoundingBoxTree::WideBoundingBoxTree(const mesh::Mesh& mesh, int tdim,
+                                         Construction construction)
+    : _tdim(tdim)
+{
+  // Check dimension
+  if (tdim < 1 or tdim > mesh.topology().dim())
+  {
+    throw std::runtime_error("Dimension must be a number between 1 and "
+                             + std::to_string(mesh.topology().dim()));
+  }
+
+  // Initialize entities of given dimension if they don't exist
+  mesh.topology_mutable().create_entities(tdim);
+
+  // Compute bounding boxes of entities
+  auto map = mesh.topology().index_map(tdim);
+  assert(map);
+  const std::int32_t num_leaves = map->size_local() + map->num_ghosts();
+  std::vector<Box> leaf_bboxes(num_leaves);
+  for (std::int32_t e = 0; e < num_leaves; ++e)
+  {
+    const Eigen::Array<double, 2, 3, Eigen::RowMajor> b
+        = compute_bbox_of_entity(mesh::MeshEntity(mesh, tdim, e));
+    std::copy(b.data(), b.data() + 6, leaf_bboxes[e].begin());
+  }
+
+  build(leaf_bboxes, construction);
+}
+//-----------------------------------------------------------------------------
+WideBoundingBoxTree::WideBoundingBoxTree(
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& leaf_bboxes,
+    Construction construction)
+{
+  std::vector<Box> bboxes(leaf_bboxes.rows() / 2);
+  for (std::size_t i = 0; i < bboxes.size(); ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      bboxes[i][j] = leaf_bboxes(2 * i, j);
+      bboxes[i][3 + j] = leaf_bboxes(2 * i + 1, j);
+    }
+  }
+
+  build(bboxes, construction);
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+WideBoundingBoxTree::compute_collisions(const Eigen::Vector3d& p) const
+{
+  std::vector<std::int32_t> stack, entities;
+  collisions(p, stack, entities);
+  return entities;
+}
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t> WideBoundingBoxTree::compute_collisions(
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points) const
+{
+  std::vector<std::vector<std::int32_t>> entities(points.rows());
+  if (_nodes.empty())
+    return graph::AdjacencyList<std::int32_t>(entities);
+
+  // Visit points in Morton order, relative to the box of the root
+  Eigen::Array<double, 2, 3, Eigen::RowMajor> b;
+  for (int j = 0; j < 3; ++j)
+  {
+    b(0, j) = *std::min_element(_nodes[0].lower[j].begin(),
+                                _nodes[0].lower[j].end());
+    b(1, j) = *std::max_element(_nodes[0].upper[j].begin(),
+                                _nodes[0].upper[j].end());
+  }
+  const std::vector<std::int32_t> order = compute_morton_order(points, b);
+
+  std::vector<std::int32_t> stack;
+  for (std::int32_t i : order)
+    collisions(points.row(i).transpose().matrix(), stack, entities[i]);
+
+  return graph::AdjacencyList<std::int32_t>(entities);
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t> WideBoundingBoxTree::compute_box_collisions(
+    const Eigen::Array<double, 2, 3, Eigen::RowMajor>& box) const
+{
+  std::vector<std::int32_t> entities;
+  if (_nodes.empty())
+    return entities;
+
+  std::vector<std::int32_t> stack(1, 0);
+  while (!stack.empty())
+  {
+    const Node& node = _nodes[stack.back()];
+    stack.pop_back();
+
+    // Test box against all children (empty children have inverted
+    // boxes and are never hit)
+    std::array<bool, width> hit;
+    for (int k = 0; k < width; ++k)
+    {
+      hit[k] = (box(1, 0) >= node.lower[0][k])
+               & (box(0, 0) <= node.upper[0][k])
+               & (box(1, 1) >= node.lower[1][k])
+               & (box(0, 1) <= node.upper[1][k])
+               & (box(1, 2) >= node.lower[2][k])
+               & (box(0, 2) <= node.upper[2][k]);
+    }
+
+    for (int k = 0; k < width; ++k)
+    {
+      if (hit[k])
+      {
+        const std::int32_t c = node.child[k];
+        if (c >= 0)
+          stack.push_back(c);
+        else
+          entities.push_back(-(c + 2));
+      }
+    }
+  }
+
+  return entities;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::int32_t>
+WideBoundingBoxTree::compute_entity_collisions(const Eigen::Vector3d& p,
+                                               const mesh::Mesh& mesh) const
+{
+  if (_tdim < 0)
+    throw std::runtime_error("Tree was not built for mesh entities.");
+
+  std::vector<std::int32_t> candidates = compute_collisions(p);
+  std::vector<std::int32_t> entities;
+  for (std::int32_t e : candidates)
+  {
+    if (CollisionPredicates::collides(mesh::MeshEntity(mesh, _tdim, e), p))
+      entities.push_back(e);
+  }
+
+  return entities;
+}
+//-----------------------------------------------------------------------------
+void WideBoundingBoxTree::build(const std::vector<Box>& leaf_bboxes,
+                                Construction construction)
+{
+  common::Timer timer("Build wide bounding box tree");
+
+  _num_leaves = leaf_bboxes.size();
+  _nodes.clear();
+  if (_num_leaves == 0)
+    return;
+
+  // Pad leaf boxes and compute their midpoints
+  std::vector<Box> bboxes(leaf_bboxes);
+  std::vector<std::array<double, 3>> midpoints(_num_leaves);
+  for (std::int32_t i = 0; i < _num_leaves; ++i)
+  {
+    Box& b = bboxes[i];
+    for (int j = 0; j < 3; ++j)
+    {
+      const double eps = rtol * (b[3 + j] - b[j]);
+      b[j] -= eps;
+      b[3 + j] += eps;
+      midpoints[i][j] = 0.5 * (b[j] + b[3 + j]);
+    }
+  }
+
+  std::vector<std::int32_t> leaves(_num_leaves);
+  std::iota(leaves.begin(), leaves.end(), 0);
+
+  // Sort leaves by Morton code of their midpoints
+  std::vector<std::uint64_t> codes;
+  if (construction == Construction::morton)
+  {
+    Eigen::Map<const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>
+        x(midpoints[0].data(), _num_leaves, 3);
+    Eigen::Array<double, 2, 3, Eigen::RowMajor> b;
+    b.row(0) = x.colwise().minCoeff();
+    b.row(1) = x.colwise().maxCoeff();
+    codes = compute_morton_codes(x, b);
+    std::sort(leaves.begin(), leaves.end(),
+              [&codes](std::int32_t i, std::int32_t j) {
+                return codes[i] < codes[j];
+              });
+  }
+
+  // Build tree (upper bound on number of nodes is the number of leaves)
+  _nodes.reserve(_num_leaves);
+  build_node(bboxes, midpoints, codes, leaves.begin(), leaves.end(),
+             construction);
+
+  LOG(INFO) << "Computed wide bounding box tree with " << _nodes.size()
+            << " nodes for " << _num_leaves << " leaves.";
+}
+//-----------------------------------------------------------------------------
+int WideBoundingBoxTree::build_node(
+    const std::vector<Box>& leaf_bboxes,
+    const std::vector<std::array<double, 3>>& midpoints,
+    const std::vector<std::uint64_t>& codes,
+    std::vector<std::int32_t>::iterator begin,
+    std::vector<std::int32_t>::iterator end, Construction construction)
+{
+  using Range = std::pair<std::vector<std::int32_t>::iterator,
+                          std::vector<std::int32_t>::iterator>;
+
+  // Add empty node
+  const int index = _nodes.size();
+  {
+    Node node;
+    const Box e = empty_box();
+    for (int j = 0; j < 3; ++j)
+    {
+      node.lower[j].fill(e[j]);
+      node.upper[j].fill(e[3 + j]);
+    }
+    node.child.fill(-1);
+    _nodes.push_back(node);
+  }
+
+  // Split leaves into (up to) width parts by repeatedly splitting the
+  // largest part
+  std::vector<Range> parts = {{begin, end}};
+  while (parts.size() < width)
+  {
+    auto it = std::max_element(
+        parts.begin(), parts.end(), [](const Range& a, const Range& b) {
+          return std::distance(a.first, a.second)
+                 < std::distance(b.first, b.second);
+        });
+    if (std::distance(it->first, it->second) < 2)
+      break;
+
+    auto mid = construction == Construction::sah
+                   ? split_sah(leaf_bboxes, midpoints, it->first, it->second)
+                   : split_morton(codes, it->first, it->second);
+    const Range r(mid, it->second);
+    it->second = mid;
+    parts.push_back(r);
+  }
+
+  // Create children
+  for (std::size_t k = 0; k < parts.size(); ++k)
+  {
+    Box b = empty_box();
+    for (auto it = parts[k].first; it != parts[k].second; ++it)
+      expand(b, leaf_bboxes[*it]);
+
+    std::int32_t child;
+    if (std::distance(parts[k].first, parts[k].second) == 1)
+      child = -(*parts[k].first + 2);
+    else
+    {
+      child = build_node(leaf_bboxes, midpoints, codes, parts[k].first,
+                         parts[k].second, construction);
+    }
+
+    // Note: _nodes may have been reallocated by build_node
+    Node& node = _nodes[index];
+    node.child[k] = child;
+    for (int j = 0; j < 3; ++j)
+    {
+      node.lower[j][k] = b[j];
+      node.upper[j][k] = b[3 + j];
+    }
+  }
+
+  return index;
+}
+//-----------------------------------------------------------------------------
+void WideBoundingBoxTree::collisions(const Eigen::Vector3d& p,
+                                     std::vector<std::int32_t>& stack,
+                                     std::vector<std::int32_t>& entities) const
+{
+  if (_nodes.empty())
+    return;
+
+  stack.assign(1, 0);
+  while (!stack.empty())
+  {
+    const Node& node = _nodes[stack.back()];
+    stack.pop_back();
+
+    // Test point against all children (branch-free so that the loop
+    // can be vectorised)
+    std::array<bool, width> hit;
+    for (int k = 0; k < width; ++k)
+    {
+      hit[k] = (p[0] >= node.lower[0][k]) & (p[0] <= node.upper[0][k])
+               & (p[1] >= node.lower[1][k]) & (p[1] <= node.upper[1][k])
+               & (p[2] >= node.lower[2][k]) & (p[2] <= node.upper[2][k]);
+    }
+
+    for (int k = 0; k < width; ++k)
+    {
+      if (hit[k])
+      {
+        const std::int32_t c = node.child[k];
+        if (c >= 0)
+          stack.push_back(c);
+        else
+          entities.push_back(-(c + 2));
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
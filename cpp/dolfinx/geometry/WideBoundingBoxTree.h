@@ -0,0 +1,160 @@
+// Copyright (C) 2020 agent
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace dolfinx
+{
+
+// Forward declarations
+namespace mesh
+{
+class Mesh;
+} // namespace mesh
+
+namespace graph
+{
+template <typename T>
+class AdjacencyList;
+}
+
+namespace geometry
+{
+
+/// Axis-aligned bounding box tree with four children per node (a
+/// 4-wide bounding volume hierarchy). It is an alternative to
+/// BoundingBoxTree for point location queries.
+///
+/// The boxes of the children of a node are stored together, per
+/// coordinate direction (AoSoA layout), so that a point can be tested
+/// against all children with one vectorisable loop. Nodes are stored
+/// in a flat array and queries use an explicit stack.
+
+class WideBoundingBoxTree
+{
+public:
+  /// Number of children per node
+  static constexpr int width = 4;
+
+  /// Tree construction algorithm
+  enum class Construction
+  {
+    sah,   // Top-down, binned surface area heuristic
+    morton // Split at Morton code prefixes of box midpoints (LBVH)
+  };
+
+  /// Create tree for mesh entities
+  /// @param[in] mesh The mesh
+  /// @param[in] tdim The topological dimension of the entities
+  /// @param[in] construction The construction algorithm
+  WideBoundingBoxTree(const mesh::Mesh& mesh, int tdim,
+                      Construction construction = Construction::sah);
+
+  /// Create tree for a collection of boxes
+  /// @param[in] leaf_bboxes Lower and upper corners of the leaf boxes.
+  ///   Rows 2i and 2i + 1 are the lower and upper corners of box i.
+  /// @param[in] construction The construction algorithm
+  WideBoundingBoxTree(
+      const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                          Eigen::RowMajor>>& leaf_bboxes,
+      Construction construction = Construction::sah);
+
+  /// Move constructor
+  WideBoundingBoxTree(WideBoundingBoxTree&& tree) = default;
+
+  /// Copy constructor
+  WideBoundingBoxTree(const WideBoundingBoxTree& tree) = default;
+
+  /// Move assignment
+  WideBoundingBoxTree& operator=(WideBoundingBoxTree&& other) = default;
+
+  /// Destructor
+  ~WideBoundingBoxTree() = default;
+
+  /// Number of (internal) nodes
+  int num_nodes() const { return _nodes.size(); }
+
+  /// Number of leaves (boxes)
+  std::int32_t num_leaves() const { return _num_leaves; }
+
+  /// Topological dimension of leaf entities (-1 if the tree was not
+  /// built for mesh entities)
+  int tdim() const { return _tdim; }
+
+  /// Compute all leaf boxes that contain a point
+  /// @param[in] p The point
+  /// @return Indices of the leaves (mesh entities) whose boxes contain
+  ///   the point
+  std::vector<std::int32_t> compute_collisions(const Eigen::Vector3d& p) const;
+
+  /// Compute all leaf boxes that contain each point in a batch of
+  /// points. Points are processed in Morton order.
+  /// @param[in] points The points (one point per row)
+  /// @return For each point, the leaves whose boxes contain the point
+  graph::AdjacencyList<std::int32_t> compute_collisions(
+      const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                          Eigen::RowMajor>>& points) const;
+
+  /// Compute all leaf boxes that intersect a box
+  /// @param[in] box Lower (row 0) and upper (row 1) corners of the box
+  /// @return Indices of the leaves (mesh entities) whose boxes
+  ///   intersect the box
+  std::vector<std::int32_t> compute_box_collisions(
+      const Eigen::Array<double, 2, 3, Eigen::RowMajor>& box) const;
+
+  /// Compute all mesh entities that contain a point
+  /// @param[in] p The point
+  /// @param[in] mesh The mesh the tree was built for
+  /// @return Indices of the entities that contain the point
+  std::vector<std::int32_t>
+  compute_entity_collisions(const Eigen::Vector3d& p,
+                            const mesh::Mesh& mesh) const;
+
+private:
+  // Node with the bounding boxes of its children. Child k is an
+  // internal node if child[k] >= 0, empty if child[k] == -1 and leaf
+  // -(child[k] + 2) otherwise. Empty children have inverted boxes so
+  // that they are never hit.
+  struct Node
+  {
+    alignas(32) std::array<std::array<double, width>, 3> lower;
+    alignas(32) std::array<std::array<double, width>, 3> upper;
+    std::array<std::int32_t, width> child;
+  };
+
+  // Build tree from leaf boxes
+  void build(const std::vector<std::array<double, 6>>& leaf_bboxes,
+             Construction construction);
+
+  // Recursively build node for the leaves in [begin, end), and return
+  // its index
+  int build_node(const std::vector<std::array<double, 6>>& leaf_bboxes,
+                 const std::vector<std::array<double, 3>>& midpoints,
+                 const std::vector<std::uint64_t>& codes,
+                 std::vector<std::int32_t>::iterator begin,
+                 std::vector<std::int32_t>::iterator end,
+                 Construction construction);
+
+  // Append leaves that contain point p to entities
+  void collisions(const Eigen::Vector3d& p, std::vector<std::int32_t>& stack,
+                  std::vector<std::int32_t>& entities) const;
+
+  // Nodes (the root is node 0)
+  std::vector<Node> _nodes;
+
+  // Number of leaves
+  std::int32_t _num_leaves = 0;
+
+  // Topological dimension of leaf entities
+  int _tdim = -1;
+};
+} // namespace geometry
+} // namespace dolfinx
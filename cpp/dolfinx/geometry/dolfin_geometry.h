@@ -13,3 +13,4 @@ namespace dolfinx
 
 #include <dolfinx/geometry/BoundingBoxTree.h>
 #include <dolfinx/geometry/CollisionPredicates.h>
+#include <dolfinx/geometry/WideBoundingBoxTree.h>
@@ -1,4 +1,5 @@
 #include "predicates.h"
+#include <cmath>
 
 //-----------------------------------------------------------------------------
 double dolfinx::geometry::orient1d(double a, double b, double x)
@@ -2580,3 +2581,103 @@ namespace dolfinx::geometry
 /// Initialize the predicate
 PredicateInitialization predicate_initialization;
 } // namespace dolfinx::geometry
+
+//-----------------------------------------------------------------------------
+Eigen::ArrayXd dolfinx::geometry::orient2d_batch(
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>,
+                     0, Eigen::OuterStride<>>& a,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>,
+                     0, Eigen::OuterStride<>>& b,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>,
+                     0, Eigen::OuterStride<>>& c)
+{
+  assert(a.rows() == b.rows() and a.rows() == c.rows());
+  const Eigen::Index n = a.rows();
+  Eigen::ArrayXd det(n), detsum(n);
+
+  // Filter: floating-point determinant and error bound (see _orient2d).
+  // The loop has no branches so that it can be vectorised.
+  for (Eigen::Index i = 0; i < n; ++i)
+  {
+    const double detleft = (a(i, 0) - c(i, 0)) * (b(i, 1) - c(i, 1));
+    const double detright = (a(i, 1) - c(i, 1)) * (b(i, 0) - c(i, 0));
+    det[i] = detleft - detright;
+    detsum[i] = std::abs(detleft) + std::abs(detright);
+  }
+
+  // Exact arithmetic for uncertain cases
+  for (Eigen::Index i = 0; i < n; ++i)
+  {
+    if (std::abs(det[i]) <= ccwerrboundA * detsum[i] and detsum[i] > 0.0)
+    {
+      det[i] = orient2dadapt(a.row(i).data(), b.row(i).data(),
+                             c.row(i).data(), detsum[i]);
+    }
+  }
+
+  return det;
+}
+//-----------------------------------------------------------------------------
+Eigen::ArrayXd dolfinx::geometry::orient3d_batch(
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>,
+                     0, Eigen::OuterStride<>>& a,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>,
+                     0, Eigen::OuterStride<>>& b,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>,
+                     0, Eigen::OuterStride<>>& c,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>,
+                     0, Eigen::OuterStride<>>& d)
+{
+  assert(a.rows() == b.rows() and a.rows() == c.rows()
+         and a.rows() == d.rows());
+  const Eigen::Index n = a.rows();
+  Eigen::ArrayXd det(n), permanent(n);
+
+  // Filter: floating-point determinant and error bound (see _orient3d)
+  for (Eigen::Index i = 0; i < n; ++i)
+  {
+    const double adx = a(i, 0) - d(i, 0);
+    const double bdx = b(i, 0) - d(i, 0);
+    const double cdx = c(i, 0) - d(i, 0);
+    const double ady = a(i, 1) - d(i, 1);
+    const double bdy = b(i, 1) - d(i, 1);
+    const double cdy = c(i, 1) - d(i, 1);
+    const double adz = a(i, 2) - d(i, 2);
+    const double bdz = b(i, 2) - d(i, 2);
+    const double cdz = c(i, 2) - d(i, 2);
+
+    const double bdxcdy = bdx * cdy;
+    const double cdxbdy = cdx * bdy;
+    const double cdxady = cdx * ady;
+    const double adxcdy = adx * cdy;
+    const double adxbdy = adx * bdy;
+    const double bdxady = bdx * ady;
+
+    det[i] = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy)
+             + cdz * (adxbdy - bdxady);
+    permanent[i] = (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(adz)
+                   + (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bdz)
+                   + (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cdz);
+  }
+
+  // Exact arithmetic for uncertain cases
+  for (Eigen::Index i = 0; i < n; ++i)
+  {
+    if (std::abs(det[i]) <= o3derrboundA * permanent[i]
+        and permanent[i] > 0.0)
+    {
+      det[i] = orient3dadapt(a.row(i).data(), b.row(i).data(),
+                             c.row(i).data(), d.row(i).data(), permanent[i]);
+    }
+  }
+
+  return det;
+}
+//-----------------------------------------------------------------------------
@@ -20,6 +20,48 @@ double orient2d(const Eigen::Vector3d& a, const Eigen::Vector3d& b,
 double orient3d(const Eigen::Vector3d& a, const Eigen::Vector3d& b,
                 const Eigen::Vector3d& c, const Eigen::Vector3d& d);
 
+/// Compute orient2d for a batch of point triples (a_i, b_i, c_i). The
+/// determinants are first computed in floating-point arithmetic with a
+/// branch-free (vectorisable) loop, and the exact (adaptive) predicate
+/// is only called for entries whose sign is not certain from the
+/// floating-point error bound.
+/// @param[in] a The first points (one point per row)
+/// @param[in] b The second points
+/// @param[in] c The third points
+/// @return The values of orient2d(a_i, b_i, c_i), with correct sign
+Eigen::ArrayXd orient2d_batch(
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>,
+                     0, Eigen::OuterStride<>>& a,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>,
+                     0, Eigen::OuterStride<>>& b,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>,
+                     0, Eigen::OuterStride<>>& c);
+
+/// Compute orient3d for a batch of point quadruples (a_i, b_i, c_i,
+/// d_i), using a floating-point filter as for orient2d_batch
+/// @param[in] a The first points (one point per row)
+/// @param[in] b The second points
+/// @param[in] c The third points
+/// @param[in] d The fourth points
+/// @return The values of orient3d(a_i, b_i, c_i, d_i), with correct
+///   sign
+Eigen::ArrayXd orient3d_batch(
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>,
+                     0, Eigen::OuterStride<>>& a,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>,
+                     0, Eigen::OuterStride<>>& b,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>,
+                     0, Eigen::OuterStride<>>& c,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>,
+                     0, Eigen::OuterStride<>>& d);
+
 /// Class used for automatic initialization of tolerances at startup. A
 /// global instance is defined inside predicates.cpp to ensure that the
 /// constructor and thus exactinit() is called.
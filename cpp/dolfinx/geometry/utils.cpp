@@ -7,12 +7,20 @@
 #include "utils.h"
 #include "BoundingBoxTree.h"
 #include "CollisionPredicates.h"
+#include <algorithm>
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
 #include <dolfinx/common/log.h>
+#include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Geometry.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshEntity.h>
+#include <dolfinx/mesh/cell_types.h>
 #include <dolfinx/mesh/utils.h>
+#include <exception>
+#include <limits>
+#include <numeric>
+#include <thread>
 
 using namespace dolfinx;
 
@@ -335,6 +343,682 @@ void _compute_collisions_tree(const geometry::BoundingBoxTree& A,
   // the logic is easier to follow.
 }
 //-----------------------------------------------------------------------------
+// Compute squared distance from point to a cell. Unlike
+// geometry::squared_distance, this does not create any mesh
+// connectivity and can be called from multiple threads.
+double squared_distance_cell(const mesh::Mesh& mesh, int c,
+                             const Eigen::Vector3d& p)
+{
+  const mesh::Geometry& geometry = mesh.geometry();
+  auto dofs = geometry.dofmap().links(c);
+
+  // Vertex nodes are the first nodes of the cell
+  switch (mesh.topology().cell_type())
+  {
+  case (mesh::CellType::interval):
+    return geometry::squared_distance_interval(p, geometry.node(dofs(0)),
+                                               geometry.node(dofs(1)));
+  case (mesh::CellType::triangle):
+    return geometry::squared_distance_triangle(p, geometry.node(dofs(0)),
+                                               geometry.node(dofs(1)),
+                                               geometry.node(dofs(2)));
+  case (mesh::CellType::tetrahedron):
+  {
+    const Eigen::Vector3d a = geometry.node(dofs(0));
+    const Eigen::Vector3d b = geometry.node(dofs(1));
+    const Eigen::Vector3d c = geometry.node(dofs(2));
+    const Eigen::Vector3d d = geometry.node(dofs(3));
+
+    // Same as geometry::squared_distance for a tetrahedron
+    double r2 = std::numeric_limits<double>::max();
+    if (point_outside_of_plane(p, a, b, c, d))
+      r2 = std::min(r2, geometry::squared_distance_triangle(p, a, b, c));
+    if (point_outside_of_plane(p, a, c, d, b))
+      r2 = std::min(r2, geometry::squared_distance_triangle(p, a, c, d));
+    if (point_outside_of_plane(p, a, d, b, c))
+      r2 = std::min(r2, geometry::squared_distance_triangle(p, a, d, b));
+    if (point_outside_of_plane(p, b, d, c, a))
+      r2 = std::min(r2, geometry::squared_distance_triangle(p, b, d, c));
+    return r2 == std::numeric_limits<double>::max() ? 0.0 : r2;
+  }
+  default:
+    throw std::runtime_error(
+        "Distance computation not implemented for this cell type");
+  }
+}
+//-----------------------------------------------------------------------------
+// Compute collisions with point, using an explicit stack (stack is
+// work space)
+void compute_collisions_point_stack(const geometry::BoundingBoxTree& tree,
+                                    const Eigen::Vector3d& p,
+                                    const mesh::Mesh* mesh,
+                                    std::vector<int>& entities,
+                                    std::vector<int>& stack)
+{
+  const int tdim = mesh ? mesh->topology().dim() : -1;
+  stack.clear();
+  stack.push_back(tree.num_bboxes() - 1);
+  while (!stack.empty())
+  {
+    const int node = stack.back();
+    stack.pop_back();
+
+    // If point is not in bounding box, then don't search further
+    if (!geometry::point_in_bbox(tree.get_bbox(node), p))
+      continue;
+
+    const std::array<int, 2> bbox = tree.bbox(node);
+    if (is_leaf(bbox, node))
+    {
+      // If we have a mesh, check that the candidate is really a
+      // collision (child_1 denotes entity for leaves)
+      if (!mesh
+          or geometry::CollisionPredicates::collides(
+              mesh::MeshEntity(*mesh, tdim, bbox[1]), p))
+      {
+        entities.push_back(bbox[1]);
+      }
+    }
+    else
+    {
+      // Push children so that child 0 is visited first
+      stack.push_back(bbox[1]);
+      stack.push_back(bbox[0]);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+// Compute first collision with point, using an explicit stack (stack
+// is work space)
+int compute_first_collision_stack(const geometry::BoundingBoxTree& tree,
+                                  const Eigen::Vector3d& p,
+                                  const mesh::Mesh* mesh,
+                                  std::vector<int>& stack)
+{
+  const int tdim = mesh ? mesh->topology().dim() : -1;
+  stack.clear();
+  stack.push_back(tree.num_bboxes() - 1);
+  while (!stack.empty())
+  {
+    const int node = stack.back();
+    stack.pop_back();
+    if (!geometry::point_in_bbox(tree.get_bbox(node), p))
+      continue;
+
+    const std::array<int, 2> bbox = tree.bbox(node);
+    if (is_leaf(bbox, node))
+    {
+      if (!mesh
+          or geometry::CollisionPredicates::collides(
+              mesh::MeshEntity(*mesh, tdim, bbox[1]), p))
+      {
+        return bbox[1];
+      }
+    }
+    else
+    {
+      stack.push_back(bbox[1]);
+      stack.push_back(bbox[0]);
+    }
+  }
+
+  // Point not found
+  return -1;
+}
+//-----------------------------------------------------------------------------
+// Compute closest point {closest_point, R2}, using an explicit stack
+// (stack is work space)
+std::pair<int, double>
+compute_closest_point_stack(const geometry::BoundingBoxTree& tree,
+                            const Eigen::Vector3d& p, int closest_point,
+                            double R2, std::vector<int>& stack)
+{
+  stack.clear();
+  stack.push_back(tree.num_bboxes() - 1);
+  while (!stack.empty())
+  {
+    const int node = stack.back();
+    stack.pop_back();
+    const std::array<int, 2> bbox = tree.bbox(node);
+    if (is_leaf(bbox, node))
+    {
+      const double r2
+          = (tree.get_bbox(node).row(0).transpose().matrix() - p)
+                .squaredNorm();
+      if (r2 < R2)
+      {
+        closest_point = bbox[1];
+        R2 = r2;
+      }
+    }
+    else if (geometry::compute_squared_distance_bbox(tree.get_bbox(node), p)
+             <= R2)
+    {
+      stack.push_back(bbox[1]);
+      stack.push_back(bbox[0]);
+    }
+  }
+
+  return {closest_point, R2};
+}
+//-----------------------------------------------------------------------------
+// Compute closest cell {closest_entity, R2}, using an explicit stack
+// (stack is work space)
+std::pair<int, double>
+compute_closest_entity_stack(const geometry::BoundingBoxTree& tree,
+                             const Eigen::Vector3d& p, const mesh::Mesh& mesh,
+                             int closest_entity, double R2,
+                             std::vector<int>& stack)
+{
+  stack.clear();
+  stack.push_back(tree.num_bboxes() - 1);
+  while (!stack.empty())
+  {
+    const int node = stack.back();
+    stack.pop_back();
+
+    // If bounding box is outside radius, then don't search further
+    if (geometry::compute_squared_distance_bbox(tree.get_bbox(node), p) > R2)
+      continue;
+
+    const std::array<int, 2> bbox = tree.bbox(node);
+    if (is_leaf(bbox, node))
+    {
+      // If entity is closer than best result so far, then shrink radius
+      const double r2 = squared_distance_cell(mesh, bbox[1], p);
+      if (r2 < R2)
+      {
+        closest_entity = bbox[1];
+        R2 = r2;
+      }
+    }
+    else
+    {
+      stack.push_back(bbox[1]);
+      stack.push_back(bbox[0]);
+    }
+  }
+
+  return {closest_entity, R2};
+}
+//-----------------------------------------------------------------------------
+// Call f(thread, begin, end) for num_threads contiguous chunks of the
+// range [0, n). Exceptions thrown on a thread are re-thrown on the
+// calling thread.
+template <typename Function>
+void parallel_for(std::int64_t n, int num_threads, Function f)
+{
+  num_threads = std::max(1, num_threads);
+  if (num_threads == 1 or n < 2 * num_threads)
+  {
+    f(0, 0, n);
+    return;
+  }
+
+  std::vector<std::exception_ptr> errors(num_threads);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i)
+  {
+    const std::int64_t i0 = (n * i) / num_threads;
+    const std::int64_t i1 = (n * (i + 1)) / num_threads;
+    threads.emplace_back([&f, &errors, i, i0, i1]() {
+      try
+      {
+        f(i, i0, i1);
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+
+  for (auto& e : errors)
+    if (e)
+      std::rethrow_exception(e);
+}
+//-----------------------------------------------------------------------------
+// Remove candidate entities (for each point) that do not collide with
+// the point
+graph::AdjacencyList<std::int32_t> filter_entity_collisions(
+    const graph::AdjacencyList<std::int32_t>& candidates,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    const mesh::Mesh& mesh, int num_threads)
+{
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& cells
+      = candidates.array();
+  const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>& offsets
+      = candidates.offsets();
+
+  // Point for each candidate
+  Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> x(cells.rows(), 3);
+  for (Eigen::Index i = 0; i < points.rows(); ++i)
+    for (std::int32_t j = offsets[i]; j < offsets[i + 1]; ++j)
+      x.row(j) = points.row(i);
+
+  // Test candidates in chunks
+  Eigen::Array<bool, Eigen::Dynamic, 1> collides(cells.rows());
+  parallel_for(cells.rows(), num_threads,
+               [&](int, std::int64_t i0, std::int64_t i1) {
+                 collides.segment(i0, i1 - i0)
+                     = geometry::CollisionPredicates::collides_batch(
+                         mesh, cells.segment(i0, i1 - i0),
+                         x.middleRows(i0, i1 - i0));
+               });
+
+  std::vector<std::int32_t> data;
+  std::vector<std::int32_t> new_offsets(points.rows() + 1, 0);
+  for (Eigen::Index i = 0; i < points.rows(); ++i)
+  {
+    for (std::int32_t j = offsets[i]; j < offsets[i + 1]; ++j)
+      if (collides[j])
+        data.push_back(cells[j]);
+    new_offsets[i + 1] = data.size();
+  }
+
+  return graph::AdjacencyList<std::int32_t>(std::move(data),
+                                            std::move(new_offsets));
+}
+//-----------------------------------------------------------------------------
+// Compute collisions for a batch of points, processing points in
+// Morton order, and return as an adjacency list
+graph::AdjacencyList<std::int32_t> compute_collisions_batch(
+    const geometry::BoundingBoxTree& tree,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    const mesh::Mesh* mesh, int num_threads)
+{
+  const std::int64_t num_points = points.rows();
+  if (tree.num_bboxes() == 0)
+  {
+    return graph::AdjacencyList<std::int32_t>(
+        std::vector<std::int32_t>(),
+        std::vector<std::int32_t>(num_points + 1, 0));
+  }
+
+  // For mesh entities, find candidates from the bounding boxes and then
+  // test all candidates with the batch collision predicates
+  if (mesh)
+  {
+    return filter_entity_collisions(
+        compute_collisions_batch(tree, points, nullptr, num_threads), points,
+        *mesh, num_threads);
+  }
+
+  const std::vector<std::int32_t> order = geometry::compute_morton_order(
+      points, tree.get_bbox(tree.num_bboxes() - 1));
+
+  // Compute collisions for each chunk of (sorted) points
+  num_threads = std::max(1, num_threads);
+  std::vector<std::vector<int>> entities(num_threads);
+  std::vector<std::int32_t> num_links(num_points, 0);
+  parallel_for(num_points, num_threads,
+               [&](int thread, std::int64_t i0, std::int64_t i1) {
+                 std::vector<int> stack;
+                 std::vector<int>& e = entities[thread];
+                 for (std::int64_t i = i0; i < i1; ++i)
+                 {
+                   const std::int32_t q = order[i];
+                   const std::size_t size0 = e.size();
+                   compute_collisions_point_stack(
+                       tree, points.row(q).transpose(), mesh, e, stack);
+                   num_links[q] = e.size() - size0;
+                 }
+               });
+
+  // Build offsets (in original point order)
+  std::vector<std::int32_t> offsets(num_points + 1, 0);
+  std::partial_sum(num_links.begin(), num_links.end(), offsets.begin() + 1);
+
+  // Copy collisions into place
+  std::vector<std::int32_t> data(offsets.back());
+  parallel_for(num_points, num_threads,
+               [&](int thread, std::int64_t i0, std::int64_t i1) {
+                 auto it = entities[thread].begin();
+                 for (std::int64_t i = i0; i < i1; ++i)
+                 {
+                   const std::int32_t q = order[i];
+                   std::copy_n(it, num_links[q], data.begin() + offsets[q]);
+                   it += num_links[q];
+                 }
+               });
+
+  return graph::AdjacencyList<std::int32_t>(std::move(data),
+                                            std::move(offsets));
+}
+//-----------------------------------------------------------------------------
+// Check that point-in-entity is supported for tree and mesh, and
+// create connectivity required by CollisionPredicates before any
+// threaded traversal
+void prepare_entity_queries(const geometry::BoundingBoxTree& tree,
+                            const mesh::Mesh& mesh)
+{
+  const int tdim = mesh.topology().dim();
+  if (tree.tdim() != tdim)
+  {
+    throw std::runtime_error(
+        "Cannot compute collision between point and mesh entities. "
+        "Point-in-entity is only implemented for cells");
+  }
+
+  if (!mesh.topology().connectivity(tdim, tdim))
+    mesh.topology_mutable().create_connectivity(tdim, tdim);
+}
+//-----------------------------------------------------------------------------
+// Compute leaf nodes of tree whose boxes overlap box b, using an
+// explicit stack
+void compute_bbox_collisions_stack(
+    const geometry::BoundingBoxTree& tree,
+    const Eigen::Array<double, 2, 3, Eigen::RowMajor>& b,
+    std::vector<int>& leaves, std::vector<int>& stack)
+{
+  if (tree.num_bboxes() == 0)
+    return;
+
+  stack.assign(1, tree.num_bboxes() - 1);
+  while (!stack.empty())
+  {
+    const int node = stack.back();
+    stack.pop_back();
+    if (!geometry::bbox_in_bbox(b, tree.get_bbox(node)))
+      continue;
+
+    const std::array<int, 2> bbox = tree.bbox(node);
+    if (is_leaf(bbox, node))
+      leaves.push_back(node);
+    else
+    {
+      stack.push_back(bbox[1]);
+      stack.push_back(bbox[0]);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+// Compute up to max_boxes boxes, from the top levels of tree, that
+// together cover all leaves. Starting from the root, the largest box
+// is repeatedly replaced by its children. Boxes are measured by their
+// half surface area in 3D and by the sum of their extents otherwise,
+// using the first gdim components only. Returns 6 values per box
+// (lower and upper corner).
+std::vector<double> compute_coarse_bboxes(const geometry::BoundingBoxTree& tree,
+                                          int gdim, std::size_t max_boxes)
+{
+  if (tree.num_bboxes() == 0)
+    return std::vector<double>();
+
+  auto measure = [&tree, gdim](int node) {
+    const Eigen::Array<double, 2, 3, Eigen::RowMajor> b = tree.get_bbox(node);
+    const Eigen::Array<double, 1, 3> d = b.row(1) - b.row(0);
+    if (gdim == 3)
+      return d[0] * d[1] + d[1] * d[2] + d[2] * d[0];
+    else
+      return d.head(gdim).sum();
+  };
+
+  std::vector<int> nodes = {tree.num_bboxes() - 1};
+  while (nodes.size() < max_boxes)
+  {
+    // Find largest non-leaf box
+    int k = -1;
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+    {
+      if (!is_leaf(tree.bbox(nodes[i]), nodes[i])
+          and (k < 0 or measure(nodes[i]) > measure(nodes[k])))
+      {
+        k = i;
+      }
+    }
+    if (k < 0)
+      break;
+
+    const std::array<int, 2> bbox = tree.bbox(nodes[k]);
+    nodes[k] = bbox[0];
+    nodes.push_back(bbox[1]);
+  }
+
+  std::vector<double> bboxes;
+  for (int node : nodes)
+  {
+    const Eigen::Array<double, 2, 3, Eigen::RowMajor> b = tree.get_bbox(node);
+    bboxes.insert(bboxes.end(), b.data(), b.data() + 6);
+  }
+
+  return bboxes;
+}
+//-----------------------------------------------------------------------------
+// Pack the vertex coordinates of facets, followed (if normals is true)
+// by the unit facet normal pointing away from the first cell attached
+// to the facet. Returns the number of vertices per facet and the data,
+// with 3 * num_vertices + 3 values per facet.
+std::pair<int, std::vector<double>> pack_facets(
+    const mesh::Mesh& mesh,
+    const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>&
+        facets,
+    bool normals)
+{
+  const mesh::Topology& topology = mesh.topology();
+  const int tdim = topology.dim();
+  mesh.topology_mutable().create_connectivity(tdim - 1, 0);
+  mesh.topology_mutable().create_connectivity(tdim - 1, tdim);
+  auto f_to_v = topology.connectivity(tdim - 1, 0);
+  auto f_to_c = topology.connectivity(tdim - 1, tdim);
+  auto c_to_v = topology.connectivity(tdim, 0);
+  assert(f_to_v);
+  assert(f_to_c);
+  assert(c_to_v);
+
+  const mesh::Geometry& geometry = mesh.geometry();
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = geometry.dofmap();
+  const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>& x
+      = geometry.x();
+
+  const int num_vertices = mesh::num_cell_vertices(
+      mesh::cell_entity_type(topology.cell_type(), tdim - 1));
+  const int num_cell_vertices = mesh::num_cell_vertices(topology.cell_type());
+  const int stride = 3 * num_vertices + 3;
+  std::vector<double> data(stride * facets.rows(), 0.0);
+  for (Eigen::Index i = 0; i < facets.rows(); ++i)
+  {
+    // Vertex nodes are the first nodes of the attached cell
+    const std::int32_t c = f_to_c->links(facets[i])[0];
+    auto cell_vertices = c_to_v->links(c);
+    auto dofs = x_dofmap.links(c);
+    auto vertices = f_to_v->links(facets[i]);
+    double* xf = data.data() + stride * i;
+    for (int j = 0; j < num_vertices; ++j)
+    {
+      const auto* it = std::find(cell_vertices.data(),
+                                 cell_vertices.data() + cell_vertices.rows(),
+                                 vertices[j]);
+      assert(it != (cell_vertices.data() + cell_vertices.rows()));
+      const int local_vertex = std::distance(cell_vertices.data(), it);
+      std::copy_n(x.row(dofs[local_vertex]).data(), 3, xf + 3 * j);
+    }
+
+    if (normals)
+    {
+      const Eigen::Map<const Eigen::Vector3d> x0(xf);
+      Eigen::Vector3d n(1.0, 0.0, 0.0);
+      if (tdim == 2)
+      {
+        const Eigen::Vector3d t
+            = Eigen::Map<const Eigen::Vector3d>(xf + 3) - x0;
+        n = Eigen::Vector3d(-t[1], t[0], 0.0);
+      }
+      else if (tdim == 3)
+      {
+        n = (Eigen::Map<const Eigen::Vector3d>(xf + 3) - x0)
+                .cross(Eigen::Map<const Eigen::Vector3d>(xf + 6) - x0);
+      }
+
+      // Orient normal away from the cell midpoint
+      Eigen::Vector3d midpoint = Eigen::Vector3d::Zero();
+      for (int j = 0; j < num_cell_vertices; ++j)
+        midpoint += x.row(dofs[j]).matrix().transpose();
+      midpoint /= num_cell_vertices;
+      if (n.dot(x0 - midpoint) < 0.0)
+        n *= -1.0;
+      n.normalize();
+      std::copy_n(n.data(), 3, xf + 3 * num_vertices);
+    }
+  }
+
+  return {num_vertices, std::move(data)};
+}
+//-----------------------------------------------------------------------------
+// Compute squared distance from point to a facet with vertex
+// coordinates x
+double squared_distance_facet(const double* x, int num_vertices,
+                              const Eigen::Vector3d& p)
+{
+  const Eigen::Map<const Eigen::Vector3d> x0(x);
+  switch (num_vertices)
+  {
+  case 1:
+    return (p - x0).squaredNorm();
+  case 2:
+    return geometry::squared_distance_interval(
+        p, x0, Eigen::Map<const Eigen::Vector3d>(x + 3));
+  case 3:
+    return geometry::squared_distance_triangle(
+        p, x0, Eigen::Map<const Eigen::Vector3d>(x + 3),
+        Eigen::Map<const Eigen::Vector3d>(x + 6));
+  case 4:
+  {
+    // Quadrilateral (vertex 3 is opposite vertex 0), split into two
+    // triangles
+    const Eigen::Vector3d x1 = Eigen::Map<const Eigen::Vector3d>(x + 3);
+    const Eigen::Vector3d x2 = Eigen::Map<const Eigen::Vector3d>(x + 6);
+    const Eigen::Vector3d x3 = Eigen::Map<const Eigen::Vector3d>(x + 9);
+    return std::min(geometry::squared_distance_triangle(p, x0, x1, x3),
+                    geometry::squared_distance_triangle(p, x0, x3, x2));
+  }
+  default:
+    throw std::runtime_error(
+        "Distance computation not implemented for this facet type");
+  }
+}
+//-----------------------------------------------------------------------------
+// Build a bounding box tree for packed facet data (leaf i is facet i)
+geometry::BoundingBoxTree create_facet_tree(const std::vector<double>& data,
+                                            int num_vertices)
+{
+  const int stride = 3 * num_vertices + 3;
+  const std::int32_t num_facets = data.size() / stride;
+  std::vector<double> leaf_bboxes(6 * num_facets);
+  for (std::int32_t f = 0; f < num_facets; ++f)
+  {
+    const Eigen::Map<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>
+        xf(data.data() + stride * f, num_vertices, 3);
+    Eigen::Map<Eigen::Array<double, 2, 3, Eigen::RowMajor>> b(
+        leaf_bboxes.data() + 6 * f);
+    b.row(0) = xf.colwise().minCoeff();
+    b.row(1) = xf.colwise().maxCoeff();
+  }
+
+  return geometry::BoundingBoxTree(leaf_bboxes);
+}
+//-----------------------------------------------------------------------------
+// Find the processes that may hold the closest facet to any of the
+// points, given coarse boxes covering the facets of each process
+// (offsets are into bboxes, with 6 values per box). Every box contains
+// a facet within the largest distance from the point to the box, so
+// the closest facet is in a box no further away than the smallest
+// such distance. Returns 1 for candidate processes and 0 otherwise.
+std::vector<int> compute_candidate_processes(
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    const std::vector<double>& bboxes, const std::vector<int>& offsets,
+    double tol, int num_threads)
+{
+  const int size = offsets.size() - 1;
+  std::vector<int> candidates(size, 0);
+  const geometry::BoundingBoxTree tree(bboxes);
+  if (tree.num_bboxes() == 0)
+    return candidates;
+
+  auto max_distance = [](const Eigen::Array<double, 2, 3, Eigen::RowMajor>& b,
+                         const Eigen::Vector3d& x) {
+    const Eigen::Array3d x0 = (x.array() - b.row(0).transpose()).abs();
+    const Eigen::Array3d x1 = (x.array() - b.row(1).transpose()).abs();
+    return x0.max(x1).matrix().squaredNorm();
+  };
+
+  num_threads = std::max(1, num_threads);
+  std::vector<std::vector<int>> marker(num_threads,
+                                       std::vector<int>(size, 0));
+  parallel_for(
+      points.rows(), num_threads,
+      [&](int thread, std::int64_t i0, std::int64_t i1) {
+        std::vector<int> stack;
+        for (std::int64_t i = i0; i < i1; ++i)
+        {
+          const Eigen::Vector3d p = points.row(i).transpose();
+
+          // Smallest largest distance to a box
+          double R2 = std::numeric_limits<double>::max();
+          stack.assign(1, tree.num_bboxes() - 1);
+          while (!stack.empty())
+          {
+            const int node = stack.back();
+            stack.pop_back();
+            const Eigen::Array<double, 2, 3, Eigen::RowMajor> b
+                = tree.get_bbox(node);
+            if (geometry::compute_squared_distance_bbox(b, p) > R2)
+              continue;
+
+            const std::array<int, 2> bbox = tree.bbox(node);
+            if (is_leaf(bbox, node))
+              R2 = std::min(R2, max_distance(b, p));
+            else
+            {
+              stack.push_back(bbox[1]);
+              stack.push_back(bbox[0]);
+            }
+          }
+
+          // Mark owners of all boxes within this distance
+          stack.assign(1, tree.num_bboxes() - 1);
+          while (!stack.empty())
+          {
+            const int node = stack.back();
+            stack.pop_back();
+            if (geometry::compute_squared_distance_bbox(tree.get_bbox(node),
+                                                        p)
+                > R2 * (1.0 + tol))
+            {
+              continue;
+            }
+
+            const std::array<int, 2> bbox = tree.bbox(node);
+            if (is_leaf(bbox, node))
+            {
+              const int owner = std::upper_bound(offsets.begin(),
+                                                 offsets.end(), 6 * bbox[1])
+                                - offsets.begin() - 1;
+              marker[thread][owner] = 1;
+            }
+            else
+            {
+              stack.push_back(bbox[1]);
+              stack.push_back(bbox[0]);
+            }
+          }
+        }
+      });
+
+  for (const std::vector<int>& m : marker)
+    for (int p = 0; p < size; ++p)
+      candidates[p] |= m[p];
+
+  return candidates;
+}
+//-----------------------------------------------------------------------------
 
 } // namespace
 
@@ -393,11 +1077,143 @@ geometry::compute_entity_collisions(const BoundingBoxTree& tree0,
   return std::pair(entities_0, entities_1);
 }
 //-----------------------------------------------------------------------------
+Eigen::ArrayXd geometry::compute_distance_to_facets(
+    const mesh::Mesh& mesh,
+    const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>&
+        facets,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    bool signed_distance, int num_threads)
+{
+  const int tdim = mesh.topology().dim();
+  if (signed_distance and mesh.geometry().dim() != tdim)
+  {
+    throw std::runtime_error("Signed distance to facets requires the "
+                             "geometric and topological dimension to match.");
+  }
+
+  MPI_Comm comm = mesh.mpi_comm();
+  const int size = dolfinx::MPI::size(comm);
+  const auto [num_vertices, local_data]
+      = pack_facets(mesh, facets, signed_distance);
+  const int stride = 3 * num_vertices + 3;
+
+  // Gather coarse boxes covering the facets on each process
+  const std::vector<double> coarse_bboxes = compute_coarse_bboxes(
+      create_facet_tree(local_data, num_vertices), mesh.geometry().dim(), 16);
+  const int num_values = coarse_bboxes.size();
+  std::vector<int> counts(size), offsets(size + 1, 0);
+  MPI_Allgather(&num_values, 1, MPI_INT, counts.data(), 1, MPI_INT, comm);
+  std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+  std::vector<double> all_coarse_bboxes(offsets.back());
+  MPI_Allgatherv(coarse_bboxes.data(), num_values, MPI_DOUBLE,
+                 all_coarse_bboxes.data(), counts.data(), offsets.data(),
+                 MPI_DOUBLE, comm);
+
+  // Facets at (almost) the same distance are ties. For signed distance,
+  // the tie is broken by taking the facet whose plane is furthest from
+  // the point, which gives the correct sign at edges and corners.
+  const double tol = 1.0e-10;
+
+  // Receive the facets of the processes that may hold the closest
+  // facet to a point
+  const std::vector<int> request = compute_candidate_processes(
+      points, all_coarse_bboxes, offsets, tol, num_threads);
+  std::vector<int> requested(size);
+  MPI_Alltoall(request.data(), 1, MPI_INT, requested.data(), 1, MPI_INT,
+               comm);
+  std::vector<std::vector<double>> send_data(size);
+  for (int p = 0; p < size; ++p)
+    if (requested[p])
+      send_data[p] = local_data;
+  const graph::AdjacencyList<double> recv_data = dolfinx::MPI::all_to_all(
+      comm, graph::AdjacencyList<double>(send_data));
+  const std::vector<double> data(recv_data.array().data(),
+                                 recv_data.array().data()
+                                     + recv_data.array().rows());
+
+  Eigen::ArrayXd distance = Eigen::ArrayXd::Constant(
+      points.rows(), std::numeric_limits<double>::infinity());
+  const std::int32_t num_facets = data.size() / stride;
+  if (num_facets == 0 or points.rows() == 0)
+    return distance;
+
+  // Build tree for the facets (leaf i is facet i)
+  const BoundingBoxTree tree = create_facet_tree(data, num_vertices);
+
+  // Signed distance of point from plane of facet f
+  auto plane_distance = [&](std::int32_t f, const Eigen::Vector3d& p) {
+    const double* xf = data.data() + stride * f;
+    return Eigen::Map<const Eigen::Vector3d>(xf + 3 * num_vertices)
+        .dot(p - Eigen::Map<const Eigen::Vector3d>(xf));
+  };
+
+  const std::vector<std::int32_t> order
+      = compute_morton_order(points, tree.get_bbox(tree.num_bboxes() - 1));
+  parallel_for(
+      points.rows(), num_threads, [&](int, std::int64_t i0, std::int64_t i1) {
+        std::vector<int> stack;
+        std::int32_t closest = 0;
+        for (std::int64_t i = i0; i < i1; ++i)
+        {
+          const std::int32_t q = order[i];
+          const Eigen::Vector3d p = points.row(q).transpose();
+
+          // Use closest facet of previous point (in Morton order) as
+          // starting guess
+          double R2 = squared_distance_facet(data.data() + stride * closest,
+                                             num_vertices, p);
+          stack.assign(1, tree.num_bboxes() - 1);
+          while (!stack.empty())
+          {
+            const int node = stack.back();
+            stack.pop_back();
+            if (compute_squared_distance_bbox(tree.get_bbox(node), p)
+                > R2 * (1.0 + tol))
+            {
+              continue;
+            }
+
+            const std::array<int, 2> bbox = tree.bbox(node);
+            if (is_leaf(bbox, node))
+            {
+              const std::int32_t f = bbox[1];
+              const double r2 = squared_distance_facet(
+                  data.data() + stride * f, num_vertices, p);
+              if (r2 < R2 * (1.0 - tol)
+                  or (r2 <= R2 * (1.0 + tol) and signed_distance
+                      and std::abs(plane_distance(f, p))
+                              > std::abs(plane_distance(closest, p))))
+              {
+                closest = f;
+                R2 = std::min(R2, r2);
+              }
+            }
+            else
+            {
+              stack.push_back(bbox[1]);
+              stack.push_back(bbox[0]);
+            }
+          }
+
+          distance[q] = std::sqrt(R2);
+          if (signed_distance and plane_distance(closest, p) < 0.0)
+            distance[q] *= -1.0;
+        }
+      });
+
+  return distance;
+}
+//-----------------------------------------------------------------------------
 std::vector<int> geometry::compute_collisions(const BoundingBoxTree& tree,
                                               const Eigen::Vector3d& p)
 {
   std::vector<int> entities;
-  _compute_collisions_point(tree, p, tree.num_bboxes() - 1, nullptr, entities);
+  if (tree.num_bboxes() > 0)
+  {
+    _compute_collisions_point(tree, p, tree.num_bboxes() - 1, nullptr,
+                              entities);
+  }
   return entities;
 }
 //-----------------------------------------------------------------------------
@@ -416,7 +1232,8 @@ geometry::compute_entity_collisions(const BoundingBoxTree& tree,
 
   // Call recursive find function to compute bounding box candidates
   std::vector<int> entities;
-  _compute_collisions_point(tree, p, tree.num_bboxes() - 1, &mesh, entities);
+  if (tree.num_bboxes() > 0)
+    _compute_collisions_point(tree, p, tree.num_bboxes() - 1, &mesh, entities);
   return entities;
 }
 //-----------------------------------------------------------------------------
@@ -487,6 +1304,10 @@ std::pair<int, double> geometry::compute_closest_entity(
                              "Closest-entity is only implemented for cells");
   }
 
+  // No entities on this process (e.g. an empty partition)
+  if (tree.num_bboxes() == 0 or tree_midpoint.num_bboxes() == 0)
+    return {-1, std::numeric_limits<double>::max()};
+
   // Search point cloud to get a good starting guess
   std::pair<int, double> guess = compute_closest_point(tree_midpoint, p);
   const double r = guess.second;
@@ -533,6 +1354,390 @@ geometry::compute_closest_point(const BoundingBoxTree& tree,
   return {closest_point, sqrt(R2)};
 }
 //-----------------------------------------------------------------------------
+std::vector<std::int32_t> geometry::compute_morton_order(
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    const Eigen::Array<double, 2, 3, Eigen::RowMajor>& b)
+{
+  const std::vector<std::uint64_t> codes = compute_morton_codes(points, b);
+  std::vector<std::int32_t> order(points.rows());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&codes](std::int32_t i, std::int32_t j) {
+                     return codes[i] < codes[j];
+                   });
+  return order;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::uint64_t> geometry::compute_morton_codes(
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    const Eigen::Array<double, 2, 3, Eigen::RowMajor>& b)
+{
+  // Spread the lower 21 bits of x so that there are two zero bits
+  // between each bit
+  auto spread = [](std::uint64_t x) {
+    x &= 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffff;
+    x = (x | x << 16) & 0x1f0000ff0000ff;
+    x = (x | x << 8) & 0x100f00f00f00f00f;
+    x = (x | x << 4) & 0x10c30c30c30c30c3;
+    x = (x | x << 2) & 0x1249249249249249;
+    return x;
+  };
+
+  // Scale points to [0, 2^21) in each direction, relative to box
+  const double scale = (1 << 21) - 1;
+  const Eigen::Array<double, 1, 3> x0 = b.row(0);
+  Eigen::Array<double, 1, 3> h = b.row(1) - b.row(0);
+  for (int j = 0; j < 3; ++j)
+    h[j] = h[j] > 0.0 ? scale / h[j] : 0.0;
+
+  std::vector<std::uint64_t> codes(points.rows());
+  for (Eigen::Index i = 0; i < points.rows(); ++i)
+  {
+    std::uint64_t code = 0;
+    for (int j = 0; j < 3; ++j)
+    {
+      const double xs
+          = std::min(std::max((points(i, j) - x0[j]) * h[j], 0.0), scale);
+      code |= spread(static_cast<std::uint64_t>(xs)) << j;
+    }
+    codes[i] = code;
+  }
+
+  return codes;
+}
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t> geometry::compute_collisions_batch(
+    const BoundingBoxTree& tree,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    int num_threads)
+{
+  return ::compute_collisions_batch(tree, points, nullptr, num_threads);
+}
+//-----------------------------------------------------------------------------
+graph::AdjacencyList<std::int32_t> geometry::compute_entity_collisions_batch(
+    const BoundingBoxTree& tree,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    const mesh::Mesh& mesh, int num_threads)
+{
+  prepare_entity_queries(tree, mesh);
+  return ::compute_collisions_batch(tree, points, &mesh, num_threads);
+}
+//-----------------------------------------------------------------------------
+Eigen::Array<std::int32_t, Eigen::Dynamic, 1>
+geometry::compute_first_collision_batch(
+    const BoundingBoxTree& tree,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    int num_threads)
+{
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> entities
+      = Eigen::Array<std::int32_t, Eigen::Dynamic, 1>::Constant(points.rows(),
+                                                                -1);
+  if (tree.num_bboxes() == 0)
+    return entities;
+
+  const std::vector<std::int32_t> order
+      = compute_morton_order(points, tree.get_bbox(tree.num_bboxes() - 1));
+  parallel_for(points.rows(), num_threads,
+               [&](int, std::int64_t i0, std::int64_t i1) {
+                 std::vector<int> stack;
+                 for (std::int64_t i = i0; i < i1; ++i)
+                 {
+                   const std::int32_t q = order[i];
+                   entities[q] = compute_first_collision_stack(
+                       tree, points.row(q).transpose(), nullptr, stack);
+                 }
+               });
+
+  return entities;
+}
+//-----------------------------------------------------------------------------
+Eigen::Array<std::int32_t, Eigen::Dynamic, 1>
+geometry::compute_first_entity_collision_batch(
+    const BoundingBoxTree& tree,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    const mesh::Mesh& mesh, int num_threads)
+{
+  prepare_entity_queries(tree, mesh);
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> entities
+      = Eigen::Array<std::int32_t, Eigen::Dynamic, 1>::Constant(points.rows(),
+                                                                -1);
+  if (tree.num_bboxes() == 0)
+    return entities;
+
+  const std::vector<std::int32_t> order
+      = compute_morton_order(points, tree.get_bbox(tree.num_bboxes() - 1));
+  parallel_for(points.rows(), num_threads,
+               [&](int, std::int64_t i0, std::int64_t i1) {
+                 std::vector<int> stack;
+                 for (std::int64_t i = i0; i < i1; ++i)
+                 {
+                   const std::int32_t q = order[i];
+                   entities[q] = compute_first_collision_stack(
+                       tree, points.row(q).transpose(), &mesh, stack);
+                 }
+               });
+
+  return entities;
+}
+//-----------------------------------------------------------------------------
+std::pair<Eigen::Array<std::int32_t, Eigen::Dynamic, 1>, Eigen::ArrayXd>
+geometry::compute_closest_entity_batch(
+    const BoundingBoxTree& tree, const BoundingBoxTree& tree_midpoint,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    const mesh::Mesh& mesh, int num_threads)
+{
+  // Closest entity only implemented for cells. Consider extending this.
+  if (tree.tdim() != mesh.topology().dim())
+  {
+    throw std::runtime_error("Cannot compute closest entity of point. "
+                             "Closest-entity is only implemented for cells");
+  }
+  if (tree_midpoint.tdim() != 0)
+  {
+    throw std::runtime_error("Cannot compute closest point. "
+                             "Search tree has not been built for point cloud");
+  }
+
+  Eigen::Array<std::int32_t, Eigen::Dynamic, 1> entities(points.rows());
+  Eigen::ArrayXd distance(points.rows());
+  if (points.rows() == 0)
+    return {std::move(entities), std::move(distance)};
+
+  // No entities on this process (e.g. an empty partition)
+  if (tree.num_bboxes() == 0 or tree_midpoint.num_bboxes() == 0)
+  {
+    entities.setConstant(-1);
+    distance.setConstant(std::numeric_limits<double>::max());
+    return {std::move(entities), std::move(distance)};
+  }
+
+  const std::vector<std::int32_t> order
+      = compute_morton_order(points, tree.get_bbox(tree.num_bboxes() - 1));
+  parallel_for(
+      points.rows(), num_threads, [&](int, std::int64_t i0, std::int64_t i1) {
+        std::vector<int> stack;
+        for (std::int64_t i = i0; i < i1; ++i)
+        {
+          const std::int32_t q = order[i];
+          const Eigen::Vector3d p = points.row(q).transpose();
+
+          // Search point cloud to get a good starting guess, starting
+          // from the point in leaf node 0
+          const double R2
+              = (tree_midpoint.get_bbox(0).row(0).transpose().matrix() - p)
+                    .squaredNorm();
+          const std::pair<int, double> guess = compute_closest_point_stack(
+              tree_midpoint, p, tree_midpoint.bbox(0)[1], R2, stack);
+
+          // Return if we have found the point
+          if (guess.second == 0.0)
+          {
+            entities[q] = guess.first;
+            distance[q] = 0.0;
+            continue;
+          }
+
+          const std::pair<int, double> e = compute_closest_entity_stack(
+              tree, p, mesh, guess.first, guess.second, stack);
+          assert(e.first >= 0);
+          entities[q] = e.first;
+          distance[q] = std::sqrt(e.second);
+        }
+      });
+
+  return {std::move(entities), std::move(distance)};
+}
+//-----------------------------------------------------------------------------
+std::vector<std::vector<std::array<std::int32_t, 2>>>
+geometry::compute_distributed_collisions(const BoundingBoxTree& tree0,
+                                         const mesh::Mesh& mesh0,
+                                         const BoundingBoxTree& tree1,
+                                         const mesh::Mesh& mesh1,
+                                         int num_threads)
+{
+  const int tdim0 = mesh0.topology().dim();
+  const int tdim1 = mesh1.topology().dim();
+  if (tree0.tdim() != tdim0 or tree1.tdim() != tdim1)
+  {
+    throw std::runtime_error(
+        "Bounding box trees must be built for the cells of the meshes.");
+  }
+
+  MPI_Comm comm = mesh0.mpi_comm();
+  int comm_cmp;
+  MPI_Comm_compare(comm, mesh1.mpi_comm(), &comm_cmp);
+  if (comm_cmp == MPI_UNEQUAL)
+    throw std::runtime_error("Meshes must be on the same communicator.");
+  const int size = dolfinx::MPI::size(comm);
+
+  // Only owned cells are considered, so that each pair of cells is
+  // found once
+  const std::int32_t num_cells0
+      = mesh0.topology().index_map(tdim0)->size_local();
+  const std::int32_t num_cells1
+      = mesh1.topology().index_map(tdim1)->size_local();
+
+  // Gather coarse boxes covering mesh0 on each process
+  const std::vector<double> coarse_bboxes
+      = compute_coarse_bboxes(tree0, mesh0.geometry().dim(), 16);
+  const int num_values = coarse_bboxes.size();
+  std::vector<int> counts(size), offsets(size + 1, 0);
+  MPI_Allgather(&num_values, 1, MPI_INT, counts.data(), 1, MPI_INT, comm);
+  std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+  std::vector<double> all_coarse_bboxes(offsets.back());
+  MPI_Allgatherv(coarse_bboxes.data(), num_values, MPI_DOUBLE,
+                 all_coarse_bboxes.data(), counts.data(), offsets.data(),
+                 MPI_DOUBLE, comm);
+
+  // For each process, find owned cells of mesh1 with boxes that overlap
+  // the coarse boxes of the process
+  std::vector<std::vector<std::int32_t>> send_cells(size);
+  std::vector<std::vector<double>> send_bboxes(size);
+  {
+    std::vector<int> marker(num_cells1, -1);
+    std::vector<int> leaves, stack;
+    for (int p = 0; p < size; ++p)
+    {
+      for (int k = offsets[p]; k < offsets[p + 1]; k += 6)
+      {
+        const Eigen::Map<const Eigen::Array<double, 2, 3, Eigen::RowMajor>> b(
+            all_coarse_bboxes.data() + k);
+        leaves.clear();
+        compute_bbox_collisions_stack(tree1, b, leaves, stack);
+        for (int node : leaves)
+        {
+          const int c = tree1.bbox(node)[1];
+          if (c < num_cells1 and marker[c] != p)
+          {
+            marker[c] = p;
+            send_cells[p].push_back(c);
+            const Eigen::Array<double, 2, 3, Eigen::RowMajor> bc
+                = tree1.get_bbox(node);
+            send_bboxes[p].insert(send_bboxes[p].end(), bc.data(),
+                                  bc.data() + 6);
+          }
+        }
+      }
+    }
+  }
+
+  // Send cell indices and boxes to the processes whose part of mesh0
+  // they may overlap
+  const graph::AdjacencyList<std::int32_t> recv_cells
+      = dolfinx::MPI::all_to_all(
+          comm, graph::AdjacencyList<std::int32_t>(send_cells));
+  const graph::AdjacencyList<double> recv_bboxes = dolfinx::MPI::all_to_all(
+      comm, graph::AdjacencyList<double>(send_bboxes));
+  const std::int32_t num_recv = recv_cells.array().rows();
+  Eigen::Map<const Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>>
+      bboxes(recv_bboxes.array().data(), 2 * num_recv, 3);
+
+  // Find owned cells of mesh0 that overlap each received box, visiting
+  // boxes in Morton order of their midpoints
+  std::vector<std::vector<std::int32_t>> cells0(num_recv);
+  if (num_recv > 0 and tree0.num_bboxes() > 0)
+  {
+    Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor> midpoints(
+        num_recv, 3);
+    for (std::int32_t i = 0; i < num_recv; ++i)
+      midpoints.row(i) = 0.5 * (bboxes.row(2 * i) + bboxes.row(2 * i + 1));
+    const std::vector<std::int32_t> order = compute_morton_order(
+        midpoints, tree0.get_bbox(tree0.num_bboxes() - 1));
+
+    parallel_for(num_recv, num_threads,
+                 [&](int, std::int64_t i0, std::int64_t i1) {
+                   std::vector<int> leaves, stack;
+                   for (std::int64_t i = i0; i < i1; ++i)
+                   {
+                     const std::int32_t q = order[i];
+                     leaves.clear();
+                     compute_bbox_collisions_stack(
+                         tree0, bboxes.block<2, 3>(2 * q, 0), leaves, stack);
+                     for (int node : leaves)
+                     {
+                       const int c = tree0.bbox(node)[1];
+                       if (c < num_cells0)
+                         cells0[q].push_back(c);
+                     }
+                   }
+                 });
+  }
+
+  // Pack pairs (cell of mesh0, cell of mesh1) by owner of mesh1 cell
+  std::vector<std::vector<std::array<std::int32_t, 2>>> pairs(size);
+  for (int p = 0; p < size; ++p)
+  {
+    for (std::int32_t q = recv_cells.offsets()[p];
+         q < recv_cells.offsets()[p + 1]; ++q)
+    {
+      for (std::int32_t c0 : cells0[q])
+        pairs[p].push_back({c0, recv_cells.array()[q]});
+    }
+  }
+
+  return pairs;
+}
+//-----------------------------------------------------------------------------
+Eigen::Array<double, 2, 3, Eigen::RowMajor>
+geometry::compute_bbox_of_entity(const mesh::MeshEntity& entity)
+{
+  // Get mesh entity data
+  const int tdim = entity.mesh().topology().dim();
+  const int dim = entity.dim();
+  const mesh::Geometry& geometry = entity.mesh().geometry();
+  const graph::AdjacencyList<std::int32_t>& x_dofmap = geometry.dofmap();
+
+  entity.mesh().topology_mutable().create_connectivity(dim, tdim);
+
+  // Find attached cell
+  auto e_to_c = entity.mesh().topology().connectivity(dim, tdim);
+  assert(e_to_c);
+  assert(e_to_c->num_links(entity.index()) > 0);
+  const std::int32_t c = e_to_c->links(entity.index())[0];
+
+  auto dofs = x_dofmap.links(c);
+  auto c_to_v = entity.mesh().topology().connectivity(tdim, 0);
+  assert(c_to_v);
+  auto cell_vertices = c_to_v->links(c);
+
+  auto vertices = entity.entities(0);
+  assert(vertices.rows() >= 2);
+  const auto* it
+      = std::find(cell_vertices.data(),
+                  cell_vertices.data() + cell_vertices.rows(), vertices[0]);
+  assert(it != (cell_vertices.data() + cell_vertices.rows()));
+  const int local_vertex = std::distance(cell_vertices.data(), it);
+
+  const Eigen::Vector3d x0 = geometry.node(dofs(local_vertex));
+  Eigen::Array<double, 2, 3, Eigen::RowMajor> b;
+  b.row(0) = x0;
+  b.row(1) = x0;
+
+  // Compute min and max over remaining vertices
+  for (int i = 1; i < vertices.rows(); ++i)
+  {
+    const auto* it
+        = std::find(cell_vertices.data(),
+                    cell_vertices.data() + cell_vertices.rows(), vertices[i]);
+    assert(it != (cell_vertices.data() + cell_vertices.rows()));
+    const int local_vertex = std::distance(cell_vertices.data(), it);
+
+    const Eigen::Vector3d x = geometry.node(dofs(local_vertex));
+    b.row(0) = b.row(0).min(x.transpose().array());
+    b.row(1) = b.row(1).max(x.transpose().array());
+  }
+
+  return b;
+}
+//-----------------------------------------------------------------------------
 bool geometry::point_in_bbox(
     const Eigen::Array<double, 2, 3, Eigen::RowMajor>& b,
     const Eigen::Vector3d& x, double rtol)
@@ -8,11 +8,19 @@
 
 #include "BoundingBoxTree.h"
 #include <Eigen/Dense>
+#include <array>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
 namespace dolfinx
 {
+namespace graph
+{
+template <typename T>
+class AdjacencyList;
+} // namespace graph
+
 namespace mesh
 {
 class Mesh;
@@ -37,6 +45,52 @@ compute_entity_collisions(const BoundingBoxTree& tree0,
                           const BoundingBoxTree& tree1, const mesh::Mesh& mesh0,
                           const mesh::Mesh& mesh1);
 
+/// Compute candidate pairs of overlapping cells of two meshes that
+/// are distributed over the same processes. Coarse boxes covering
+/// each process's part of mesh0 are exchanged, and each process sends
+/// the boxes of its owned mesh1 cells that overlap them to that
+/// process. The received boxes are then located in tree0 (using
+/// num_threads threads). Only owned cells are considered, so each pair
+/// of cells is found on one process only. Collective.
+/// @param[in] tree0 Bounding box tree for the cells of mesh0
+/// @param[in] mesh0 The first mesh
+/// @param[in] tree1 Bounding box tree for the cells of mesh1
+/// @param[in] mesh1 The second mesh
+/// @param[in] num_threads Number of threads to use
+/// @return For each process p, pairs (c0, c1) of cells with
+///   overlapping bounding boxes, where c0 is a local cell of mesh0 on
+///   this process and c1 is a local cell of mesh1 on process p
+std::vector<std::vector<std::array<std::int32_t, 2>>>
+compute_distributed_collisions(const BoundingBoxTree& tree0,
+                               const mesh::Mesh& mesh0,
+                               const BoundingBoxTree& tree1,
+                               const mesh::Mesh& mesh1, int num_threads = 1);
+
+/// Compute the distance from points to a set of mesh facets, e.g. the
+/// wall distance at the degree-of-freedom coordinates of a function
+/// space. Each process receives the facets of only those processes
+/// that may hold the closest facet to one of its points, found from
+/// coarse boxes covering the facets of each process. The distance is
+/// to the closest facet on any process. This is collective on the mesh
+/// communicator.
+/// @param[in] mesh The mesh
+/// @param[in] facets Indices (local to the process) of the facets
+/// @param[in] points The points (one point per row)
+/// @param[in] signed_distance If true, the distance is negative for
+///   points on the same side of the closest facet as the (first) cell
+///   attached to it, e.g. for points inside the domain when the facets
+///   are exterior facets
+/// @param[in] num_threads Number of threads to use
+/// @return The (signed) distance for each point. It is infinite if
+///   there are no facets.
+Eigen::ArrayXd compute_distance_to_facets(
+    const mesh::Mesh& mesh,
+    const Eigen::Ref<const Eigen::Array<std::int32_t, Eigen::Dynamic, 1>>&
+        facets,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    bool signed_distance = false, int num_threads = 1);
+
 /// Compute all collisions between bounding boxes and point
 /// @param[in] tree The bounding box tree
 /// @param[in] p The point
@@ -69,6 +123,99 @@ int compute_first_entity_collision(const BoundingBoxTree& tree,
                                    const Eigen::Vector3d& p,
                                    const mesh::Mesh& mesh);
 
+/// Compute all collisions between bounding boxes and a batch of
+/// points. Points are processed in Morton (Z-curve) order for cache
+/// locality, and the traversal is split across threads.
+/// @param[in] tree The bounding box tree
+/// @param[in] points The points (one point per row)
+/// @param[in] num_threads Number of threads to use
+/// @return For each point, the bounding box leaves that contain it
+graph::AdjacencyList<std::int32_t> compute_collisions_batch(
+    const BoundingBoxTree& tree,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    int num_threads = 1);
+
+/// Compute all collisions between mesh cells and a batch of points.
+/// See compute_collisions_batch.
+/// @param[in] tree The bounding box tree (built for cells)
+/// @param[in] points The points (one point per row)
+/// @param[in] mesh The mesh
+/// @param[in] num_threads Number of threads to use
+/// @return For each point, the cells that contain it
+graph::AdjacencyList<std::int32_t> compute_entity_collisions_batch(
+    const BoundingBoxTree& tree,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    const mesh::Mesh& mesh, int num_threads = 1);
+
+/// Compute first collision between bounding boxes and each point in a
+/// batch of points. See compute_collisions_batch.
+/// @param[in] tree The bounding box tree
+/// @param[in] points The points (one point per row)
+/// @param[in] num_threads Number of threads to use
+/// @return For each point, the index of the first found box that
+///   contains the point (-1 if none)
+Eigen::Array<std::int32_t, Eigen::Dynamic, 1> compute_first_collision_batch(
+    const BoundingBoxTree& tree,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    int num_threads = 1);
+
+/// Compute first collision between mesh cells and each point in a
+/// batch of points. See compute_collisions_batch.
+/// @param[in] tree The bounding box tree (built for cells)
+/// @param[in] points The points (one point per row)
+/// @param[in] mesh The mesh
+/// @param[in] num_threads Number of threads to use
+/// @return For each point, the index of the first found cell that
+///   contains the point (-1 if none)
+Eigen::Array<std::int32_t, Eigen::Dynamic, 1>
+compute_first_entity_collision_batch(
+    const BoundingBoxTree& tree,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    const mesh::Mesh& mesh, int num_threads = 1);
+
+/// Compute closest cell and distance for each point in a batch of
+/// points. See compute_collisions_batch. Only simplex cells are
+/// supported.
+/// @param[in] tree The bounding box tree (built for cells)
+/// @param[in] tree_midpoint Bounding box tree for the cell midpoints
+///   (see create_midpoint_tree)
+/// @param[in] points The points (one point per row)
+/// @param[in] mesh The mesh
+/// @param[in] num_threads Number of threads to use
+/// @return (closest cell, distance) for each point. If the tree is
+///   empty, the cell is -1 and the distance is the largest double.
+std::pair<Eigen::Array<std::int32_t, Eigen::Dynamic, 1>, Eigen::ArrayXd>
+compute_closest_entity_batch(
+    const BoundingBoxTree& tree, const BoundingBoxTree& tree_midpoint,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    const mesh::Mesh& mesh, int num_threads = 1);
+
+/// Compute Morton (Z-curve) codes for points. Coordinates are scaled
+/// to 21-bit integers relative to a bounding box, and points outside
+/// the box are clamped to it.
+/// @param[in] points The points (one point per row)
+/// @param[in] b The bounding box (row 0 is the lower corner and row 1
+///   is the upper corner)
+/// @return The Morton code for each point
+std::vector<std::uint64_t> compute_morton_codes(
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    const Eigen::Array<double, 2, 3, Eigen::RowMajor>& b);
+
+/// Compute the ordering of points by Morton code
+/// @param[in] points The points (one point per row)
+/// @param[in] b The bounding box used to compute the Morton codes
+/// @return Point indices, sorted by Morton code
+std::vector<std::int32_t> compute_morton_order(
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                        Eigen::RowMajor>>& points,
+    const Eigen::Array<double, 2, 3, Eigen::RowMajor>& b);
+
 /// Compute all collisions between processes and Point returning a
 /// list of process ranks
 std::vector<int> compute_process_collisions(const BoundingBoxTree& tree,
@@ -80,7 +227,8 @@ bool bbox_in_bbox(const Eigen::Array<double, 2, 3, Eigen::RowMajor>& a,
                   double rtol = 1e-14);
 
 /// Compute closest mesh entity and distance to the point. The tree must
-/// have been initialised with topological co-dimension 0.
+/// have been initialised with topological co-dimension 0. If the tree
+/// is empty, (-1, largest double) is returned.
 std::pair<int, double>
 compute_closest_entity(const BoundingBoxTree& tree,
                        const BoundingBoxTree& tree_midpoint,
@@ -94,6 +242,13 @@ compute_closest_entity(const BoundingBoxTree& tree,
 std::pair<int, double> compute_closest_point(const BoundingBoxTree& tree,
                                              const Eigen::Vector3d& p);
 
+/// Compute the axis-aligned bounding box of a mesh entity
+/// @param[in] entity The mesh entity
+/// @return The bounding box where row(0) is the lower corner and
+///         row(1) is the upper corner
+Eigen::Array<double, 2, 3, Eigen::RowMajor>
+compute_bbox_of_entity(const mesh::MeshEntity& entity);
+
 /// Check whether point (x) is in bounding box
 /// @param[in] b The bounding box
 /// @param[in] x The point to check
@@ -18,8 +18,8 @@ using namespace dolfinx::io;
 
 //-----------------------------------------------------------------------------
 HDF5File::HDF5File(MPI_Comm comm, const std::string& filename,
-                   const std::string& file_mode)
-    : _hdf5_file_id(0), _mpi_comm(comm)
+                   const std::string& file_mode, const HDF5Policy& policy)
+    : _hdf5_file_id(0), _mpi_comm(comm), _policy(policy)
 {
   // See https://www.hdfgroup.org/hdf5-quest.html#gzero on zero for
   // _hdf5_file_id(0)
@@ -52,16 +52,26 @@ HDF5File::HDF5File(MPI_Comm comm, const std::string& filename,
         "Cannot open file. HDF5 has not been compiled with support for MPI");
   }
 #endif
-  _hdf5_file_id
-      = HDF5Interface::open_file(_mpi_comm.comm(), filename, file_mode, mpi_io);
+  _hdf5_file_id = HDF5Interface::open_file(_mpi_comm.comm(), filename,
+                                           file_mode, mpi_io, _policy);
   assert(_hdf5_file_id > 0);
+  _dxpl_id = HDF5Interface::create_transfer_properties(mpi_io, _policy);
 }
 //-----------------------------------------------------------------------------
 HDF5File::~HDF5File() { close(); }
 //-----------------------------------------------------------------------------
 void HDF5File::close()
 {
-  // Close HDF5 file
+  // Flush pending asynchronous writes
+  if (_write_queue)
+  {
+    _write_queue->wait();
+    _write_queue.reset();
+  }
+
+  // Close HDF5 file and its transfer properties
+  HDF5Interface::close_transfer_properties(_dxpl_id);
+  _dxpl_id = H5P_DEFAULT;
   if (_hdf5_file_id > 0)
     HDF5Interface::close_file(_hdf5_file_id);
   _hdf5_file_id = 0;
@@ -70,24 +80,57 @@ void HDF5File::close()
 void HDF5File::flush()
 {
   assert(_hdf5_file_id > 0);
+  wait();
   HDF5Interface::flush_file(_hdf5_file_id);
 }
 //-----------------------------------------------------------------------------
+void HDF5File::set_asynchronous(bool enable, std::size_t max_staged_bytes)
+{
+  assert(_hdf5_file_id > 0);
+
+  // Flush and stop any existing queue
+  if (_write_queue)
+  {
+    _write_queue->wait();
+    _write_queue.reset();
+  }
+
+  if (!enable)
+    return;
+
+  if (!HDF5WriteQueue::supported(_mpi_comm.comm()))
+    return;
+
+  _write_queue = std::make_unique<HDF5WriteQueue>(_hdf5_file_id, _dxpl_id,
+                                                  max_staged_bytes);
+}
+//-----------------------------------------------------------------------------
+void HDF5File::wait()
+{
+  if (_write_queue)
+    _write_queue->wait();
+}
+//-----------------------------------------------------------------------------
 bool HDF5File::has_dataset(const std::string& dataset_name) const
 {
   assert(_hdf5_file_id > 0);
+  if (_write_queue)
+    _write_queue->wait();
   return HDF5Interface::has_dataset(_hdf5_file_id, dataset_name);
 }
 //-----------------------------------------------------------------------------
 void HDF5File::set_mpi_atomicity(bool atomic)
 {
   assert(_hdf5_file_id > 0);
+  wait();
   HDF5Interface::set_mpi_atomicity(_hdf5_file_id, atomic);
 }
 //-----------------------------------------------------------------------------
 bool HDF5File::get_mpi_atomicity() const
 {
   assert(_hdf5_file_id > 0);
+  if (_write_queue)
+    _write_queue->wait();
   return HDF5Interface::get_mpi_atomicity(_hdf5_file_id);
 }
 //-----------------------------------------------------------------------------
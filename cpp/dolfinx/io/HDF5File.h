@@ -7,6 +7,7 @@
 #pragma once
 
 #include "HDF5Interface.h"
+#include "HDF5WriteQueue.h"
 #include <Eigen/Dense>
 #include <dolfinx/common/MPI.h>
 #include <memory>
@@ -24,9 +25,11 @@ class HDF5File
 
 public:
   /// Constructor. file_mode should be "a" (append), "w" (write) or "r"
-  /// (read).
+  /// (read). The policy sets file access parameters and the chunk and
+  /// transfer parameters used by write_data.
   HDF5File(MPI_Comm comm, const std::string& filename,
-           const std::string& file_mode);
+           const std::string& file_mode,
+           const HDF5Policy& policy = HDF5Policy());
 
   /// Destructor
   ~HDF5File();
@@ -52,6 +55,20 @@ public:
   /// Chunking parameter - partition data into fixed size blocks for efficiency
   bool chunking = false;
 
+  /// Enable or disable asynchronous writes. When enabled, write_data
+  /// copies the data into a staging buffer and returns, and a
+  /// background I/O thread writes the data to file. This requires a
+  /// threadsafe HDF5 library and, in parallel, MPI to have been
+  /// initialised with MPI_THREAD_MULTIPLE, otherwise writes remain
+  /// synchronous.
+  /// @param[in] enable True to enable asynchronous writes
+  /// @param[in] max_staged_bytes Bound on the size of staged data. A
+  ///   write blocks if the bound would be exceeded. Zero means no bound.
+  void set_asynchronous(bool enable, std::size_t max_staged_bytes = 0);
+
+  /// Block until all pending asynchronous writes have completed
+  void wait();
+
   /// Write contiguous data to HDF5 data set. Data is flattened into a
   /// 1D array, e.g. [x0, y0, z0, x1, y1, z1] for a vector in 3D
   template <typename T>
@@ -71,8 +88,18 @@ private:
   // HDF5 file descriptor/handle
   hid_t _hdf5_file_id;
 
+  // HDF5 data transfer property list (H5P_DEFAULT if the file is not
+  // opened with MPI-IO)
+  hid_t _dxpl_id = H5P_DEFAULT;
+
   // MPI communicator
   dolfinx::MPI::Comm _mpi_comm;
+
+  // I/O parameters
+  HDF5Policy _policy;
+
+  // Queue for asynchronous writes (null if writes are synchronous)
+  std::unique_ptr<HDF5WriteQueue> _write_queue;
 };
 
 //---------------------------------------------------------------------------
@@ -102,8 +129,17 @@ void HDF5File::write_data(const std::string& dataset_name,
   if (dset_name[0] != '/')
     dset_name = "/" + dataset_name;
 
-  HDF5Interface::write_dataset(_hdf5_file_id, dset_name, data.data(), range,
-                               global_size, use_mpi_io, chunking);
+  if (_write_queue)
+  {
+    _write_queue->write_dataset(dset_name, data, range, global_size,
+                                use_mpi_io, chunking, _policy);
+  }
+  else
+  {
+    HDF5Interface::write_dataset(_hdf5_file_id, dset_name, data.data(), range,
+                                 global_size, use_mpi_io, chunking, _policy,
+                                 _dxpl_id);
+  }
 }
 //-----------------------------------------------------------------------------
 template <typename T>
@@ -133,8 +169,18 @@ void HDF5File::write_data(const std::string& dataset_name,
   if (data.cols() == 1)
     global_size = {global_rows};
 
-  HDF5Interface::write_dataset(_hdf5_file_id, dset_name, data.data(), range,
-                               global_size, use_mpi_io, chunking);
+  if (_write_queue)
+  {
+    _write_queue->write_dataset(
+        dset_name, std::vector<T>(data.data(), data.data() + data.size()),
+        range, global_size, use_mpi_io, chunking, _policy);
+  }
+  else
+  {
+    HDF5Interface::write_dataset(_hdf5_file_id, dset_name, data.data(), range,
+                                 global_size, use_mpi_io, chunking, _policy,
+                                 _dxpl_id);
+  }
 }
 //---------------------------------------------------------------------------
 } // namespace dolfinx::io
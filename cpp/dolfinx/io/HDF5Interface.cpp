@@ -16,7 +16,8 @@ using namespace dolfinx::io;
 
 //-----------------------------------------------------------------------------
 hid_t HDF5Interface::open_file(MPI_Comm mpi_comm, const std::string filename,
-                               const std::string mode, const bool use_mpi_io)
+                               const std::string mode, const bool use_mpi_io,
+                               const HDF5Policy& policy)
 {
   // Set parallel access with communicator
   const hid_t plist_id = H5Pcreate(H5P_FILE_ACCESS);
@@ -26,12 +27,45 @@ hid_t HDF5Interface::open_file(MPI_Comm mpi_comm, const std::string filename,
   {
     MPI_Info info;
     MPI_Info_create(&info);
+    for (const auto& hint : policy.mpi_info)
+      MPI_Info_set(info, hint.first.c_str(), hint.second.c_str());
     if (H5Pset_fapl_mpio(plist_id, mpi_comm, info) < 0)
       throw std::runtime_error("Call to H5Pset_fapl_mpio unsuccessful");
     MPI_Info_free(&info);
+
+#if H5_VERSION_GE(1, 10, 0)
+    if (policy.collective_metadata_write
+        and H5Pset_coll_metadata_write(plist_id, true) < 0)
+    {
+      throw std::runtime_error("Call to H5Pset_coll_metadata_write unsuccessful");
+    }
+    if (policy.collective_metadata_ops
+        and H5Pset_all_coll_metadata_ops(plist_id, true) < 0)
+    {
+      throw std::runtime_error(
+          "Call to H5Pset_all_coll_metadata_ops unsuccessful");
+    }
+#endif
   }
 #endif
 
+  // Set object alignment in file
+  if (policy.alignment[1] > 1)
+  {
+    if (H5Pset_alignment(plist_id, policy.alignment[0], policy.alignment[1])
+        < 0)
+    {
+      throw std::runtime_error("Call to H5Pset_alignment unsuccessful");
+    }
+  }
+
+  // Set size of data sieve buffer
+  if (policy.sieve_buffer_size > 0
+      and H5Pset_sieve_buf_size(plist_id, policy.sieve_buffer_size) < 0)
+  {
+    throw std::runtime_error("Call to H5Pset_sieve_buf_size unsuccessful");
+  }
+
   hid_t file_id = -1;
   if (mode == "w") // Create file for write, overwriting any existing file
   {
@@ -79,6 +113,37 @@ void HDF5Interface::close_file(const hid_t hdf5_file_handle)
     throw std::runtime_error("Failed to close HDF5 file.");
 }
 //-----------------------------------------------------------------------------
+hid_t HDF5Interface::create_transfer_properties(const bool use_mpi_io,
+                                                const HDF5Policy& policy)
+{
+  if (!use_mpi_io)
+    return H5P_DEFAULT;
+
+#ifdef H5_HAVE_PARALLEL
+  // Filters (compression) require a collective transfer
+  const bool collective = policy.collective_transfer
+                          or policy.deflate_level > 0 or policy.shuffle
+                          or policy.filter_id > 0;
+  const hid_t dxpl_id = H5Pcreate(H5P_DATASET_XFER);
+  if (H5Pset_dxpl_mpio(dxpl_id, collective ? H5FD_MPIO_COLLECTIVE
+                                           : H5FD_MPIO_INDEPENDENT)
+      < 0)
+  {
+    throw std::runtime_error("Call to H5Pset_dxpl_mpio unsuccessful");
+  }
+  return dxpl_id;
+#else
+  throw std::runtime_error("HDF5 library has not been configured with MPI");
+  return H5P_DEFAULT;
+#endif
+}
+//-----------------------------------------------------------------------------
+void HDF5Interface::close_transfer_properties(const hid_t dxpl_id)
+{
+  if (dxpl_id != H5P_DEFAULT and H5Pclose(dxpl_id) < 0)
+    throw std::runtime_error("Failed to close HDF5 transfer property list.");
+}
+//-----------------------------------------------------------------------------
 void HDF5Interface::flush_file(const hid_t hdf5_file_handle)
 {
   if (H5Fflush(hdf5_file_handle, H5F_SCOPE_GLOBAL) < 0)
@@ -6,9 +6,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <map>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 // Note: dolfin/common/MPI.h is included before hdf5.h to avoid the
@@ -25,6 +28,67 @@ namespace io
 {
 class HDF5File;
 
+/// Parameters that control the layout of data in HDF5 files and how
+/// data is transferred to and from files. File access parameters are
+/// applied when a file is opened, and the chunk and transfer
+/// parameters are applied when datasets are written.
+struct HDF5Policy
+{
+  /// Number of rows in a chunk. If positive, datasets with more than
+  /// chunk_rows rows are written with chunked storage (smaller datasets
+  /// are stored contiguously). If zero, only datasets for which
+  /// chunking is requested (or filters are used) are chunked, and a
+  /// chunk holds half of the rows of the dataset, bounded to between
+  /// 1024 and 1048576 rows.
+  std::int64_t chunk_rows = 0;
+
+  /// Objects larger than alignment_threshold bytes are aligned on
+  /// alignment byte boundaries in the file (see H5Pset_alignment). An
+  /// alignment of 1 means no alignment. Aligning to the file system
+  /// stripe or block size can improve parallel write performance.
+  std::array<std::int64_t, 2> alignment = {{1, 1}};
+
+  /// Write file metadata collectively (see H5Pset_coll_metadata_write)
+  bool collective_metadata_write = false;
+
+  /// Perform metadata reads collectively (see
+  /// H5Pset_all_coll_metadata_ops)
+  bool collective_metadata_ops = false;
+
+  /// Size in bytes of the data sieve buffer (see
+  /// H5Pset_sieve_buf_size). If zero, the HDF5 default is used.
+  std::size_t sieve_buffer_size = 0;
+
+  /// Use collective (true) or independent (false) MPI-IO data
+  /// transfer
+  bool collective_transfer = true;
+
+  /// MPI-IO hints passed to MPI_File_open through an MPI_Info object,
+  /// e.g. {"striping_factor", "16"} or {"romio_cb_write", "enable"}
+  std::map<std::string, std::string> mpi_info;
+
+  /// Store double precision datasets in single precision
+  bool float32 = false;
+
+  /// Compression level (1-9) for the deflate (gzip) filter. If zero,
+  /// the filter is not used.
+  int deflate_level = 0;
+
+  /// Apply the byte shuffle filter (improves compression of floating
+  /// point data)
+  bool shuffle = false;
+
+  /// Identifier of an additional (registered, e.g. lossy ZFP or SZ)
+  /// HDF5 filter plugin, and its parameters. If zero, no additional
+  /// filter is used. The filter is applied to floating point datasets
+  /// only, so that integer data (e.g. topology) is never stored lossily.
+  /// It is skipped with a warning if it is not available.
+  int filter_id = 0;
+
+  /// Parameters for the filter filter_id
+  std::vector<unsigned int> filter_parameters;
+};
+
 /// This class wraps HDF5 function calls. HDF5 function calls should
 /// only appear in a member function of this class and not elsewhere
 /// in the library.
@@ -34,12 +98,34 @@ class HDF5Interface
 #define HDF5_FAIL -1
 public:
   /// Open HDF5 and return file descriptor
+  /// @param[in] mpi_comm MPI communicator
+  /// @param[in] filename Name of the file
+  /// @param[in] mode "w" (write), "a" (append) or "r" (read)
+  /// @param[in] use_mpi_io True if file should be opened with MPI-IO
+  /// @param[in] policy File access parameters (alignment, metadata
+  ///   operations, data sieving and MPI-IO hints)
   static hid_t open_file(MPI_Comm mpi_comm, const std::string filename,
-                         const std::string mode, const bool use_mpi_io);
+                         const std::string mode, const bool use_mpi_io,
+                         const HDF5Policy& policy = HDF5Policy());
 
   /// Close HDF5 file
   static void close_file(const hid_t hdf5_file_handle);
 
+  /// Create the data transfer property list for the datasets of a
+  /// file. The transfer is collective if requested by the policy or if
+  /// filters are used. The caller owns the property list and should
+  /// close it with close_transfer_properties when the file is closed.
+  /// @param[in] use_mpi_io True if the file was opened with MPI-IO
+  /// @param[in] policy Data transfer parameters
+  /// @return Property list, or H5P_DEFAULT if use_mpi_io is false
+  static hid_t create_transfer_properties(const bool use_mpi_io,
+                                          const HDF5Policy& policy
+                                          = HDF5Policy());
+
+  /// Close a data transfer property list created by
+  /// create_transfer_properties
+  static void close_transfer_properties(const hid_t dxpl_id);
+
   /// Flush data to file to improve data integrity after
   /// interruption
   static void flush_file(const hid_t hdf5_file_handle);
@@ -54,21 +140,49 @@ public:
   /// global_size: the global multidimensional shape of the array
   /// use_mpio: whether using MPI or not
   /// use_chunking: whether using chunking or not
+  /// policy: chunk size, data transfer mode, storage precision and
+  /// filters (compression). Filters imply chunked storage.
+  /// dxpl_id: data transfer property list of the file (see
+  /// create_transfer_properties). If H5P_DEFAULT and use_mpio is true,
+  /// a property list is created for this write.
   template <typename T>
   static void write_dataset(const hid_t file_handle,
                             const std::string dataset_path, const T* data,
                             const std::array<std::int64_t, 2> range,
                             const std::vector<std::int64_t> global_size,
-                            bool use_mpio, bool use_chunking);
+                            bool use_mpio, bool use_chunking,
+                            const HDF5Policy& policy = HDF5Policy(),
+                            const hid_t dxpl_id = H5P_DEFAULT);
 
   /// Read data from a HDF5 dataset "dataset_path" as defined by
   /// range blocks on each process range: the local range on this
   /// processor data: a flattened 1D array of values. If range = {-1, -1},
-  /// then all data is read on this process.
+  /// then all data is read on this process. dxpl_id is the data
+  /// transfer property list of the file (see
+  /// create_transfer_properties). If it is collective, all processes
+  /// must call this function.
   template <typename T>
   static std::vector<T> read_dataset(const hid_t file_handle,
                                      const std::string dataset_path,
-                                     const std::array<std::int64_t, 2> range);
+                                     const std::array<std::int64_t, 2> range,
+                                     const hid_t dxpl_id = H5P_DEFAULT);
+
+  /// Read a subset of the rows (first dimension) of a HDF5 dataset
+  /// "dataset_path". The rows are coalesced into ranges, which may
+  /// include short gaps of unrequested rows, and the ranges are read as
+  /// a union of hyperslabs with a single read call.
+  /// @param[in] file_handle HDF5 file handle
+  /// @param[in] dataset_path Path to the dataset
+  /// @param[in] rows Sorted list of unique row indices to read
+  /// @param[in] dxpl_id Data transfer property list of the file (see
+  ///   create_transfer_properties). If it is collective, all processes
+  ///   must call this function (possibly with no rows).
+  /// @return Flattened 1D array of values in the order of @p rows
+  template <typename T>
+  static std::vector<T>
+  read_dataset_rows(const hid_t file_handle, const std::string dataset_path,
+                    const std::vector<std::int64_t>& rows,
+                    const hid_t dxpl_id = H5P_DEFAULT);
 
   /// Check for existence of group in HDF5 file
   static bool has_group(const hid_t hdf5_file_handle,
@@ -218,7 +332,8 @@ template <typename T>
 inline void HDF5Interface::write_dataset(
     const hid_t file_handle, const std::string dataset_path, const T* data,
     const std::array<std::int64_t, 2> range,
-    const std::vector<int64_t> global_size, bool use_mpi_io, bool use_chunking)
+    const std::vector<int64_t> global_size, bool use_mpi_io, bool use_chunking,
+    const HDF5Policy& policy, const hid_t dxpl_id)
 {
   // Data rank
   const std::size_t rank = global_size.size();
@@ -230,9 +345,43 @@ inline void HDF5Interface::write_dataset(
                              "Only rank 1 and rank 2 dataset are supported");
   }
 
+  // Convert to single precision if requested
+  if constexpr (std::is_same<T, double>::value)
+  {
+    if (policy.float32)
+    {
+      std::int64_t num_values = range[1] - range[0];
+      if (rank > 1)
+        num_values *= global_size[1];
+      const std::vector<float> data_float(data, data + num_values);
+      write_dataset(file_handle, dataset_path, data_float.data(), range,
+                    global_size, use_mpi_io, use_chunking, policy, dxpl_id);
+      return;
+    }
+  }
+
   // Get HDF5 data type
   const hid_t h5type = hdf5_type<T>();
 
+  // Filters (compression) require chunked storage, and in parallel a
+  // collective transfer and HDF5 >= 1.10.2
+  const bool use_plugin
+      = policy.filter_id > 0 and std::is_floating_point<T>::value;
+  const bool use_filters
+      = policy.deflate_level > 0 or policy.shuffle or use_plugin;
+  if (use_filters and use_mpi_io)
+  {
+#if !H5_VERSION_GE(1, 10, 2)
+    throw std::runtime_error(
+        "Writing compressed datasets in parallel requires HDF5 >= 1.10.2");
+#endif
+  }
+  // Datasets that fit in a single chunk of the policy are stored
+  // contiguously
+  const bool chunk_by_policy
+      = policy.chunk_rows > 0 and global_size[0] > policy.chunk_rows;
+  use_chunking = use_chunking or use_filters or chunk_by_policy;
+
   // Hyperslab selection parameters
   std::vector<hsize_t> count(global_size.begin(), global_size.end());
   count[0] = range[1] - range[0];
@@ -255,16 +404,62 @@ inline void HDF5Interface::write_dataset(
   hid_t chunking_properties;
   if (use_chunking)
   {
-    // Set chunk size and limit to 1kB min/1MB max
-    hsize_t chunk_size = dimsf[0] / 2;
-    if (chunk_size > 1048576)
-      chunk_size = 1048576;
-    if (chunk_size < 1024)
-      chunk_size = 1024;
-
-    hsize_t chunk_dims[2] = {chunk_size, dimsf[1]};
+    // Set chunk size from policy, or limit to 1kB min/1MB max
+    hsize_t chunk_size = policy.chunk_rows;
+    if (chunk_size == 0)
+    {
+      chunk_size = dimsf[0] / 2;
+      if (chunk_size > 1048576)
+        chunk_size = 1048576;
+      if (chunk_size < 1024)
+        chunk_size = 1024;
+    }
+
+    // Chunks cannot be larger than a fixed-size dataset
+    if (chunk_size > dimsf[0])
+      chunk_size = dimsf[0] > 0 ? dimsf[0] : 1;
+
+    hsize_t chunk_dims[2] = {chunk_size, rank > 1 ? dimsf[1] : 1};
     chunking_properties = H5Pcreate(H5P_DATASET_CREATE);
     H5Pset_chunk(chunking_properties, rank, chunk_dims);
+
+    // Add filters (applied in order on write)
+    if (use_plugin)
+    {
+      if (H5Zfilter_avail(policy.filter_id) > 0)
+      {
+        status = H5Pset_filter(chunking_properties, policy.filter_id,
+                               H5Z_FLAG_MANDATORY,
+                               policy.filter_parameters.size(),
+                               policy.filter_parameters.data());
+        assert(status != HDF5_FAIL);
+      }
+      else
+      {
+        LOG(WARNING) << "HDF5 filter " << policy.filter_id
+                     << " is not available. Writing dataset \""
+                     << dataset_path << "\" without it.";
+      }
+    }
+    if (policy.shuffle)
+    {
+      status = H5Pset_shuffle(chunking_properties);
+      assert(status != HDF5_FAIL);
+    }
+    if (policy.deflate_level > 0)
+    {
+      if (H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+      {
+        status = H5Pset_deflate(chunking_properties, policy.deflate_level);
+        assert(status != HDF5_FAIL);
+      }
+      else
+      {
+        LOG(WARNING) << "HDF5 deflate filter is not available. Writing "
+                        "dataset \""
+                     << dataset_path << "\" without compression.";
+      }
+    }
   }
   else
     chunking_properties = H5P_DEFAULT;
@@ -293,22 +488,20 @@ inline void HDF5Interface::write_dataset(
                                nullptr, count.data(), nullptr);
   assert(status != HDF5_FAIL);
 
-  // Set parallel access
-  const hid_t plist_id = H5Pcreate(H5P_DATASET_XFER);
-  if (use_mpi_io)
-  {
-#ifdef H5_HAVE_PARALLEL
-    status = H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE);
-    assert(status != HDF5_FAIL);
-#else
-    throw std::runtime_error("HDF5 library has not been configured with MPI");
-#endif
-  }
+  // Parallel access (use the transfer properties of the file, if
+  // provided)
+  hid_t plist_id = use_mpi_io ? dxpl_id : H5P_DEFAULT;
+  const bool own_plist = use_mpi_io and dxpl_id == H5P_DEFAULT;
+  if (own_plist)
+    plist_id = create_transfer_properties(true, policy);
 
   // Write local dataset into selected hyperslab
   status = H5Dwrite(dset_id, h5type, memspace, filespace1, plist_id, data);
   assert(status != HDF5_FAIL);
 
+  if (own_plist)
+    close_transfer_properties(plist_id);
+
   if (use_chunking)
   {
     // Close chunking properties
@@ -327,17 +520,14 @@ inline void HDF5Interface::write_dataset(
   // Close local dataset
   status = H5Sclose(memspace);
   assert(status != HDF5_FAIL);
-
-  // Release file-access template
-  status = H5Pclose(plist_id);
-  assert(status != HDF5_FAIL);
 }
 //---------------------------------------------------------------------------
 template <typename T>
 inline std::vector<T>
 HDF5Interface::read_dataset(const hid_t file_handle,
                             const std::string dataset_path,
-                            const std::array<std::int64_t, 2> range)
+                            const std::array<std::int64_t, 2> range,
+                            const hid_t dxpl_id)
 {
   // Open the dataset
   const hid_t dset_id
@@ -389,10 +579,101 @@ HDF5Interface::read_dataset(const hid_t file_handle,
     data_size *= count[i];
   std::vector<T> data(data_size);
 
+  // Read data on each process
+  const hid_t h5type = hdf5_type<T>();
+  status = H5Dread(dset_id, h5type, memspace, dataspace, dxpl_id, data.data());
+  assert(status != HDF5_FAIL);
+
+  // Close dataspace
+  status = H5Sclose(dataspace);
+  assert(status != HDF5_FAIL);
+
+  // Close memspace
+  status = H5Sclose(memspace);
+  assert(status != HDF5_FAIL);
+
+  // Close dataset
+  status = H5Dclose(dset_id);
+  assert(status != HDF5_FAIL);
+
+  return data;
+}
+//---------------------------------------------------------------------------
+template <typename T>
+inline std::vector<T>
+HDF5Interface::read_dataset_rows(const hid_t file_handle,
+                                 const std::string dataset_path,
+                                 const std::vector<std::int64_t>& rows,
+                                 const hid_t dxpl_id)
+{
+  assert(std::is_sorted(rows.begin(), rows.end()));
+
+  // Open the dataset
+  const hid_t dset_id
+      = H5Dopen2(file_handle, dataset_path.c_str(), H5P_DEFAULT);
+  assert(dset_id != HDF5_FAIL);
+
+  // Open dataspace
+  const hid_t dataspace = H5Dget_space(dset_id);
+  assert(dataspace != HDF5_FAIL);
+
+  // Get shape of data set
+  const int rank = H5Sget_simple_extent_ndims(dataspace);
+  assert(rank >= 1);
+  std::vector<hsize_t> shape(rank);
+  const int ndims = H5Sget_simple_extent_dims(dataspace, shape.data(), nullptr);
+  assert(ndims == rank);
+
+  // Coalesce rows into ranges [r0, r1). Rows separated by a gap of at
+  // most max_gap rows go in the same range (the gap rows are read and
+  // discarded), so that scattered rows do not need one hyperslab each.
+  constexpr std::int64_t max_gap = 1024;
+  std::vector<std::array<std::int64_t, 2>> ranges;
+  for (std::int64_t r : rows)
+  {
+    assert(r < (std::int64_t)shape[0]);
+    if (!ranges.empty() and r - ranges.back()[1] <= max_gap)
+      ranges.back()[1] = r + 1;
+    else
+      ranges.push_back({r, r + 1});
+  }
+
+  // Select union of hyperslabs, one for each range
+  herr_t status = H5Sselect_none(dataspace);
+  assert(status != HDF5_FAIL);
+  std::vector<hsize_t> offset(rank, 0);
+  std::vector<hsize_t> count = shape;
+  std::int64_t num_read = 0;
+  for (const std::array<std::int64_t, 2>& range : ranges)
+  {
+    offset[0] = range[0];
+    count[0] = range[1] - range[0];
+    status = H5Sselect_hyperslab(dataspace, H5S_SELECT_OR, offset.data(),
+                                 nullptr, count.data(), nullptr);
+    assert(status != HDF5_FAIL);
+    num_read += count[0];
+  }
+
+  // Create a memory dataspace
+  count[0] = num_read;
+  const hid_t memspace = H5Screate_simple(rank, count.data(), nullptr);
+  assert(memspace != HDF5_FAIL);
+  if (rows.empty())
+  {
+    status = H5Sselect_none(memspace);
+    assert(status != HDF5_FAIL);
+  }
+
+  // Create local data to read into
+  std::size_t row_size = 1;
+  for (std::size_t i = 1; i < count.size(); ++i)
+    row_size *= count[i];
+  std::vector<T> buffer(num_read * row_size);
+
   // Read data on each process
   const hid_t h5type = hdf5_type<T>();
   status
-      = H5Dread(dset_id, h5type, memspace, dataspace, H5P_DEFAULT, data.data());
+      = H5Dread(dset_id, h5type, memspace, dataspace, dxpl_id, buffer.data());
   assert(status != HDF5_FAIL);
 
   // Close dataspace
@@ -407,6 +688,23 @@ HDF5Interface::read_dataset(const hid_t file_handle,
   status = H5Dclose(dset_id);
   assert(status != HDF5_FAIL);
 
+  if (num_read == (std::int64_t)rows.size())
+    return buffer;
+
+  // Extract requested rows
+  std::vector<T> data(rows.size() * row_size);
+  std::size_t i = 0;
+  std::int64_t pos = 0;
+  for (const std::array<std::int64_t, 2>& range : ranges)
+  {
+    for (; i < rows.size() and rows[i] < range[1]; ++i)
+    {
+      auto src = buffer.begin() + (pos + rows[i] - range[0]) * row_size;
+      std::copy(src, src + row_size, data.begin() + i * row_size);
+    }
+    pos += range[1] - range[0];
+  }
+
   return data;
 }
 //---------------------------------------------------------------------------
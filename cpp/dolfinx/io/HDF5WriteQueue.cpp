@@ -0,0 +1,156 @@
+// Copyright (C) 2020 agent
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "HDF5WriteQueue.h"
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/log.h>
+
+using namespace dolfinx;
+using namespace dolfinx::io;
+
+//-----------------------------------------------------------------------------
+HDF5WriteQueue::HDF5WriteQueue(hid_t h5_id, hid_t dxpl_id,
+                               std::size_t max_staged_bytes)
+    : _h5_id(h5_id), _dxpl_id(dxpl_id),
+      _filename(HDF5Interface::get_filename(h5_id)),
+      _max_staged_bytes(max_staged_bytes),
+      _thread(&HDF5WriteQueue::run, this)
+{
+  // Do nothing
+}
+//-----------------------------------------------------------------------------
+HDF5WriteQueue::~HDF5WriteQueue()
+{
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cv_done.wait(lock, [this] { return _tasks.empty() and !_busy; });
+    _stop = true;
+  }
+  _cv_task.notify_all();
+  _thread.join();
+
+  if (_error)
+    LOG(ERROR) << "Asynchronous HDF5 write failed and error was not handled.";
+}
+//-----------------------------------------------------------------------------
+bool HDF5WriteQueue::supported(MPI_Comm comm)
+{
+  // HDF5 is called from the I/O thread while the calling thread may
+  // also call it
+  hbool_t threadsafe = 0;
+  if (H5is_library_threadsafe(&threadsafe) < 0 or !threadsafe)
+  {
+    LOG(WARNING) << "HDF5 library is not threadsafe. HDF5 writes will be "
+                    "synchronous.";
+    return false;
+  }
+
+  if (dolfinx::MPI::size(comm) > 1)
+  {
+    // Collective MPI-IO calls are made from the I/O thread
+    int provided = MPI_THREAD_SINGLE;
+    MPI_Query_thread(&provided);
+    if (provided < MPI_THREAD_MULTIPLE)
+    {
+      LOG(WARNING) << "MPI has not been initialised with "
+                      "MPI_THREAD_MULTIPLE. HDF5 writes will be synchronous.";
+      return false;
+    }
+  }
+
+  return true;
+}
+//-----------------------------------------------------------------------------
+void HDF5WriteQueue::flush(std::function<void()> f)
+{
+  auto task = [h5_id = _h5_id, f = std::move(f)]() {
+    HDF5Interface::flush_file(h5_id);
+    if (f)
+      f();
+  };
+  push(std::move(task), 0);
+}
+//-----------------------------------------------------------------------------
+void HDF5WriteQueue::wait()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  _cv_done.wait(lock, [this] { return _tasks.empty() and !_busy; });
+  if (_error)
+  {
+    std::exception_ptr error = _error;
+    _error = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+//-----------------------------------------------------------------------------
+std::size_t HDF5WriteQueue::staged_bytes() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _staged_bytes;
+}
+//-----------------------------------------------------------------------------
+void HDF5WriteQueue::push(std::function<void()> task, std::size_t num_bytes)
+{
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    // Wait for staged data to be flushed if bound would be exceeded. A
+    // write larger than the bound is accepted once the queue is empty.
+    if (_max_staged_bytes > 0)
+    {
+      _cv_done.wait(lock, [this, num_bytes] {
+        return _staged_bytes == 0
+               or _staged_bytes + num_bytes <= _max_staged_bytes;
+      });
+    }
+
+    _tasks.emplace_back(std::move(task), num_bytes);
+    _staged_bytes += num_bytes;
+  }
+  _cv_task.notify_one();
+}
+//-----------------------------------------------------------------------------
+void HDF5WriteQueue::run()
+{
+  while (true)
+  {
+    std::pair<std::function<void()>, std::size_t> task;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _cv_task.wait(lock, [this] { return _stop or !_tasks.empty(); });
+      if (_tasks.empty())
+        return;
+
+      task = std::move(_tasks.front());
+      _tasks.pop_front();
+      _busy = true;
+    }
+
+    // Write data (without holding the lock)
+    std::exception_ptr error;
+    try
+    {
+      task.first();
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+
+    // Release staged data
+    task.first = nullptr;
+
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _busy = false;
+      _staged_bytes -= task.second;
+      if (error and !_error)
+        _error = error;
+    }
+    _cv_done.notify_all();
+  }
+}
+//-----------------------------------------------------------------------------
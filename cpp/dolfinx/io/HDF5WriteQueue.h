@@ -0,0 +1,164 @@
+// Copyright (C) 2020 agent
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include "HDF5Interface.h"
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dolfinx::io
+{
+
+/// Queue of HDF5 dataset writes that are drained to file by a
+/// background I/O thread.
+///
+/// Data passed to write_dataset() is copied into a staging buffer
+/// owned by the queue and the call returns immediately, so the caller
+/// can continue (e.g. with the next time step) while the data is
+/// flushed to disk. All HDF5 calls for the file are made from the I/O
+/// thread while the queue is alive, and writes are performed in the
+/// order in which they were queued. Since the order is the same on all
+/// processes, collective (MPI-IO) writes match up across processes.
+///
+/// Since HDF5 is called from the I/O thread and the calling thread,
+/// the HDF5 library must be threadsafe. Collective writes from the I/O
+/// thread also require MPI to have been initialised with
+/// MPI_THREAD_MULTIPLE. Use supported() to check both.
+
+class HDF5WriteQueue
+{
+public:
+  /// Create write queue for an open HDF5 file
+  /// @param[in] h5_id HDF5 file handle
+  /// @param[in] dxpl_id Data transfer property list of the file (see
+  ///   HDF5Interface::create_transfer_properties). It is owned by the
+  ///   caller and must outlive the queue.
+  /// @param[in] max_staged_bytes Upper bound on the size of the data
+  ///   staged in the queue. If a write would exceed the bound, the
+  ///   caller blocks until enough data has been flushed. A value of
+  ///   zero means no bound.
+  HDF5WriteQueue(hid_t h5_id, hid_t dxpl_id,
+                 std::size_t max_staged_bytes = 0);
+
+  /// Copy constructor
+  HDF5WriteQueue(const HDF5WriteQueue& queue) = delete;
+
+  /// Assignment operator
+  HDF5WriteQueue& operator=(const HDF5WriteQueue& queue) = delete;
+
+  /// Destructor. Blocks until all queued data has been written.
+  ~HDF5WriteQueue();
+
+  /// Check if asynchronous writes are possible, i.e. the HDF5 library
+  /// is threadsafe and, in parallel, MPI provides MPI_THREAD_MULTIPLE.
+  /// A warning is logged if they are not.
+  /// @param[in] comm The communicator of the file
+  /// @return True if a write queue can be used
+  static bool supported(MPI_Comm comm);
+
+  /// Name of the HDF5 file. This is cached on construction so that it
+  /// can be queried without calling into HDF5 while writes are
+  /// pending.
+  const std::string& filename() const { return _filename; }
+
+  /// Queue data for writing to the dataset dataset_path. Arguments are
+  /// as for HDF5Interface::write_dataset, except that the data is
+  /// passed by value and owned by the queue.
+  template <typename T>
+  void write_dataset(const std::string& dataset_path, std::vector<T> data,
+                     const std::array<std::int64_t, 2>& range,
+                     const std::vector<std::int64_t>& global_size,
+                     bool use_mpi_io, bool use_chunking,
+                     const HDF5Policy& policy = HDF5Policy())
+  {
+    const std::size_t num_bytes = data.size() * sizeof(T);
+    auto task = [h5_id = _h5_id, dxpl_id = _dxpl_id, dataset_path,
+                 data = std::move(data), range, global_size, use_mpi_io,
+                 use_chunking, policy]() {
+      HDF5Interface::write_dataset(h5_id, dataset_path, data.data(), range,
+                                   global_size, use_mpi_io, use_chunking,
+                                   policy, dxpl_id);
+    };
+    push(std::move(task), num_bytes);
+  }
+
+  /// Queue adding an attribute to the dataset or group dataset_path,
+  /// e.g. to describe a dataset queued before. Arguments are as for
+  /// HDF5Interface::add_attribute, except that the value is passed by
+  /// value and owned by the queue.
+  template <typename T>
+  void add_attribute(const std::string& dataset_path,
+                     const std::string& attribute_name, T attribute_value)
+  {
+    auto task = [h5_id = _h5_id, dataset_path, attribute_name,
+                 value = std::move(attribute_value)]() {
+      HDF5Interface::add_attribute(h5_id, dataset_path, attribute_name, value);
+    };
+    push(std::move(task), 0);
+  }
+
+  /// Queue a flush of the file to disk followed by a call to f, e.g.
+  /// to save metadata that refers to the data queued before. The flush
+  /// is collective, so this must be called on all processes of the
+  /// file.
+  /// @param[in] f Function to call after the flush (may be empty)
+  void flush(std::function<void()> f = nullptr);
+
+  /// Block until all queued writes have been completed. If a write on
+  /// the I/O thread failed, the exception is re-thrown here.
+  void wait();
+
+  /// Number of bytes currently staged in the queue
+  std::size_t staged_bytes() const;
+
+private:
+  // Add task to queue
+  void push(std::function<void()> task, std::size_t num_bytes);
+
+  // Main loop of the I/O thread
+  void run();
+
+  // HDF5 file handle, transfer property list and cached filename
+  hid_t _h5_id;
+  hid_t _dxpl_id;
+  std::string _filename;
+
+  // Bound on staged data (bytes)
+  std::size_t _max_staged_bytes;
+
+  // Queued writes and their sizes (bytes)
+  std::deque<std::pair<std::function<void()>, std::size_t>> _tasks;
+
+  // Number of bytes in queued or in-progress writes
+  std::size_t _staged_bytes = 0;
+
+  // True while the I/O thread is executing a write
+  bool _busy = false;
+
+  // Set to stop the I/O thread
+  bool _stop = false;
+
+  // First error raised on the I/O thread
+  std::exception_ptr _error;
+
+  mutable std::mutex _mutex;
+  std::condition_variable _cv_task, _cv_done;
+
+  // I/O thread (declared last so that it is started after all other
+  // members have been initialised)
+  std::thread _thread;
+};
+
+} // namespace dolfinx::io
@@ -6,6 +6,7 @@
 
 #include "XDMFFile.h"
 #include "HDF5File.h"
+#include "HDF5WriteQueue.h"
 #include "cells.h"
 #include "pugixml.hpp"
 #include "xdmf_function.h"
@@ -22,15 +23,37 @@
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshTags.h>
 #include <dolfinx/mesh/utils.h>
+#include <fstream>
+#include <sstream>
 
 using namespace dolfinx;
 using namespace dolfinx::io;
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// Get the Grid node with the given name under the node at xpath
+pugi::xml_node get_grid_node(const pugi::xml_document& xml_doc,
+                             const std::string& name, const std::string& xpath)
+{
+  pugi::xml_node node = xml_doc.select_node(xpath.c_str()).node();
+  if (!node)
+    throw std::runtime_error("XML node '" + xpath + "' not found.");
+  pugi::xml_node grid_node
+      = node.select_node(("Grid[@Name='" + name + "']").c_str()).node();
+  if (!grid_node)
+    throw std::runtime_error("<Grid> with name '" + name + "' not found.");
+  return grid_node;
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
 //-----------------------------------------------------------------------------
 XDMFFile::XDMFFile(MPI_Comm comm, const std::string filename,
-                   const std::string file_mode, const Encoding encoding)
+                   const std::string file_mode, const Encoding encoding,
+                   const HDF5Policy& policy)
     : _mpi_comm(comm), _filename(filename), _file_mode(file_mode),
-      _xml_doc(new pugi::xml_document), _encoding(encoding)
+      _policy(policy), _xml_doc(new pugi::xml_document), _encoding(encoding)
 {
   // Handle HDF5 and XDMF files with the file mode. At the end of this
   // we will have _hdf5_file and _xml_doc both pointing to a valid and
@@ -45,9 +68,10 @@ XDMFFile::XDMFFile(MPI_Comm comm, const std::string filename,
     const std::string hdf5_filename = xdmf_utils::get_hdf5_filename(_filename);
     const bool mpi_io = MPI::size(_mpi_comm.comm()) > 1 ? true : false;
     _h5_id = HDF5Interface::open_file(_mpi_comm.comm(), hdf5_filename,
-                                      file_mode, mpi_io);
+                                      file_mode, mpi_io, _policy);
     assert(_h5_id > 0);
     LOG(INFO) << "Opened HDF5 file with id \"" << _h5_id << "\"";
+    _dxpl_id = HDF5Interface::create_transfer_properties(mpi_io, _policy);
   }
   else
   {
@@ -119,11 +143,75 @@ XDMFFile::~XDMFFile() { close(); }
 //-----------------------------------------------------------------------------
 void XDMFFile::close()
 {
+  // Flush pending asynchronous writes before closing the file
+  if (_write_queue)
+  {
+    _write_queue->wait();
+    _write_queue.reset();
+  }
+
+  HDF5Interface::close_transfer_properties(_dxpl_id);
+  _dxpl_id = H5P_DEFAULT;
   if (_h5_id > 0)
     HDF5Interface::close_file(_h5_id);
   _h5_id = -1;
 }
 //-----------------------------------------------------------------------------
+void XDMFFile::set_asynchronous(bool enable, std::size_t max_staged_bytes)
+{
+  // Flush and stop any existing queue
+  if (_write_queue)
+  {
+    _write_queue->wait();
+    _write_queue.reset();
+  }
+
+  if (!enable or _h5_id < 0)
+    return;
+
+  if (!HDF5WriteQueue::supported(_mpi_comm.comm()))
+    return;
+
+  _write_queue = std::make_unique<HDF5WriteQueue>(_h5_id, _dxpl_id,
+                                                  max_staged_bytes);
+}
+//-----------------------------------------------------------------------------
+void XDMFFile::wait()
+{
+  if (_write_queue)
+    _write_queue->wait();
+}
+//-----------------------------------------------------------------------------
+bool XDMFFile::asynchronous() const { return _write_queue != nullptr; }
+//-----------------------------------------------------------------------------
+void XDMFFile::save_xml()
+{
+  const bool root = MPI::rank(_mpi_comm.comm()) == 0;
+  if (!_write_queue)
+  {
+    if (root)
+      _xml_doc->save_file(_filename.c_str(), "  ");
+    return;
+  }
+
+  // The XML refers to datasets that may still be queued. Save a
+  // snapshot of it after they have been written and flushed, so that
+  // the XML file never refers to missing or partly written data.
+  std::function<void()> save;
+  if (root)
+  {
+    std::ostringstream xml;
+    _xml_doc->save(xml, "  ");
+    save = [filename = _filename, xml = xml.str()]() {
+      std::ofstream file(filename);
+      file << xml;
+      if (!file)
+        throw std::runtime_error("Failed to save XDMF file " + filename);
+    };
+  }
+  _write_queue->flush(std::move(save));
+}
+//-----------------------------------------------------------------------------
 void XDMFFile::write_mesh(const mesh::Mesh& mesh, const std::string xpath)
 {
   pugi::xml_node node = _xml_doc->select_node(xpath.c_str()).node();
@@ -131,11 +219,11 @@ void XDMFFile::write_mesh(const mesh::Mesh& mesh, const std::string xpath)
     throw std::runtime_error("XML node '" + xpath + "' not found.");
 
   // Add the mesh Grid to the domain
-  xdmf_mesh::add_mesh(_mpi_comm.comm(), node, _h5_id, mesh, mesh.name);
+  xdmf_mesh::add_mesh(_mpi_comm.comm(), node, _h5_id, mesh, mesh.name,
+                      _policy, _dxpl_id, _write_queue.get());
 
   // Save XML file (on process 0 only)
-  if (MPI::rank(_mpi_comm.comm()) == 0)
-    _xml_doc->save_file(_filename.c_str(), "  ");
+  save_xml();
 }
 //-----------------------------------------------------------------------------
 void XDMFFile::write_geometry(const mesh::Geometry& geometry,
@@ -153,24 +241,48 @@ void XDMFFile::write_geometry(const mesh::Geometry& geometry,
 
   const std::string path_prefix = "/Geometry/" + name;
   xdmf_mesh::add_geometry_data(_mpi_comm.comm(), grid_node, _h5_id, path_prefix,
-                               geometry);
+                               geometry, _policy, _dxpl_id,
+                               _write_queue.get());
 
   // Save XML file (on process 0 only)
-  if (MPI::rank(_mpi_comm.comm()) == 0)
-    _xml_doc->save_file(_filename.c_str(), "  ");
+  save_xml();
 }
 //-----------------------------------------------------------------------------
 mesh::Mesh XDMFFile::read_mesh(const fem::CoordinateElement& element,
-                               const std::string name,
+                               mesh::GhostMode mode, const std::string name,
                                const std::string xpath) const
 {
+  // If the mesh was written with a partition for this number of
+  // processes, read each process's own cells and geometry nodes and
+  // skip repartitioning
+  if (_h5_id >= 0)
+  {
+    pugi::xml_node grid_node = get_grid_node(*_xml_doc, name, xpath);
+
+    // Data may be pending on the I/O thread
+    if (_write_queue)
+      _write_queue->wait();
+
+    if (xdmf_mesh::has_partition(_mpi_comm.comm(), _h5_id, grid_node))
+    {
+      auto [cell_type, cells, original_cell_index, ghost_owners, nodes, x]
+          = xdmf_mesh::read_partitioned_mesh_data(
+              _mpi_comm.comm(), _h5_id, _dxpl_id, grid_node, mode);
+      mesh::Mesh mesh
+          = mesh::create(_mpi_comm.comm(), cells, original_cell_index,
+                         ghost_owners, element, nodes, x, mode);
+      mesh.name = name;
+      return mesh;
+    }
+  }
+
   // Read mesh data
   auto [cell_type, x, cells] = XDMFFile::read_mesh_data(name, xpath);
 
   // Create mesh
   graph::AdjacencyList<std::int64_t> cells_adj(cells);
-  mesh::Mesh mesh = mesh::create(_mpi_comm.comm(), cells_adj, element, x,
-                                 mesh::GhostMode::none);
+  mesh::Mesh mesh
+      = mesh::create(_mpi_comm.comm(), cells_adj, element, x, mode);
   mesh.name = name;
   return mesh;
 }
@@ -181,18 +293,37 @@ std::tuple<
     Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
 XDMFFile::read_mesh_data(const std::string name, const std::string xpath) const
 {
-  pugi::xml_node node = _xml_doc->select_node(xpath.c_str()).node();
-  if (!node)
-    throw std::runtime_error("XML node '" + xpath + "' not found.");
+  pugi::xml_node grid_node = get_grid_node(*_xml_doc, name, xpath);
 
-  pugi::xml_node grid_node
-      = node.select_node(("Grid[@Name='" + name + "']").c_str()).node();
-  if (!grid_node)
-    throw std::runtime_error("<Grid> with name '" + name + "' not found.");
+  // Data may be pending on the I/O thread
+  if (_write_queue)
+    _write_queue->wait();
 
   return xdmf_mesh::read_mesh_data(_mpi_comm.comm(), _h5_id, grid_node);
 }
 //-----------------------------------------------------------------------------
+std::pair<mesh::CellType, int>
+XDMFFile::read_cell_type(const std::string name, const std::string xpath) const
+{
+  pugi::xml_node grid_node = get_grid_node(*_xml_doc, name, xpath);
+  pugi::xml_node topology_node = grid_node.child("Topology");
+  if (!topology_node)
+    throw std::runtime_error("<Topology> not found in <Grid> '" + name + "'.");
+  const std::pair<std::string, int> cell_type
+      = xdmf_utils::get_cell_type(topology_node);
+  return {mesh::to_type(cell_type.first), cell_type.second};
+}
+//-----------------------------------------------------------------------------
+int XDMFFile::read_geometry_dim(const std::string name,
+                                const std::string xpath) const
+{
+  pugi::xml_node grid_node = get_grid_node(*_xml_doc, name, xpath);
+  pugi::xml_node geometry_node = grid_node.child("Geometry");
+  if (!geometry_node)
+    throw std::runtime_error("<Geometry> not found in <Grid> '" + name + "'.");
+  return xdmf_utils::get_geometry_dim(geometry_node);
+}
+//-----------------------------------------------------------------------------
 void XDMFFile::write_function(const function::Function& function,
                               const double t, const std::string mesh_xpath)
 {
@@ -236,11 +367,11 @@ void XDMFFile::write_function(const function::Function& function,
   assert(time_node);
 
   // Add the mesh Grid to the domain
-  xdmf_function::add_function(_mpi_comm.comm(), function, t, grid_node, _h5_id);
+  xdmf_function::add_function(_mpi_comm.comm(), function, t, grid_node, _h5_id,
+                              _policy, _dxpl_id, _write_queue.get());
 
   // Save XML file (on process 0 only)
-  if (MPI::rank(_mpi_comm.comm()) == 0)
-    _xml_doc->save_file(_filename.c_str(), "  ");
+  save_xml();
 }
 //-----------------------------------------------------------------------------
 void XDMFFile::write_meshtags(const mesh::MeshTags<std::int32_t>& meshtags,
@@ -261,24 +392,22 @@ void XDMFFile::write_meshtags(const mesh::MeshTags<std::int32_t>& meshtags,
   geo_ref_node.append_attribute("xpointer") = geo_ref_path.c_str();
   assert(geo_ref_node);
   xdmf_meshtags::add_meshtags(_mpi_comm.comm(), meshtags, grid_node, _h5_id,
-                              meshtags.name);
+                              meshtags.name, _policy, _dxpl_id,
+                              _write_queue.get());
 
   // Save XML file (on process 0 only)
-  if (MPI::rank(_mpi_comm.comm()) == 0)
-    _xml_doc->save_file(_filename.c_str(), "  ");
+  save_xml();
 }
 //-----------------------------------------------------------------------------
 mesh::MeshTags<std::int32_t>
 XDMFFile::read_meshtags(const std::shared_ptr<const mesh::Mesh>& mesh,
                         const std::string name, const std::string xpath)
 {
-  pugi::xml_node node = _xml_doc->select_node(xpath.c_str()).node();
-  if (!node)
-    throw std::runtime_error("XML node '" + xpath + "' not found.");
-  pugi::xml_node grid_node
-      = node.select_node(("Grid[@Name='" + name + "']").c_str()).node();
-  if (!grid_node)
-    throw std::runtime_error("<Grid> with name '" + name + "' not found.");
+  pugi::xml_node grid_node = get_grid_node(*_xml_doc, name, xpath);
+
+  // Data may be pending on the I/O thread
+  if (_write_queue)
+    _write_queue->wait();
 
   pugi::xml_node topology_node = grid_node.child("Topology");
 
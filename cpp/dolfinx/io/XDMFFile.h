@@ -34,6 +34,7 @@ namespace mesh
 {
 class Mesh;
 class Geometry;
+enum class GhostMode : int;
 template <typename T>
 class MeshTags;
 } // namespace mesh
@@ -41,6 +42,7 @@ class MeshTags;
 namespace io
 {
 class HDF5File;
+class HDF5WriteQueue;
 
 /// Read and write mesh::Mesh, function::Function and other objects in
 /// XDMF.
@@ -67,9 +69,16 @@ public:
   static const Encoding default_encoding = Encoding::HDF5;
 
   /// Constructor
+  /// @param[in] comm MPI communicator
+  /// @param[in] filename Name of the XDMF file
+  /// @param[in] file_mode "r" (read), "w" (write) or "a" (append)
+  /// @param[in] encoding Encoding of heavy data
+  /// @param[in] policy Parameters for the HDF5 file (file access and
+  ///   data transfer)
   XDMFFile(MPI_Comm comm, const std::string filename,
            const std::string file_mode,
-           const Encoding encoding = default_encoding);
+           const Encoding encoding = default_encoding,
+           const HDF5Policy& policy = HDF5Policy());
 
   /// Destructor
   ~XDMFFile();
@@ -81,6 +90,27 @@ public:
   /// no effect.
   void close();
 
+  /// Enable or disable asynchronous output. When enabled, the write_*
+  /// functions update the XML document and copy HDF5 data into a
+  /// staging buffer, and then return. The staged data is written to
+  /// the HDF5 file by a background I/O thread. This requires a
+  /// threadsafe HDF5 library and, in parallel, MPI to have been
+  /// initialised with MPI_THREAD_MULTIPLE, otherwise output remains
+  /// synchronous. Has no effect for ASCII encoding.
+  /// @param[in] enable True to enable asynchronous output
+  /// @param[in] max_staged_bytes Bound on the size of staged data. A
+  ///   write blocks if the bound would be exceeded. Zero means no bound.
+  void set_asynchronous(bool enable, std::size_t max_staged_bytes = 0);
+
+  /// Block until all pending asynchronous writes have been written to
+  /// the HDF5 file. Does nothing if output is synchronous.
+  void wait();
+
+  /// Check if output is asynchronous
+  /// @return True if asynchronous output has been enabled and is
+  ///   supported
+  bool asynchronous() const;
+
   /// Save Mesh
   /// @param[in] mesh
   /// @param[in] xpath XPath where Mesh Grid will be written
@@ -95,14 +125,19 @@ public:
                       const std::string name = "geometry",
                       const std::string xpath = "/Xdmf/Domain");
 
-  /// Read in Mesh
+  /// Read in Mesh. If the mesh was written by write_mesh on the same
+  /// number of processes (HDF5 encoding), the stored partition is
+  /// used: each process reads only its own cells and the geometry
+  /// nodes they reference, and the mesh is not repartitioned.
+  /// Otherwise the mesh is partitioned and distributed.
   /// @param[in] element Element that describes the geometry of a cell
+  /// @param[in] mode The ghost mode of the mesh
   /// @param[in] name
   /// @param[in] xpath XPath where Mesh Grid is located
   /// @return A Mesh distributed on the same communicator as the
   ///   XDMFFile
   mesh::Mesh read_mesh(const fem::CoordinateElement& element,
-                       const std::string name,
+                       mesh::GhostMode mode, const std::string name,
                        const std::string xpath = "/Xdmf/Domain") const;
 
   /// Read in the data for Mesh
@@ -118,6 +153,22 @@ public:
   read_mesh_data(const std::string name = "mesh",
                  const std::string xpath = "/Xdmf/Domain") const;
 
+  /// Read the cell type of a Mesh (without reading mesh data)
+  /// @param[in] name Name of the Mesh Grid
+  /// @param[in] xpath XPath where Mesh Grid is located
+  /// @return (Cell type, degree)
+  std::pair<mesh::CellType, int>
+  read_cell_type(const std::string name = "mesh",
+                 const std::string xpath = "/Xdmf/Domain") const;
+
+  /// Read the geometric dimension of a Mesh (without reading mesh
+  /// data)
+  /// @param[in] name Name of the Mesh Grid
+  /// @param[in] xpath XPath where Mesh Grid is located
+  /// @return The geometric dimension
+  int read_geometry_dim(const std::string name = "mesh",
+                        const std::string xpath = "/Xdmf/Domain") const;
+
   /// Write Function
   /// @param[in] function
   /// @param[in] t Time
@@ -151,6 +202,10 @@ public:
   MPI_Comm comm() const;
 
 private:
+  // Save the XML document (on process 0). With asynchronous writes, the
+  // document is saved once the data queued before has been written.
+  void save_xml();
+
   // MPI communicator
   dolfinx::MPI::Comm _mpi_comm;
 
@@ -163,6 +218,16 @@ private:
   // HDF5 file handle
   hid_t _h5_id;
 
+  // HDF5 data transfer property list (H5P_DEFAULT if the file is not
+  // opened with MPI-IO)
+  hid_t _dxpl_id = H5P_DEFAULT;
+
+  // HDF5 I/O parameters
+  HDF5Policy _policy;
+
+  // Queue for asynchronous HDF5 writes (null if output is synchronous)
+  std::unique_ptr<HDF5WriteQueue> _write_queue;
+
   // The XML document currently representing the XDMF which needs to be
   // kept open for time series etc.
   std::unique_ptr<pugi::xml_document> _xml_doc;
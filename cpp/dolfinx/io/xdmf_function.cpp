@@ -75,7 +75,9 @@ int get_padded_width(const function::Function& u)
 //-----------------------------------------------------------------------------
 void xdmf_function::add_function(MPI_Comm comm, const function::Function& u,
                                  const double t, pugi::xml_node& xml_node,
-                                 const hid_t h5_id)
+                                 const hid_t h5_id, const HDF5Policy& policy,
+                                 const hid_t dxpl_id,
+                                 HDF5WriteQueue* write_queue)
 {
   LOG(INFO) << "Adding function to node \"" << xml_node.path('/') << "\"";
 
@@ -155,13 +157,15 @@ void xdmf_function::add_function(MPI_Comm comm, const function::Function& u,
         comm, component_data_values.size() / width, true);
     xdmf_utils::add_data_item(attribute_node, h5_id, dataset_name,
                               component_data_values, offset,
-                              {num_values, width}, "", use_mpi_io);
+                              {num_values, width}, "", use_mpi_io, policy,
+                              dxpl_id, write_queue);
 #else
     // Add data item
     const std::int64_t offset
         = dolfinx::MPI::global_offset(comm, data_values.size() / width, true);
     xdmf_utils::add_data_item(attribute_node, h5_id, dataset_name, data_values,
-                              offset, {num_values, width}, "", use_mpi_io);
+                              offset, {num_values, width}, "", use_mpi_io,
+                              policy, dxpl_id, write_queue);
 #endif
   }
 }
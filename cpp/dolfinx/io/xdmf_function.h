@@ -23,13 +23,18 @@ class Function;
 
 namespace io
 {
+class HDF5WriteQueue;
+struct HDF5Policy;
+
 /// Low-level methods for reading/writing XDMF files
 namespace xdmf_function
 {
 
 /// TODO
 void add_function(MPI_Comm comm, const function::Function& u, const double t,
-                  pugi::xml_node& xml_node, const hid_t h5_id);
+                  pugi::xml_node& xml_node, const hid_t h5_id,
+                  const HDF5Policy& policy, const hid_t dxpl_id,
+                  HDF5WriteQueue* write_queue = nullptr);
 
 } // namespace xdmf_function
 } // namespace io
@@ -10,16 +10,38 @@
 #include "xdmf_read.h"
 #include "xdmf_utils.h"
 #include <dolfinx/fem/ElementDofLayout.h>
+#include <dolfinx/graph/Partitioning.h>
+#include <dolfinx/mesh/GraphBuilder.h>
+#include <dolfinx/mesh/Mesh.h>
 
 using namespace dolfinx;
 using namespace dolfinx::io;
 
+namespace
+{
+//-----------------------------------------------------------------------------
+// Get the HDF5 path of the topology dataset of a Grid node (empty if
+// the topology is not stored in HDF5)
+std::string get_topology_path(const pugi::xml_node& grid_node)
+{
+  pugi::xml_node data_node = grid_node.child("Topology").child("DataItem");
+  if (!data_node)
+    return std::string();
+  pugi::xml_attribute format_attr = data_node.attribute("Format");
+  if (!format_attr or std::string(format_attr.as_string()) != "HDF")
+    return std::string();
+  return xdmf_utils::get_hdf5_paths(data_node)[1];
+}
+//-----------------------------------------------------------------------------
+} // namespace
+
 //-----------------------------------------------------------------------------
 void xdmf_mesh::add_topology_data(
     MPI_Comm comm, pugi::xml_node& xml_node, const hid_t h5_id,
     const std::string path_prefix, const mesh::Topology& topology,
     const mesh::Geometry& geometry, const int dim,
-    const std::vector<std::int32_t>& active_entities)
+    const std::vector<std::int32_t>& active_entities,
+    const HDF5Policy& policy, const hid_t dxpl_id, HDF5WriteQueue* write_queue)
 {
   LOG(INFO) << "Adding topology data to node \"" << xml_node.path('/') << "\"";
 
@@ -60,6 +82,7 @@ void xdmf_mesh::add_topology_data(
 
   if (dim == tdim)
   {
+    topology_data.reserve(active_entities.size() * num_nodes_per_entity);
     for (std::int32_t c : active_entities)
     {
       assert(c < cells_g.num_nodes());
@@ -81,42 +104,41 @@ void xdmf_mesh::add_topology_data(
     if (!e_to_v)
       throw std::runtime_error("Mesh is missing entitiy-vertex connectivity.");
 
-    auto e_to_c = topology.connectivity(dim, tdim);
-    if (!e_to_c)
-      throw std::runtime_error("Mesh is missing entitiy-cell connectivity.");
-
     auto c_to_v = topology.connectivity(tdim, 0);
     if (!c_to_v)
       throw std::runtime_error("Mesh is missing cell-vertex connectivity.");
 
+    // Build map from vertex (local index) to global geometry node index
+    // once, rather than searching the cell vertices for each entity
+    //
     // FIXME: This will not work for higher-order cells. Need to use
     // ElementDofLayout to loop over all nodes
-    for (std::int32_t e : active_entities)
+    auto map_v = topology.index_map(0);
+    assert(map_v);
+    std::vector<std::int64_t> vertex_to_node(map_v->size_local()
+                                             + map_v->num_ghosts());
+    for (int c = 0; c < c_to_v->num_nodes(); ++c)
     {
-      // Get first attached cell
-      std::int32_t c = e_to_c->links(e)[0];
-      auto cell_vertices = c_to_v->links(c);
+      auto vertices = c_to_v->links(c);
       auto nodes = cells_g.links(c);
-      auto vertices = e_to_v->links(e);
       for (int v = 0; v < vertices.rows(); ++v)
       {
-        const int v_index = perm[v];
-        const int vertex = vertices[v_index];
-        const auto* it
-            = std::find(cell_vertices.data(),
-                        cell_vertices.data() + cell_vertices.rows(), vertex);
-        assert(it != (cell_vertices.data() + cell_vertices.rows()));
-        const int local_cell_vertex = std::distance(cell_vertices.data(), it);
-
-        std::int64_t global_index = nodes[local_cell_vertex];
+        std::int64_t global_index = nodes[v];
         if (global_index < map_g->size_local())
           global_index += offset_g;
         else
           global_index = ghosts[global_index - map_g->size_local()];
-
-        topology_data.push_back(global_index);
+        vertex_to_node[vertices[v]] = global_index;
       }
     }
+
+    topology_data.reserve(active_entities.size() * num_nodes_per_entity);
+    for (std::int32_t e : active_entities)
+    {
+      auto vertices = e_to_v->links(e);
+      for (int v = 0; v < vertices.rows(); ++v)
+        topology_data.push_back(vertex_to_node[vertices[perm[v]]]);
+    }
   }
 
   assert(topology_data.size() % num_nodes_per_entity == 0);
@@ -140,13 +162,17 @@ void xdmf_mesh::add_topology_data(
 
   const bool use_mpi_io = (dolfinx::MPI::size(comm) > 1);
   xdmf_utils::add_data_item(topology_node, h5_id, h5_path, topology_data,
-                            offset, shape, number_type, use_mpi_io);
+                            offset, shape, number_type, use_mpi_io, policy,
+                            dxpl_id, write_queue);
 }
 //-----------------------------------------------------------------------------
 void xdmf_mesh::add_geometry_data(MPI_Comm comm, pugi::xml_node& xml_node,
                                   const hid_t h5_id,
                                   const std::string path_prefix,
-                                  const mesh::Geometry& geometry)
+                                  const mesh::Geometry& geometry,
+                                  const HDF5Policy& policy,
+                                  const hid_t dxpl_id,
+                                  HDF5WriteQueue* write_queue)
 {
 
   LOG(INFO) << "Adding geometry data to node \"" << xml_node.path('/') << "\"";
@@ -193,12 +219,13 @@ void xdmf_mesh::add_geometry_data(MPI_Comm comm, pugi::xml_node& xml_node,
       = dolfinx::MPI::global_offset(comm, num_points_local, true);
   const bool use_mpi_io = (dolfinx::MPI::size(comm) > 1);
   xdmf_utils::add_data_item(geometry_node, h5_id, h5_path, x, offset, shape, "",
-                            use_mpi_io);
+                            use_mpi_io, policy, dxpl_id, write_queue);
 }
 //----------------------------------------------------------------------------
 void xdmf_mesh::add_mesh(MPI_Comm comm, pugi::xml_node& xml_node,
                          const hid_t h5_id, const mesh::Mesh& mesh,
-                         const std::string name)
+                         const std::string name, const HDF5Policy& policy,
+                         const hid_t dxpl_id, HDF5WriteQueue* write_queue)
 {
   LOG(INFO) << "Adding mesh to node \"" << xml_node.path('/') << "\"";
 
@@ -221,10 +248,39 @@ void xdmf_mesh::add_mesh(MPI_Comm comm, pugi::xml_node& xml_node,
   std::iota(active_cells.begin(), active_cells.end(), 0);
 
   add_topology_data(comm, grid_node, h5_id, path_prefix, mesh.topology(),
-                    mesh.geometry(), tdim, active_cells);
+                    mesh.geometry(), tdim, active_cells, policy, dxpl_id,
+                    write_queue);
 
   // Add geometry node and attributes (including writing data)
-  add_geometry_data(comm, grid_node, h5_id, path_prefix, mesh.geometry());
+  add_geometry_data(comm, grid_node, h5_id, path_prefix, mesh.geometry(),
+                    policy, dxpl_id, write_queue);
+
+  // Store the offsets of the blocks of cells written by each process
+  // as an attribute of the topology dataset. Cells are written in
+  // blocks by process, so this allows the mesh to be read back on the
+  // same number of processes without repartitioning.
+  if (h5_id >= 0)
+  {
+    const std::int64_t num_cells_local = num_cells;
+    std::vector<std::int64_t> num_cells_process(dolfinx::MPI::size(comm));
+    MPI_Allgather(&num_cells_local, 1, MPI_INT64_T, num_cells_process.data(),
+                  1, MPI_INT64_T, comm);
+    std::vector<std::int64_t> partition(num_cells_process.size() + 1, 0);
+    std::partial_sum(num_cells_process.begin(), num_cells_process.end(),
+                     partition.begin() + 1);
+
+    const std::string topology_path = path_prefix + "/topology";
+    if (write_queue)
+    {
+      write_queue->add_attribute(topology_path, "partition",
+                                 std::move(partition));
+    }
+    else
+    {
+      HDF5Interface::add_attribute(h5_id, topology_path, "partition",
+                                   partition);
+    }
+  }
 }
 //----------------------------------------------------------------------------
 std::tuple<
@@ -250,21 +306,7 @@ xdmf_mesh::read_mesh_data(MPI_Comm comm, const hid_t h5_id,
   assert(geometry_node);
 
   // Determine geometric dimension
-  pugi::xml_attribute geometry_type_attr
-      = geometry_node.attribute("GeometryType");
-  assert(geometry_type_attr);
-  int gdim = -1;
-  const std::string geometry_type = geometry_type_attr.value();
-  if (geometry_type == "XY")
-    gdim = 2;
-  else if (geometry_type == "XYZ")
-    gdim = 3;
-  else
-  {
-    throw std::runtime_error(
-        "Cannot determine geometric dimension. GeometryType \"" + geometry_type
-        + "\" in XDMF file is unknown or unsupported");
-  }
+  const int gdim = xdmf_utils::get_geometry_dim(geometry_node);
 
   // Get number of points from Geometry dataitem node
   pugi::xml_node geometry_data_node = geometry_node.child("DataItem");
@@ -306,3 +348,178 @@ xdmf_mesh::read_mesh_data(MPI_Comm comm, const hid_t h5_id,
       {cell_type, cell_type_str.second}, std::move(points), std::move(cells1)};
 }
 //----------------------------------------------------------------------------
+bool xdmf_mesh::has_partition(MPI_Comm comm, const hid_t h5_id,
+                              const pugi::xml_node& node)
+{
+  if (h5_id < 0)
+    return false;
+
+  const std::string topology_path = get_topology_path(node);
+  if (topology_path.empty()
+      or !HDF5Interface::has_dataset(h5_id, topology_path)
+      or !HDF5Interface::has_attribute(h5_id, topology_path, "partition"))
+  {
+    return false;
+  }
+
+  const std::vector<std::int64_t> partition
+      = HDF5Interface::get_attribute<std::vector<std::int64_t>>(
+          h5_id, topology_path, "partition");
+  return (int)partition.size() == dolfinx::MPI::size(comm) + 1;
+}
+//----------------------------------------------------------------------------
+std::tuple<
+    std::pair<mesh::CellType, int>, graph::AdjacencyList<std::int64_t>,
+    std::vector<std::int64_t>, std::vector<int>, std::vector<std::int64_t>,
+    Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
+xdmf_mesh::read_partitioned_mesh_data(MPI_Comm comm, const hid_t h5_id,
+                                      const hid_t dxpl_id,
+                                      const pugi::xml_node& node,
+                                      mesh::GhostMode ghost_mode)
+{
+  assert(has_partition(comm, h5_id, node));
+  const int rank = dolfinx::MPI::rank(comm);
+
+  // Read offsets of the blocks of cells of each process and get the
+  // range of cells for this process
+  const std::string topology_path = get_topology_path(node);
+  const std::vector<std::int64_t> partition
+      = HDF5Interface::get_attribute<std::vector<std::int64_t>>(
+          h5_id, topology_path, "partition");
+  const std::array<std::int64_t, 2> cell_range
+      = {{partition[rank], partition[rank + 1]}};
+
+  // Get topology node and cell type
+  pugi::xml_node topology_node = node.child("Topology");
+  assert(topology_node);
+  const std::pair<std::string, int> cell_type_str
+      = xdmf_utils::get_cell_type(topology_node);
+  mesh::CellType cell_type = mesh::to_type(cell_type_str.first);
+
+  // Check that partition is consistent with the topology
+  pugi::xml_node topology_data_node = topology_node.child("DataItem");
+  assert(topology_data_node);
+  const std::vector<std::int64_t> tdims
+      = xdmf_utils::get_dataset_shape(topology_data_node);
+  assert(tdims.size() == 2);
+  const int npoint_per_cell = tdims[1];
+  if (partition.front() != 0 or partition.back() != tdims[0])
+  {
+    throw std::runtime_error("Stored mesh partition is inconsistent with "
+                             "number of cells in XDMF file");
+  }
+
+  // Read topology data for cells in range. The HDF5 storage may be a
+  // flat array.
+  std::array<std::int64_t, 2> range = cell_range;
+  if (HDF5Interface::dataset_rank(h5_id, topology_path) == 1)
+  {
+    range[0] *= npoint_per_cell;
+    range[1] *= npoint_per_cell;
+  }
+  const std::vector<std::int64_t> topology_data
+      = HDF5Interface::read_dataset<std::int64_t>(h5_id, topology_path, range,
+                                                  dxpl_id);
+  const int num_local_cells = topology_data.size() / npoint_per_cell;
+  assert(num_local_cells == cell_range[1] - cell_range[0]);
+  Eigen::Map<const Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic,
+                                Eigen::RowMajor>>
+      cells_vtk(topology_data.data(), num_local_cells, npoint_per_cell);
+
+  //  Permute cells from VTK to DOLFINX ordering
+  const Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic,
+                     Eigen::RowMajor>
+      cells_local = io::cells::permute_ordering(
+          cells_vtk, io::cells::vtk_to_dolfin(cell_type, cells_vtk.cols()));
+  graph::AdjacencyList<std::int64_t> cells(cells_local);
+
+  // Original index of each cell is its position in the file
+  std::vector<std::int64_t> original_cell_index(num_local_cells);
+  std::iota(original_cell_index.begin(), original_cell_index.end(),
+            cell_range[0]);
+  std::vector<int> ghost_owners;
+
+  if (ghost_mode != mesh::GhostMode::none)
+  {
+    // Compute the dual graph from the cell vertices (the first nodes of
+    // each cell). Cells are numbered globally in the order of the
+    // file, so the owner of a neighbouring cell follows from the
+    // partition.
+    const int num_vertices = mesh::num_cell_vertices(cell_type);
+    const Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic,
+                       Eigen::RowMajor>
+        cell_vertices = cells_local.leftCols(num_vertices);
+    const auto [dual_graph, graph_info]
+        = mesh::GraphBuilder::compute_dual_graph(comm, cell_vertices,
+                                                 cell_type);
+
+    // Send each cell to its owner (this process) and, as a ghost, to
+    // the owners of the cells that it shares a facet with
+    std::vector<std::int32_t> dest_data, dest_offsets = {0};
+    for (int c = 0; c < num_local_cells; ++c)
+    {
+      dest_data.push_back(rank);
+      for (std::int64_t neighbour : dual_graph[c])
+      {
+        const int owner
+            = std::upper_bound(partition.begin(), partition.end(), neighbour)
+              - partition.begin() - 1;
+        if (owner != rank)
+          dest_data.push_back(owner);
+      }
+      std::sort(dest_data.begin() + dest_offsets.back() + 1, dest_data.end());
+      dest_data.erase(std::unique(dest_data.begin() + dest_offsets.back() + 1,
+                                  dest_data.end()),
+                      dest_data.end());
+      dest_offsets.push_back(dest_data.size());
+    }
+    const graph::AdjacencyList<std::int32_t> dest(std::move(dest_data),
+                                                  std::move(dest_offsets));
+
+    // Owned cells stay on this process (in order), and ghost cells are
+    // appended
+    std::vector<int> src;
+    std::tie(cells, src, original_cell_index, ghost_owners)
+        = graph::Partitioning::distribute(comm, cells, dest);
+  }
+
+  // Build sorted list of nodes referenced by cells on this process
+  std::vector<std::int64_t> nodes(cells.array().data(),
+                                  cells.array().data() + cells.array().size());
+  std::sort(nodes.begin(), nodes.end());
+  nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+  // Read coordinates of these nodes only
+  pugi::xml_node geometry_node = node.child("Geometry");
+  assert(geometry_node);
+  const int gdim = xdmf_utils::get_geometry_dim(geometry_node);
+  pugi::xml_node geometry_data_node = geometry_node.child("DataItem");
+  assert(geometry_data_node);
+  const std::vector<std::int64_t> gdims
+      = xdmf_utils::get_dataset_shape(geometry_data_node);
+  assert(gdims.size() == 2);
+  assert(gdims[1] == gdim);
+  const std::string geometry_path
+      = xdmf_utils::get_hdf5_paths(geometry_data_node)[1];
+  if (HDF5Interface::dataset_rank(h5_id, geometry_path) != 2)
+  {
+    throw std::runtime_error(
+        "Reading mesh with stored partition requires a rank 2 geometry "
+        "dataset");
+  }
+  const std::vector<double> geometry_data
+      = HDF5Interface::read_dataset_rows<double>(h5_id, geometry_path, nodes,
+                                                 dxpl_id);
+  assert(geometry_data.size() == nodes.size() * gdim);
+  Eigen::Map<const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                                Eigen::RowMajor>>
+      x(geometry_data.data(), nodes.size(), gdim);
+
+  return {{cell_type, cell_type_str.second},
+          std::move(cells),
+          std::move(original_cell_index),
+          std::move(ghost_owners),
+          std::move(nodes),
+          x};
+}
+//----------------------------------------------------------------------------
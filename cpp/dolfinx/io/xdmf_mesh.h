@@ -7,6 +7,7 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/cell_types.h>
 #include <hdf5.h>
 #include <mpi.h>
@@ -27,8 +28,15 @@ namespace mesh
 class Geometry;
 class Mesh;
 class Topology;
+enum class GhostMode : int;
 } // namespace mesh
 
+namespace io
+{
+class HDF5WriteQueue;
+struct HDF5Policy;
+}
+
 /// Low-level methods for reading XDMF files
 namespace io::xdmf_mesh
 {
@@ -36,9 +44,16 @@ namespace io::xdmf_mesh
 /// Add Mesh to xml node
 ///
 /// Creates new Grid with Topology and Geometry xml nodes for mesh. In
-/// HDF file data is stored under path prefix.
+/// HDF file data is stored under path prefix, and the offsets of the
+/// blocks of cells written by each process are stored in the
+/// "partition" attribute of the topology dataset. Data is written with
+/// the transfer parameters of policy and the transfer property list
+/// dxpl_id of the file. If write_queue is not null, HDF5 data is
+/// written asynchronously through the queue.
 void add_mesh(MPI_Comm comm, pugi::xml_node& xml_node, const hid_t h5_id,
-              const mesh::Mesh& mesh, const std::string path_prefix);
+              const mesh::Mesh& mesh, const std::string path_prefix,
+              const HDF5Policy& policy, const hid_t dxpl_id,
+              HDF5WriteQueue* write_queue = nullptr);
 
 /// Add Topology xml node
 /// @param[in] comm
@@ -51,16 +66,23 @@ void add_mesh(MPI_Comm comm, pugi::xml_node& xml_node, const hid_t h5_id,
 /// @param[in] active_entities Local-to-process indices of mesh entities
 ///   whose topology will be saved. This is used to save subsets of
 ///   Mesh.
+/// @param[in] policy HDF5 data transfer parameters
+/// @param[in] dxpl_id HDF5 data transfer property list of the file
+/// @param[in] write_queue Queue for asynchronous writes (optional)
 void add_topology_data(MPI_Comm comm, pugi::xml_node& xml_node,
                        const hid_t h5_id, const std::string path_prefix,
                        const mesh::Topology& topology,
                        const mesh::Geometry& geometry, const int cell_dim,
-                       const std::vector<std::int32_t>& active_entities);
+                       const std::vector<std::int32_t>& active_entities,
+                       const HDF5Policy& policy, const hid_t dxpl_id,
+                       HDF5WriteQueue* write_queue = nullptr);
 
 /// Add Geometry xml node
 void add_geometry_data(MPI_Comm comm, pugi::xml_node& xml_node,
                        const hid_t h5_id, const std::string path_prefix,
-                       const mesh::Geometry& geometry);
+                       const mesh::Geometry& geometry,
+                       const HDF5Policy& policy, const hid_t dxpl_id,
+                       HDF5WriteQueue* write_queue = nullptr);
 
 /// Read Topology and Geometry arrays
 /// @returns ((cell type, degree), geometry, topology)
@@ -70,5 +92,34 @@ std::tuple<
     Eigen::Array<std::int64_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
 read_mesh_data(MPI_Comm comm, const hid_t h5_id, const pugi::xml_node& node);
 
+/// Check if the topology dataset of a Grid node has a stored
+/// partition (offsets of the blocks of cells written by each process)
+/// that matches the number of processes in comm
+bool has_partition(MPI_Comm comm, const hid_t h5_id,
+                   const pugi::xml_node& node);
+
+/// Read the Topology and Geometry arrays for the cells assigned to
+/// this process by the stored partition. Each process reads its own
+/// block of cells and the geometry nodes that its cells reference, so
+/// no repartitioning is required. If ghost_mode is not none, cells
+/// that share a facet with a cell on another process are sent to that
+/// process as ghost cells.
+/// @param[in] comm MPI communicator
+/// @param[in] h5_id HDF5 file handle
+/// @param[in] dxpl_id HDF5 data transfer property list of the file
+/// @param[in] node The Grid node
+/// @param[in] ghost_mode The ghost mode of the mesh to be created
+/// @returns ((cell type, degree), cells (owned cells followed by ghost
+///   cells, DOLFINX ordering), original cell indices, owner of each
+///   ghost cell, global node indices (sorted), geometry of these
+///   nodes)
+std::tuple<
+    std::pair<mesh::CellType, int>, graph::AdjacencyList<std::int64_t>,
+    std::vector<std::int64_t>, std::vector<int>, std::vector<std::int64_t>,
+    Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
+read_partitioned_mesh_data(MPI_Comm comm, const hid_t h5_id,
+                           const hid_t dxpl_id, const pugi::xml_node& node,
+                           mesh::GhostMode ghost_mode);
+
 } // namespace io::xdmf_mesh
 } // namespace dolfinx
@@ -71,6 +71,25 @@ xdmf_utils::get_cell_type(const pugi::xml_node& topology_node)
   return it->second;
 }
 //----------------------------------------------------------------------------
+int xdmf_utils::get_geometry_dim(const pugi::xml_node& geometry_node)
+{
+  assert(geometry_node);
+  pugi::xml_attribute geometry_type_attr
+      = geometry_node.attribute("GeometryType");
+  assert(geometry_type_attr);
+  const std::string geometry_type = geometry_type_attr.value();
+  if (geometry_type == "XY")
+    return 2;
+  else if (geometry_type == "XYZ")
+    return 3;
+  else
+  {
+    throw std::runtime_error(
+        "Cannot determine geometric dimension. GeometryType \"" + geometry_type
+        + "\" in XDMF file is unknown or unsupported");
+  }
+}
+//----------------------------------------------------------------------------
 std::array<std::string, 2>
 xdmf_utils::get_hdf5_paths(const pugi::xml_node& dataitem_node)
 {
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "HDF5Interface.h"
+#include "HDF5WriteQueue.h"
 #include "pugixml.hpp"
 #include <array>
 #include <boost/filesystem.hpp>
@@ -14,6 +15,7 @@
 #include <dolfinx/mesh/cell_types.h>
 #include <petscsys.h>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -37,6 +39,9 @@ namespace io::xdmf_utils
 // @return DOLFINX cell type and polynomial degree
 std::pair<std::string, int> get_cell_type(const pugi::xml_node& topology_node);
 
+/// Get geometric dimension from an XML Geometry node
+int get_geometry_dim(const pugi::xml_node& geometry_node);
+
 // Return (0) HDF5 filename and (1) path in HDF5 file from a DataItem
 // node
 std::array<std::string, 2> get_hdf5_paths(const pugi::xml_node& dataitem_node);
@@ -60,12 +65,20 @@ std::vector<PetscScalar> get_cell_data_values(const function::Function& u);
 std::string vtk_cell_type_str(mesh::CellType cell_type, int num_nodes);
 
 /// TODO: Document
+///
+/// The policy sets the HDF5 data transfer parameters and dxpl_id is
+/// the transfer property list of the file. If write_queue is not null,
+/// the data is copied into the queue and written to the HDF5 file
+/// asynchronously.
 template <typename T>
 void add_data_item(pugi::xml_node& xml_node, const hid_t h5_id,
                    const std::string h5_path, const T& x,
                    const std::int64_t offset,
                    const std::vector<std::int64_t> shape,
-                   const std::string number_type, const bool use_mpi_io)
+                   const std::string number_type, const bool use_mpi_io,
+                   const HDF5Policy& policy = HDF5Policy(),
+                   const hid_t dxpl_id = H5P_DEFAULT,
+                   HDF5WriteQueue* write_queue = nullptr)
 {
   // Add DataItem node
   assert(xml_node);
@@ -84,6 +97,15 @@ void add_data_item(pugi::xml_node& xml_node, const hid_t h5_id,
   if (!number_type.empty())
     data_item_node.append_attribute("NumberType") = number_type.c_str();
 
+  // Double precision data is stored in single precision if requested
+  // by the policy (HDF5 only)
+  using U = typename T::value_type;
+  if (h5_id >= 0 and std::is_floating_point<U>::value)
+  {
+    const bool single = std::is_same<U, float>::value or policy.float32;
+    data_item_node.append_attribute("Precision") = single ? "4" : "8";
+  }
+
   // Add format attribute
   if (h5_id < 0)
   {
@@ -96,8 +118,11 @@ void add_data_item(pugi::xml_node& xml_node, const hid_t h5_id,
   {
     data_item_node.append_attribute("Format") = "HDF";
 
-    // Get name of HDF5 file
-    const std::string hdf5_filename = HDF5Interface::get_filename(h5_id);
+    // Get name of HDF5 file (HDF5 must not be called while writes are
+    // pending on the queue)
+    const std::string hdf5_filename = write_queue
+                                          ? write_queue->filename()
+                                          : HDF5Interface::get_filename(h5_id);
     const boost::filesystem::path p(hdf5_filename);
 
     // Add HDF5 filename and HDF5 internal path to XML file
@@ -120,8 +145,17 @@ void add_data_item(pugi::xml_node& xml_node, const hid_t h5_id,
 
     const std::array<std::int64_t, 2> local_range
         = {{offset, offset + local_shape0}};
-    HDF5Interface::write_dataset(h5_id, h5_path, x.data(), local_range, shape,
-                                 use_mpi_io, false);
+    if (write_queue)
+    {
+      write_queue->write_dataset(h5_path, std::vector<U>(x.begin(), x.end()),
+                                 local_range, shape, use_mpi_io, false,
+                                 policy);
+    }
+    else
+    {
+      HDF5Interface::write_dataset(h5_id, h5_path, x.data(), local_range,
+                                   shape, use_mpi_io, false, policy, dxpl_id);
+    }
 
     // Add partitioning attribute to dataset
     // std::vector<std::size_t> partitions;
@@ -176,6 +176,32 @@ void PETScKrylovSolver::set_dm_active(bool val)
     KSPSetDMActive(_ksp, PETSC_FALSE);
 }
 //-----------------------------------------------------------------------------
+void PETScKrylovSolver::set_multigrid_interpolation(
+    const std::vector<Mat>& interpolation)
+{
+  assert(_ksp);
+  PC pc;
+  PetscErrorCode ierr = KSPGetPC(_ksp, &pc);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "KSPGetPC");
+  ierr = PCSetType(pc, PCMG);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "PCSetType");
+  ierr = PCMGSetLevels(pc, interpolation.size() + 1, nullptr);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "PCMGSetLevels");
+  for (std::size_t i = 0; i < interpolation.size(); ++i)
+  {
+    assert(interpolation[i]);
+    ierr = PCMGSetInterpolation(pc, i + 1, interpolation[i]);
+    if (ierr != 0)
+      petsc_error(ierr, __FILE__, "PCMGSetInterpolation");
+  }
+  ierr = PCMGSetGalerkin(pc, PC_MG_GALERKIN_BOTH);
+  if (ierr != 0)
+    petsc_error(ierr, __FILE__, "PCMGSetGalerkin");
+}
+//-----------------------------------------------------------------------------
 void PETScKrylovSolver::set_options_prefix(std::string options_prefix)
 {
   // Set options prefix
@@ -11,6 +11,7 @@
 #include <petscmat.h>
 #include <petscvec.h>
 #include <string>
+#include <vector>
 
 namespace dolfinx
 {
@@ -68,6 +69,18 @@ public:
   /// Activate/deactivate DM
   void set_dm_active(bool val);
 
+  /// Set the preconditioner to geometric multigrid (PCMG) with the
+  /// given interpolation operators. The restriction operators are the
+  /// transposes of the interpolation operators, and the coarse level
+  /// operators are computed by Galerkin projection of the operator set
+  /// on the finest level. Smoothers and the coarse solver can be
+  /// configured through the PETSc options database (-mg_levels_*,
+  /// -mg_coarse_*).
+  /// @param[in] interpolation Interpolation operators from level i to
+  ///   level i + 1, coarsest first (see
+  ///   fem::create_prolongation_matrix)
+  void set_multigrid_interpolation(const std::vector<Mat>& interpolation);
+
 private:
   // PETSc solver pointer
   KSP _ksp;
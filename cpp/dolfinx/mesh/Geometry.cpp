@@ -71,13 +71,6 @@ mesh::Geometry mesh::create_geometry(
     const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
                                         Eigen::RowMajor>>& x)
 {
-  // TODO: make sure required entities are initialised, or extend
-  // fem::DofMapBuilder::build to take connectivities
-
-  //  Build 'geometry' dofmap on the topology
-  auto [dof_index_map, dofmap] = fem::DofMapBuilder::build(
-      comm, topology, coordinate_element.dof_layout(), 1);
-
   // Build list of unique (global) node indices from adjacency list
   // (geometry nodes)
   std::vector<std::int64_t> indices(cell_nodes.array().data(),
@@ -91,6 +84,27 @@ mesh::Geometry mesh::create_geometry(
   Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> coords
       = graph::Partitioning::distribute_data<double>(comm, indices, x);
 
+  return mesh::create_geometry(comm, topology, coordinate_element, cell_nodes,
+                               indices, coords);
+}
+//-----------------------------------------------------------------------------
+mesh::Geometry mesh::create_geometry(
+    MPI_Comm comm, const Topology& topology,
+    const fem::CoordinateElement& coordinate_element,
+    const graph::AdjacencyList<std::int64_t>& cell_nodes,
+    const std::vector<std::int64_t>& indices,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                                        Eigen::RowMajor>>& coords)
+{
+  assert((int)indices.size() == coords.rows());
+
+  // TODO: make sure required entities are initialised, or extend
+  // fem::DofMapBuilder::build to take connectivities
+
+  //  Build 'geometry' dofmap on the topology
+  auto [dof_index_map, dofmap] = fem::DofMapBuilder::build(
+      comm, topology, coordinate_element.dof_layout(), 1);
+
   // Compute local-to-global map from local indices in dofmap to the
   // corresponding global indices in cell_nodes
   std::vector<std::int64_t> l2g
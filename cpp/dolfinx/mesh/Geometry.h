@@ -137,5 +137,25 @@ mesh::Geometry create_geometry(
     const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
                                         Eigen::RowMajor>>& x);
 
+/// Build Geometry from node coordinates that are already available on
+/// this process
+/// @param[in] comm MPI communicator
+/// @param[in] topology The mesh topology
+/// @param[in] coordinate_element The coordinate element
+/// @param[in] cells The cell nodes (global node indices) for the cells
+///   on this process
+/// @param[in] nodes Sorted list of the unique global node indices that
+///   appear in @p cells
+/// @param[in] x Coordinates of the nodes in @p nodes. Row i holds the
+///   coordinates of node nodes[i].
+/// @return The mesh geometry
+mesh::Geometry create_geometry(
+    MPI_Comm comm, const Topology& topology,
+    const fem::CoordinateElement& coordinate_element,
+    const graph::AdjacencyList<std::int64_t>& cells,
+    const std::vector<std::int64_t>& nodes,
+    const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                                        Eigen::RowMajor>>& x);
+
 } // namespace mesh
 } // namespace dolfinx
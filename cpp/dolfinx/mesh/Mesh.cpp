@@ -18,6 +18,7 @@
 #include <dolfinx/common/utils.h>
 #include <dolfinx/fem/CoordinateElement.h>
 #include <dolfinx/fem/DofMapBuilder.h>
+#include <dolfinx/fem/ElementDofLayout.h>
 #include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/graph/Partitioning.h>
 #include <dolfinx/io/cells.h>
@@ -58,6 +59,46 @@ Eigen::ArrayXd cell_r(const mesh::Mesh& mesh)
   return mesh::inradius(mesh, cells);
 }
 //-----------------------------------------------------------------------------
+// Return true if the geometry 'dofs' of a cell are just its vertices,
+// in order (P1 geometry), in which case the cell node lists are also
+// the cell topology
+bool is_vertex_layout(mesh::CellType cell_type,
+                      const fem::ElementDofLayout& layout)
+{
+  const int num_vertices = mesh::num_cell_vertices(cell_type);
+  if (layout.num_dofs() != num_vertices)
+    return false;
+  for (int i = 0; i < num_vertices; ++i)
+  {
+    const Eigen::Array<int, Eigen::Dynamic, 1> dofs = layout.entity_dofs(0, i);
+    if (dofs.rows() != 1 or dofs[0] != i)
+      return false;
+  }
+  return true;
+}
+//-----------------------------------------------------------------------------
+// Compute the entities (other than vertices and cells) that carry
+// geometry dofs, and their connectivity and index maps
+void create_geometry_entities(MPI_Comm comm, mesh::Topology& topology,
+                              const fem::ElementDofLayout& layout)
+{
+  const int tdim = topology.dim();
+  for (int e = 1; e < tdim; ++e)
+  {
+    if (layout.num_entity_dofs(e) > 0)
+    {
+      auto [cell_entity, entity_vertex, index_map]
+          = mesh::TopologyComputation::compute_entities(comm, topology, e);
+      if (cell_entity)
+        topology.set_connectivity(cell_entity, tdim, e);
+      if (entity_vertex)
+        topology.set_connectivity(entity_vertex, e, 0);
+      if (index_map)
+        topology.set_index_map(e, index_map);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
 } // namespace
 
 //-----------------------------------------------------------------------------
@@ -68,52 +109,96 @@ Mesh mesh::create(MPI_Comm comm,
                                      Eigen::RowMajor>& x,
                   mesh::GhostMode ghost_mode)
 {
-  // TODO: This step can be skipped for 'P1' elements
-  //
-  // Extract topology data, e.g. just the vertices. For P1 geometry this
-  // should just be the identity operator. For other elements the
-  // filtered lists may have 'gaps', i.e. the indices might not be
-  // contiguous.
-  const graph::AdjacencyList<std::int64_t> cells_topology
-      = mesh::extract_topology(element.cell_shape(), element.dof_layout(),
-                               cells);
+  // Extract topology data, e.g. just the vertices. For P1 geometry
+  // the cell node lists are the topology and are used directly. For
+  // other elements the filtered lists may have 'gaps', i.e. the
+  // indices might not be contiguous.
+  const bool vertex_layout
+      = is_vertex_layout(element.cell_shape(), element.dof_layout());
+  common::Timer t0("Create mesh: partition cells");
+  graph::AdjacencyList<std::int64_t> cells_extracted(0);
+  if (!vertex_layout)
+  {
+    cells_extracted = mesh::extract_topology(element.cell_shape(),
+                                             element.dof_layout(), cells);
+  }
+  const graph::AdjacencyList<std::int64_t>& cells_topology
+      = vertex_layout ? cells : cells_extracted;
 
   // Compute the destination rank for cells on this process via graph
   // partitioning
   const int size = dolfinx::MPI::size(comm);
   const graph::AdjacencyList<std::int32_t> dest = Partitioning::partition_cells(
       comm, size, element.cell_shape(), cells_topology, ghost_mode);
+  t0.stop();
 
   // Distribute cells to destination rank
+  common::Timer t1("Create mesh: distribute cells");
   const auto [cell_nodes, src, original_cell_index, ghost_owners]
       = graph::Partitioning::distribute(comm, cells, dest);
+  t1.stop();
 
+  common::Timer t2("Create mesh: create topology");
+  if (!vertex_layout)
+  {
+    cells_extracted = mesh::extract_topology(element.cell_shape(),
+                                             element.dof_layout(), cell_nodes);
+  }
   Topology topology = mesh::create_topology(
-      comm,
-      mesh::extract_topology(element.cell_shape(), element.dof_layout(),
-                             cell_nodes),
-      original_cell_index, ghost_owners, element.cell_shape(), ghost_mode);
+      comm, vertex_layout ? cell_nodes : cells_extracted, original_cell_index,
+      ghost_owners, element.cell_shape(), ghost_mode);
 
   // Create connectivity required to compute the Geometry (extra
   // connectivities for higher-order geometries)
-  const int tdim = topology.dim();
-  for (int e = 1; e < tdim; ++e)
+  create_geometry_entities(comm, topology, element.dof_layout());
+  t2.stop();
+
+  common::Timer t3("Create mesh: create geometry");
+  Geometry geometry
+      = mesh::create_geometry(comm, topology, element, cell_nodes, x);
+  t3.stop();
+
+  return Mesh(comm, std::move(topology), std::move(geometry));
+}
+//-----------------------------------------------------------------------------
+Mesh mesh::create(MPI_Comm comm,
+                  const graph::AdjacencyList<std::int64_t>& cells,
+                  const std::vector<std::int64_t>& original_cell_index,
+                  const std::vector<int>& ghost_owners,
+                  const fem::CoordinateElement& element,
+                  const std::vector<std::int64_t>& nodes,
+                  const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                                     Eigen::RowMajor>& x,
+                  GhostMode ghost_mode)
+{
+  assert(cells.num_nodes() == (int)original_cell_index.size());
+  if (ghost_mode == mesh::GhostMode::none and !ghost_owners.empty())
+    throw std::runtime_error("Ghost cells given for GhostMode::none.");
+
+  // Cells are already on their destination rank, and any ghost cells
+  // are known
+  common::Timer t0("Create mesh: create topology");
+  graph::AdjacencyList<std::int64_t> cells_extracted(0);
+  const bool vertex_layout
+      = is_vertex_layout(element.cell_shape(), element.dof_layout());
+  if (!vertex_layout)
   {
-    if (element.dof_layout().num_entity_dofs(e) > 0)
-    {
-      auto [cell_entity, entity_vertex, index_map]
-          = mesh::TopologyComputation::compute_entities(comm, topology, e);
-      if (cell_entity)
-        topology.set_connectivity(cell_entity, tdim, e);
-      if (entity_vertex)
-        topology.set_connectivity(entity_vertex, e, 0);
-      if (index_map)
-        topology.set_index_map(e, index_map);
-    }
+    cells_extracted = mesh::extract_topology(element.cell_shape(),
+                                             element.dof_layout(), cells);
   }
+  Topology topology = mesh::create_topology(
+      comm, vertex_layout ? cells : cells_extracted, original_cell_index,
+      ghost_owners, element.cell_shape(), ghost_mode);
 
+  // Create connectivity required to compute the Geometry (extra
+  // connectivities for higher-order geometries)
+  create_geometry_entities(comm, topology, element.dof_layout());
+  t0.stop();
+
+  common::Timer t1("Create mesh: create geometry");
   Geometry geometry
-      = mesh::create_geometry(comm, topology, element, cell_nodes, x);
+      = mesh::create_geometry(comm, topology, element, cells, nodes, x);
+  t1.stop();
 
   return Mesh(comm, std::move(topology), std::move(geometry));
 }
@@ -191,5 +191,31 @@ Mesh create(MPI_Comm comm, const graph::AdjacencyList<std::int64_t>& cells,
                                Eigen::RowMajor>& x,
             GhostMode ghost_mode);
 
+/// Create a mesh from cells that have already been distributed, e.g.
+/// read from file using a stored partition or generated on a process
+/// grid. No graph partitioning or redistribution of cells is performed.
+/// @param[in] comm MPI communicator to build the mesh on
+/// @param[in] cells The cells on this process (global node indices,
+///   DOLFINX ordering). Ghost cells, if any, are at the end.
+/// @param[in] original_cell_index The original global index of each
+///   cell in @p cells
+/// @param[in] ghost_owners The owning process of each ghost cell (empty
+///   if there are no ghost cells)
+/// @param[in] element The coordinate element
+/// @param[in] nodes Sorted list of the unique global node indices that
+///   appear in @p cells
+/// @param[in] x Coordinates of the nodes in @p nodes
+/// @param[in] ghost_mode The ghost mode that the ghost cells in @p
+///   cells were created for (none if there are no ghost cells)
+/// @return A distributed mesh
+Mesh create(MPI_Comm comm, const graph::AdjacencyList<std::int64_t>& cells,
+            const std::vector<std::int64_t>& original_cell_index,
+            const std::vector<int>& ghost_owners,
+            const fem::CoordinateElement& element,
+            const std::vector<std::int64_t>& nodes,
+            const Eigen::Array<double, Eigen::Dynamic, Eigen::Dynamic,
+                               Eigen::RowMajor>& x,
+            GhostMode ghost_mode);
+
 } // namespace mesh
 } // namespace dolfinx
@@ -18,6 +18,7 @@
 #include <dolfinx/io/cells.h>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -162,47 +163,25 @@ create_meshtags(MPI_Comm comm, const std::shared_ptr<const mesh::Mesh>& mesh,
   // Tagged entity topological dimension
   const int e_dim = mesh::cell_dim(tag_cell_type);
 
-  // -------------------
-  // 1. Send this rank's global "input" nodes indices to the
-  //    'postmaster' rank, and receive global "input" nodes for which
-  //    this rank is the postmaster
-
-  // Get "input" global node indices (as in the input file before any
-  // internal re-ordering)
-  const std::vector<std::int64_t>& nodes_g
-      = mesh->geometry().input_global_indices();
-
-  // Send input global indices to 'post master' rank, based on input
-  // global index value
+  // Entities are matched with a distributed sorted lookup. The key of
+  // an entity is the sorted list of the "input" global node indices of
+  // its vertices (as in the input file before any internal
+  // re-ordering). Each key is assigned to a 'postmaster' rank based on
+  // its lowest node index. The tagged entities and the entities of the
+  // mesh are both sent to the postmaster, which matches them by binary
+  // search in the sorted tagged keys and returns the tag values to the
+  // ranks that have the entities.
   const std::int64_t num_nodes_g = mesh->geometry().index_map()->size_global();
   const int comm_size = MPI::size(comm);
-  // NOTE: could make this int32_t be sending: index <- index - dest_rank_offset
-  std::vector<std::vector<std::int64_t>> nodes_g_send(comm_size);
-  for (std::int64_t node : nodes_g)
-  {
-    // TODO: Optimise this call by adding 'vectorised verion of
-    //       MPI::index_owner
-    // Figure out which process is the postmaster for the input global index
-    const std::int32_t p
-        = dolfinx::MPI::index_owner(comm_size, node, num_nodes_g);
-    nodes_g_send[p].push_back(node);
-  }
-
-  // Send/receive
-  const graph::AdjacencyList<std::int64_t> nodes_g_recv
-      = MPI::all_to_all(comm, graph::AdjacencyList<std::int64_t>(nodes_g_send));
+  const int nnodes_per_entity = entities.cols();
 
   // -------------------
-  // 2. Send the entity key (nodes list) and tag to the postmaster based
-  //    on the lowest index node in the entity 'key'
-  //
-  //    NOTE: Stage 2 doesn't depend on the data received in Step 1, so
-  //    data (i) the communication could be combined, or (ii) the
-  //    communication in Step 1 could be make non-blocking.
+  // 1. Send the entity key (nodes list) and tag of the tagged entities
+  //    to the postmaster
 
   std::vector<std::vector<std::int64_t>> entities_send(comm_size);
   std::vector<std::vector<T>> values_send(comm_size);
-  std::vector<std::int64_t> entity(entities.cols());
+  std::vector<std::int64_t> entity(nnodes_per_entity);
   for (std::int32_t e = 0; e < entities.rows(); ++e)
   {
     // Copy nodes for entity and sort
@@ -225,71 +204,13 @@ create_meshtags(MPI_Comm comm, const std::shared_ptr<const mesh::Mesh>& mesh,
       = MPI::all_to_all(comm, graph::AdjacencyList<T>(values_send));
 
   // -------------------
-  // 3. As 'postmaster', send back the entity key (vertex list) and tag
-  //    value to ranks that possibly need the data. Do this based on the
-  //    first node index in the entity key.
-
-  // NOTE: Could: (i) use a std::unordered_multimap, or (ii) only send
-  // owned nodes to the postmaster and use map, unordered_map or
-  // std::vector<pair>>, followed by a neighbourhood all_to_all at the
-  // end.
-  //
-  // Build map from global node index to ranks that have the node
-  std::multimap<std::int64_t, int> node_to_rank;
-  for (int p = 0; p < nodes_g_recv.num_nodes(); ++p)
-  {
-    auto nodes = nodes_g_recv.links(p);
-    for (int i = 0; i < nodes.rows(); ++i)
-      node_to_rank.insert({nodes(i), p});
-  }
+  // 2. Send the keys of the entities on this process, with their local
+  //    index, to the postmaster
 
-  // Figure out which processes are owners of received nodes
-  std::vector<std::vector<std::int64_t>> send_nodes_owned(comm_size);
-  std::vector<std::vector<T>> send_vals_owned(comm_size);
-  const int nnodes_per_entity = entities.cols();
-  const Eigen::Map<const Eigen::Array<std::int64_t, Eigen::Dynamic,
-                                      Eigen::Dynamic, Eigen::RowMajor>>
-      _entities_recv(entities_recv.array().data(),
-                     entities_recv.array().rows() / nnodes_per_entity,
-                     nnodes_per_entity);
-  auto _values_recv = values_recv.array();
-  assert(_values_recv.rows() == _entities_recv.rows());
-  for (int e = 0; e < _entities_recv.rows(); ++e)
-  {
-    // Find ranks that have node0
-    auto [it0, it1] = node_to_rank.equal_range(_entities_recv(e, 0));
-    for (auto it = it0; it != it1; ++it)
-    {
-      const int p1 = it->second;
-      send_nodes_owned[p1].insert(
-          send_nodes_owned[p1].end(), _entities_recv.row(e).data(),
-          _entities_recv.row(e).data() + _entities_recv.cols());
-      send_vals_owned[p1].push_back(_values_recv(e));
-    }
-  }
-
-  // TODO: Pack into one MPI call
-  const graph::AdjacencyList<std::int64_t> recv_ents = MPI::all_to_all(
-      comm, graph::AdjacencyList<std::int64_t>(send_nodes_owned));
-  const graph::AdjacencyList<T> recv_vals
-      = MPI::all_to_all(comm, graph::AdjacencyList<T>(send_vals_owned));
-
-  // -------------------
-  // 4. From the received (key, value) data, determine which keys
-  //    (entities) are on this process.
-
-  // TODO: Rather than using std::map<std::vector<std::int64_t>,
-  //       std::int32_t>, use a rectangular Eigen::Array to avoid the
-  //       cost of std::vector<std::int64_t> allocations, and sort the
-  //       Array by row.
-  //
-  // TODO: We have already received possibly tagged entities from other
-  //       ranks, so we could use the received data to avoid creating
-  //       the std::map for *all* entities and just for candidate
-  //       entities.
-
-  // Build map from vertex index (local to rank) to global "user" node
+  // Build map from vertex index (local to rank) to global "input" node
   // index
+  const std::vector<std::int64_t>& nodes_g
+      = mesh->geometry().input_global_indices();
   auto map_v = mesh->topology().index_map(0);
   assert(map_v);
   const std::int32_t num_vertices = map_v->size_local() + map_v->num_ghosts();
@@ -307,45 +228,96 @@ create_meshtags(MPI_Comm comm, const std::shared_ptr<const mesh::Mesh>& mesh,
       vertex_to_node[vertices[v]] = nodes_g[x_dofs[v]];
   }
 
-  // Build a map from entities on this process (keyed by vertex ordered
-  // entity input global indices) to entity local index
+  // Pack (key, local index) for each entity on this process
   auto e_to_v = mesh->topology().connectivity(e_dim, 0);
   if (!e_to_v)
     throw std::runtime_error("Missing entity-vertex connectivity.");
-  std::map<std::vector<std::int64_t>, std::int32_t> entity_key_to_index;
-  std::vector<std::int64_t> key(nnodes_per_entity);
+  std::vector<std::vector<std::int64_t>> keys_send(comm_size);
   for (std::int32_t e = 0; e < e_to_v->num_nodes(); ++e)
   {
     auto vertices = e_to_v->links(e);
+    assert(vertices.rows() == nnodes_per_entity);
     for (int v = 0; v < vertices.rows(); ++v)
-      key[v] = vertex_to_node[vertices(v)];
-    std::sort(key.begin(), key.end());
-    entity_key_to_index.insert({key, e});
+      entity[v] = vertex_to_node[vertices(v)];
+    std::sort(entity.begin(), entity.end());
+
+    const std::int32_t p
+        = dolfinx::MPI::index_owner(comm_size, entity.front(), num_nodes_g);
+    keys_send[p].insert(keys_send[p].end(), entity.begin(), entity.end());
+    keys_send[p].push_back(e);
   }
 
-  // Iterate over all received entities. If entity is on this rank,
-  // store (local entity index, tag value)
-  std::vector<std::int32_t> indices_new;
-  std::vector<T> values_new;
+  const graph::AdjacencyList<std::int64_t> keys_recv
+      = MPI::all_to_all(comm, graph::AdjacencyList<std::int64_t>(keys_send));
+
+  // -------------------
+  // 3. As postmaster, look up the received entity keys in the sorted
+  //    tagged keys, and send the (local index, tag value) of matching
+  //    entities back to the rank that has the entity
+
+  // Sort tagged entities by key, for lookup by binary search
   const Eigen::Map<const Eigen::Array<std::int64_t, Eigen::Dynamic,
                                       Eigen::Dynamic, Eigen::RowMajor>>
-      _entities(recv_ents.array().data(),
-                recv_ents.array().rows() / nnodes_per_entity,
-                nnodes_per_entity);
-  entity.resize(nnodes_per_entity);
-  for (Eigen::Index e = 0; e < _entities.rows(); ++e)
+      tagged_keys(entities_recv.array().data(),
+                  entities_recv.array().rows() / nnodes_per_entity,
+                  nnodes_per_entity);
+  auto tagged_values = values_recv.array();
+  assert(tagged_values.rows() == tagged_keys.rows());
+  std::vector<std::int32_t> tag_perm(tagged_keys.rows());
+  std::iota(tag_perm.begin(), tag_perm.end(), 0);
+  std::sort(tag_perm.begin(), tag_perm.end(),
+            [&tagged_keys, nnodes_per_entity](std::int32_t e0,
+                                              std::int32_t e1) {
+              const std::int64_t* k0 = tagged_keys.row(e0).data();
+              const std::int64_t* k1 = tagged_keys.row(e1).data();
+              return std::lexicographical_compare(
+                  k0, k0 + nnodes_per_entity, k1, k1 + nnodes_per_entity);
+            });
+
+  std::vector<std::vector<std::int32_t>> indices_send(comm_size);
+  std::vector<std::vector<T>> values_found(comm_size);
+  for (int p = 0; p < keys_recv.num_nodes(); ++p)
   {
-    // Note: _entities.row(e) was sorted by the sender
-    std::copy(_entities.row(e).data(),
-              _entities.row(e).data() + nnodes_per_entity, entity.begin());
-    if (const auto it = entity_key_to_index.find(entity);
-        it != entity_key_to_index.end())
+    auto keys_p = keys_recv.links(p);
+    for (Eigen::Index i = 0; i < keys_p.rows(); i += nnodes_per_entity + 1)
     {
-      indices_new.push_back(it->second);
-      values_new.push_back(recv_vals.array()[e]);
+      // Note: key was sorted by the sender
+      const std::int64_t* key = keys_p.data() + i;
+      auto it = std::lower_bound(
+          tag_perm.begin(), tag_perm.end(), key,
+          [&tagged_keys, nnodes_per_entity](std::int32_t e0,
+                                            const std::int64_t* k1) {
+            const std::int64_t* k0 = tagged_keys.row(e0).data();
+            return std::lexicographical_compare(
+                k0, k0 + nnodes_per_entity, k1, k1 + nnodes_per_entity);
+          });
+      if (it != tag_perm.end()
+          and std::equal(key, key + nnodes_per_entity,
+                         tagged_keys.row(*it).data()))
+      {
+        indices_send[p].push_back(key[nnodes_per_entity]);
+        values_found[p].push_back(tagged_values[*it]);
+      }
     }
   }
 
+  // TODO: Pack into one MPI call
+  const graph::AdjacencyList<std::int32_t> indices_recv = MPI::all_to_all(
+      comm, graph::AdjacencyList<std::int32_t>(indices_send));
+  const graph::AdjacencyList<T> values_new_recv
+      = MPI::all_to_all(comm, graph::AdjacencyList<T>(values_found));
+
+  // -------------------
+  // 4. Collect the (local entity index, tag value) pairs for this
+  //    process
+
+  std::vector<std::int32_t> indices_new(
+      indices_recv.array().data(),
+      indices_recv.array().data() + indices_recv.array().rows());
+  std::vector<T> values_new(values_new_recv.array().data(),
+                            values_new_recv.array().data()
+                                + values_new_recv.array().rows());
+
   // -------------------
   // 5. Build MeshTags object
 
@@ -12,14 +12,18 @@
 #include <dolfinx/la/PETScMatrix.h>
 #include <dolfinx/la/PETScOptions.h>
 #include <dolfinx/la/PETScVector.h>
+#include <algorithm>
+#include <cmath>
 #include <string>
+#include <tuple>
 
 using namespace dolfinx;
 
 //-----------------------------------------------------------------------------
 nls::NewtonSolver::NewtonSolver(MPI_Comm comm)
-    : _krylov_iterations(0), _residual(0.0), _residual0(0.0), _solver(comm),
-      _dx(nullptr), _mpi_comm(comm)
+    : _krylov_iterations(0), _jacobian_updates(0), _preconditioner_updates(0),
+      _residual_evaluations(0), _jacobian_evaluations(0), _residual(0.0),
+      _residual0(0.0), _solver(comm), _dx(nullptr), _mpi_comm(comm)
 {
   // Create linear solver if not already created. Default to LU.
   _solver.set_options_prefix("nls_solve_");
@@ -43,69 +47,180 @@ dolfinx::nls::NewtonSolver::solve(NonlinearProblem& nonlinear_problem, Vec x)
   // Reset iteration counts
   int newton_iteration = 0;
   _krylov_iterations = 0;
+  _jacobian_updates = 0;
+  _preconditioner_updates = 0;
+  _residual_evaluations = 0;
+  _jacobian_evaluations = 0;
 
-  // Compute F(u) (assembled into _b)
+  const bool incremental = convergence_criterion == "incremental";
+  if (!incremental and convergence_criterion != "residual")
+  {
+    throw std::runtime_error("Unknown convergence criterion: "
+                             + convergence_criterion);
+  }
+  const bool backtracking = line_search == LineSearch::backtracking;
+
+  // Operators and F at the current point. F is only computed where it
+  // is needed, and together with J (see NonlinearProblem::FJ) if J is
+  // also needed at the same point.
   Mat A(nullptr), P(nullptr);
   Vec b = nullptr;
+  bool F_current = false, J_current = false;
+  PetscReal residual_norm = 0.0;
+  auto evaluate = [&](bool with_jacobian) {
+    if (with_jacobian)
+    {
+      std::tie(b, A) = nonlinear_problem.FJ(x);
+      assert(A);
+      ++_jacobian_evaluations;
+      J_current = true;
+    }
+    else
+      b = nonlinear_problem.F(x);
+    assert(b);
+    ++_residual_evaluations;
+    F_current = true;
 
+    // Norm of F, used by the forcing terms and the line search
+    if (eisenstat_walker or backtracking)
+      VecNorm(b, NORM_2, &residual_norm);
+  };
+
+  // Jacobian is updated in the first iteration, every
+  // jacobian_update_frequency iterations or if convergence with lagged
+  // operators is slow
+  bool force_update = false;
+  auto update_jacobian = [&](int iteration) {
+    return iteration == 0 or force_update
+           or (jacobian_update_frequency > 0
+               and iteration % jacobian_update_frequency == 0);
+  };
+
+  // Compute F(u) (assembled into _b). With the incremental criterion F
+  // is not used for testing convergence, so J is computed with it.
   nonlinear_problem.form(x);
-  b = nonlinear_problem.F(x);
-  assert(b);
+  evaluate(incremental);
 
-  // Check convergence
+  // Save the linear solver tolerances, which are modified by the
+  // forcing terms
+  PetscReal ksp_rtol, ksp_atol, ksp_dtol;
+  PetscInt ksp_max_it;
+  KSPGetTolerances(_solver.ksp(), &ksp_rtol, &ksp_atol, &ksp_dtol,
+                   &ksp_max_it);
+  double eta = eisenstat_walker_rtol0;
+  PetscReal residual_norm_prev = residual_norm;
+  Vec x_prev = nullptr;
+  if (backtracking)
+    VecDuplicate(x, &x_prev);
+
+  // Check convergence. We need to do at least one Newton step with the
+  // ||dx||-stopping criterion.
   bool newton_converged = false;
-  if (convergence_criterion == "residual")
+  if (!incremental)
     newton_converged = converged(b, nonlinear_problem, 0);
-  else if (convergence_criterion == "incremental")
-  {
-    // We need to do at least one Newton step with the ||dx||-stopping
-    // criterion.
-    newton_converged = false;
-  }
-  else
-  {
-    throw std::runtime_error("Unknown convergence criterion: "
-                             + convergence_criterion);
-  }
 
   // Start iterations
   while (!newton_converged and newton_iteration < max_it)
   {
-    // Compute Jacobian
-    A = nonlinear_problem.J(x);
-    assert(A);
-    P = nonlinear_problem.P(x);
-    if (!P)
-      P = A;
+    bool lagged = !update_jacobian(newton_iteration);
+    if (!lagged)
+    {
+      // Compute Jacobian, unless it was computed together with F
+      if (!J_current)
+      {
+        A = nonlinear_problem.J(x);
+        assert(A);
+        ++_jacobian_evaluations;
+      }
+      P = nonlinear_problem.P(x);
+      if (!P)
+        P = A;
 
-    if (!_dx)
-      MatCreateVecs(A, &_dx, nullptr);
+      if (!_dx)
+        MatCreateVecs(A, &_dx, nullptr);
 
-    // FIXME: check that this is efficient if A and/or P are unchanged
-    // Set operators
-    _solver.set_operators(A, P);
+      // Set up the preconditioner for the first Jacobian and every
+      // preconditioner_update_frequency Jacobians, otherwise apply the
+      // previous preconditioner to the new operator
+      const bool update_pc
+          = _jacobian_updates == 0 or force_update
+            or (preconditioner_update_frequency > 0
+                and _jacobian_updates % preconditioner_update_frequency
+                        == 0);
+      KSPSetReusePreconditioner(_solver.ksp(),
+                                update_pc ? PETSC_FALSE : PETSC_TRUE);
+      _solver.set_operators(A, P);
+
+      ++_jacobian_updates;
+      if (update_pc)
+        ++_preconditioner_updates;
+      else
+        lagged = true;
+    }
+
+    // Set linear solver tolerance from the Eisenstat-Walker forcing
+    // term (choice 2)
+    if (eisenstat_walker)
+    {
+      if (newton_iteration > 0)
+      {
+        const double eta_safe
+            = eisenstat_walker_gamma * std::pow(eta, eisenstat_walker_alpha);
+        eta = eisenstat_walker_gamma
+              * std::pow(residual_norm / residual_norm_prev,
+                         eisenstat_walker_alpha);
+        if (eta_safe > 0.1)
+          eta = std::max(eta, eta_safe);
+        eta = std::min(eta, eisenstat_walker_rtol_max);
+      }
+      KSPSetTolerances(_solver.ksp(), eta, ksp_atol, ksp_dtol, ksp_max_it);
+    }
 
     // Perform linear solve and update total number of Krylov iterations
+    assert(F_current);
     _krylov_iterations += _solver.solve(_dx, b);
 
-    // Update solution
-    update_solution(x, _dx, relaxation_parameter, nonlinear_problem,
-                    newton_iteration);
+    // Update solution. With backtracking, the step is halved until the
+    // norm of F is sufficiently reduced.
+    residual_norm_prev = residual_norm;
+    if (backtracking)
+      VecCopy(x, x_prev);
+    double step = relaxation_parameter;
+    for (int i = 0;; ++i)
+    {
+      update_solution(x, _dx, step, nonlinear_problem, newton_iteration);
+
+      // The hook is always called since it may update ghost values and
+      // internal variables
+      nonlinear_problem.form(x);
+      F_current = false;
+      J_current = false;
+      if (!backtracking)
+        break;
+
+      evaluate(false);
+      if (i == line_search_max_it
+          or residual_norm
+                 <= (1.0 - line_search_alpha * step) * residual_norm_prev)
+      {
+        break;
+      }
+
+      if (report and MPI::rank(_mpi_comm.comm()) == 0)
+      {
+        LOG(INFO) << "Newton line search: step " << step << ": r (abs) = "
+                  << residual_norm << ", reducing step";
+      }
+      step *= 0.5;
+      VecCopy(x_prev, x);
+    }
 
     // Increment iteration count
     ++newton_iteration;
 
-    // FIXME: This step is not needed if residual is based on dx and
-    //        this has converged.
-    // FIXME: But, this function call may update internal variables, etc.
-    // Compute F
-    nonlinear_problem.form(x);
-    b = nonlinear_problem.F(x);
-
     // Test for convergence
-    if (convergence_criterion == "residual")
-      newton_converged = converged(b, nonlinear_problem, newton_iteration);
-    else if (convergence_criterion == "incremental")
+    const double residual_prev = _residual;
+    if (incremental)
     {
       // Subtract 1 to make sure that the initial residual0 is
       // properly set.
@@ -113,16 +228,37 @@ dolfinx::nls::NewtonSolver::solve(NonlinearProblem& nonlinear_problem, Vec x)
           = converged(_dx, nonlinear_problem, newton_iteration - 1);
     }
     else
-      throw std::runtime_error("Unknown convergence criterion string.");
+    {
+      if (!F_current)
+        evaluate(false);
+      newton_converged = converged(b, nonlinear_problem, newton_iteration);
+    }
+
+    // Update operators in the next iteration if lagged operators
+    // reduced the residual too slowly
+    force_update = lagged and residual_prev > 0.0
+                   and _residual > lagged_rate_max * residual_prev;
+
+    // Compute F for the next iteration if it has not been computed yet
+    // (incremental criterion). It is not needed once converged.
+    if (!newton_converged and !F_current and newton_iteration < max_it)
+      evaluate(update_jacobian(newton_iteration));
   }
 
+  KSPSetTolerances(_solver.ksp(), ksp_rtol, ksp_atol, ksp_dtol, ksp_max_it);
+  if (x_prev)
+    VecDestroy(&x_prev);
+
   if (newton_converged)
   {
     if (MPI::rank(_mpi_comm.comm()) == 0)
     {
       LOG(INFO) << "Newton solver finished in " << newton_iteration
                 << " iterations and " << _krylov_iterations
-                << " linear solver iterations.";
+                << " linear solver iterations (" << _residual_evaluations
+                << " residual and " << _jacobian_evaluations
+                << " Jacobian evaluations, " << _preconditioner_updates
+                << " preconditioner updates).";
     }
   }
   else
@@ -146,10 +282,32 @@ dolfinx::nls::NewtonSolver::solve(NonlinearProblem& nonlinear_problem, Vec x)
 //-----------------------------------------------------------------------------
 int nls::NewtonSolver::krylov_iterations() const { return _krylov_iterations; }
 //-----------------------------------------------------------------------------
+int nls::NewtonSolver::jacobian_updates() const { return _jacobian_updates; }
+//-----------------------------------------------------------------------------
+int nls::NewtonSolver::preconditioner_updates() const
+{
+  return _preconditioner_updates;
+}
+//-----------------------------------------------------------------------------
+int nls::NewtonSolver::residual_evaluations() const
+{
+  return _residual_evaluations;
+}
+//-----------------------------------------------------------------------------
+int nls::NewtonSolver::jacobian_evaluations() const
+{
+  return _jacobian_evaluations;
+}
+//-----------------------------------------------------------------------------
 double nls::NewtonSolver::residual() const { return _residual; }
 //-----------------------------------------------------------------------------
 double nls::NewtonSolver::residual0() const { return _residual0; }
 //-----------------------------------------------------------------------------
+const la::PETScKrylovSolver& nls::NewtonSolver::get_krylov_solver() const
+{
+  return _solver;
+}
+//-----------------------------------------------------------------------------
 bool nls::NewtonSolver::converged(const Vec r, const NonlinearProblem&,
                                   std::size_t newton_iteration)
 {
@@ -6,10 +6,12 @@
 
 #pragma once
 
+#include <cmath>
 #include <dolfinx/common/MPI.h>
 #include <dolfinx/la/PETScKrylovSolver.h>
 #include <memory>
 #include <petscvec.h>
+#include <string>
 #include <utility>
 
 namespace dolfinx
@@ -27,10 +29,26 @@ class NonlinearProblem;
 
 /// This class defines a Newton solver for nonlinear systems of
 /// equations of the form \f$F(x) = 0\f$.
+///
+/// After each update of x, NonlinearProblem::form is called, and F is
+/// evaluated only where it is used. With the "residual" convergence
+/// criterion, F is evaluated after every update to test convergence.
+/// With the "incremental" criterion, F is evaluated only if the update
+/// has not converged, and together with J (NonlinearProblem::FJ) if the
+/// Jacobian is to be updated in the next iteration.
 
 class NewtonSolver
 {
 public:
+  /// Line search method. basic takes the full (relaxed) step.
+  /// backtracking halves the step, starting from relaxation_parameter,
+  /// until |F(x - s dx)| <= (1 - line_search_alpha * s) |F(x)|.
+  enum class LineSearch
+  {
+    basic,
+    backtracking
+  };
+
   /// Create nonlinear solver
   /// @param[in] comm The MPI communicator for the solver
   explicit NewtonSolver(MPI_Comm comm);
@@ -52,6 +70,24 @@ public:
   /// @return Number of iterations.
   int krylov_iterations() const;
 
+  /// Return number of Jacobian updates since solve started
+  /// @return Number of Jacobian updates
+  int jacobian_updates() const;
+
+  /// Return number of preconditioner updates since solve started
+  /// @return Number of preconditioner updates
+  int preconditioner_updates() const;
+
+  /// Return number of evaluations of F (NonlinearProblem::F or
+  /// NonlinearProblem::FJ) since solve started
+  /// @return Number of evaluations of F
+  int residual_evaluations() const;
+
+  /// Return number of evaluations of J (NonlinearProblem::J or
+  /// NonlinearProblem::FJ) since solve started
+  /// @return Number of evaluations of J
+  int jacobian_evaluations() const;
+
   /// Return current residual
   /// @return Current residual
   double residual() const;
@@ -60,6 +96,10 @@ public:
   /// @return Initial residual
   double residual0() const;
 
+  /// Return the linear solver used for the Newton updates
+  /// @return The Krylov solver
+  const la::PETScKrylovSolver& get_krylov_solver() const;
+
   /// Maximum number of iterations
   int max_it = 50;
 
@@ -82,6 +122,57 @@ public:
   /// Relaxation parameter
   double relaxation_parameter = 1.0;
 
+  /// Number of Newton iterations between Jacobian updates. If it is 1,
+  /// the Jacobian is updated in every iteration (Newton's method). If
+  /// it is 0, it is updated in the first iteration only (modified
+  /// Newton method). Otherwise the linear operators from the most
+  /// recent update are reused.
+  int jacobian_update_frequency = 1;
+
+  /// Number of Jacobian updates between preconditioner updates. If it
+  /// is 1, the preconditioner is set up for every Jacobian. If it is 0,
+  /// it is set up in the first iteration only. Otherwise the
+  /// preconditioner of the most recent update is applied to the new
+  /// Jacobian.
+  int preconditioner_update_frequency = 1;
+
+  /// If the residual is reduced by less than this factor in an
+  /// iteration that used a lagged Jacobian or preconditioner, both are
+  /// updated in the next iteration
+  double lagged_rate_max = 0.5;
+
+  /// Set the relative tolerance of the linear solver in each iteration
+  /// from the Eisenstat-Walker forcing term (choice 2), i.e.
+  ///
+  ///   eta_k = gamma * (|F(x_k)| / |F(x_{k-1})|)^alpha
+  ///
+  /// safeguarded by gamma * eta_{k-1}^alpha and bounded by rtol_max.
+  /// The linear solver tolerance is restored after the solve.
+  bool eisenstat_walker = false;
+
+  /// Linear solver relative tolerance in the first iteration when
+  /// eisenstat_walker is set
+  double eisenstat_walker_rtol0 = 0.3;
+
+  /// Maximum linear solver relative tolerance when eisenstat_walker is
+  /// set
+  double eisenstat_walker_rtol_max = 0.9;
+
+  /// Parameter gamma of the Eisenstat-Walker forcing term
+  double eisenstat_walker_gamma = 1.0;
+
+  /// Parameter alpha of the Eisenstat-Walker forcing term
+  double eisenstat_walker_alpha = 0.5 * (1.0 + std::sqrt(5.0));
+
+  /// Line search
+  LineSearch line_search = LineSearch::basic;
+
+  /// Maximum number of step reductions in the backtracking line search
+  int line_search_max_it = 10;
+
+  /// Sufficient decrease parameter of the backtracking line search
+  double line_search_alpha = 1.0e-4;
+
 protected:
   /// Convergence test. It may be overloaded using virtual inheritance
   /// and this base criterion may be called from derived, both in C++
@@ -112,6 +203,12 @@ private:
   // Accumulated number of Krylov iterations since solve began
   int _krylov_iterations;
 
+  // Number of Jacobian and preconditioner updates since solve began
+  int _jacobian_updates, _preconditioner_updates;
+
+  // Number of evaluations of F and J since solve began
+  int _residual_evaluations, _jacobian_evaluations;
+
   // Most recent residual and initial residual
   double _residual, _residual0;
 
@@ -8,6 +8,7 @@
 
 #include <petscmat.h>
 #include <petscvec.h>
+#include <utility>
 
 namespace dolfinx::nls
 {
@@ -39,6 +40,17 @@ public:
   /// Compute J = F' at current point x
   virtual Mat J(const Vec x) = 0;
 
+  /// Compute F and J = F' at current point x together. It is called
+  /// instead of F and J when both are needed at the same point, and
+  /// can be overloaded to compute them in one assembly loop (see
+  /// fem::assemble_system). The default calls F and then J.
+  /// @return F and J
+  virtual std::pair<Vec, Mat> FJ(const Vec x)
+  {
+    Vec b = F(x);
+    return {b, J(x)};
+  }
+
   /// Compute J_pc used to precondition J. Not implementing this
   /// or leaving P empty results in system matrix A being used
   /// to construct preconditioner.
@@ -18,13 +18,15 @@
 #include <dolfinx/mesh/TopologyComputation.h>
 #include <dolfinx/mesh/utils.h>
 #include <map>
+#include <set>
 #include <vector>
 
 using namespace dolfinx;
 using namespace dolfinx::refinement;
 
 //-----------------------------------------------------------------------------
-ParallelRefinement::ParallelRefinement(const mesh::Mesh& mesh) : _mesh(mesh)
+ParallelRefinement::ParallelRefinement(const mesh::Mesh& mesh)
+    : _mesh(mesh), _shared_edges(0)
 {
   if (!_mesh.topology().connectivity(1, 0))
     throw std::runtime_error("Edges must be initialised");
@@ -57,15 +59,16 @@ ParallelRefinement::ParallelRefinement(const mesh::Mesh& mesh) : _mesh(mesh)
   for (std::size_t i = 0; i < neighbours.size(); ++i)
     proc_to_neighbour.insert({neighbours[i], i});
 
+  std::vector<std::vector<std::int32_t>> edge_neighbours(num_edges);
   for (auto& q : shared_edges)
   {
-    std::set<int> neighbour_set;
     for (int r : q.second)
-      neighbour_set.insert(proc_to_neighbour[r]);
-    _shared_edges.insert({q.first, neighbour_set});
+      edge_neighbours[q.first].push_back(proc_to_neighbour[r]);
   }
+  _shared_edges = graph::AdjacencyList<std::int32_t>(edge_neighbours);
 
   _marked_for_update.resize(neighbours.size());
+  _neighbours = std::move(neighbours);
 }
 //-----------------------------------------------------------------------------
 ParallelRefinement::~ParallelRefinement() { MPI_Comm_free(&_neighbour_comm); }
@@ -88,12 +91,12 @@ bool ParallelRefinement::mark(std::int32_t edge_index)
   _marked_edges[edge_index] = true;
 
   // If it is a shared edge, add all sharing neighbours to update set
-  auto map_it = _shared_edges.find(edge_index);
-  if (map_it != _shared_edges.end())
+  auto neighbours = _shared_edges.links(edge_index);
+  if (neighbours.rows() > 0)
   {
     const std::int64_t global_index = map1->local_to_global(edge_index);
-    for (int p : map_it->second)
-      _marked_for_update[p].push_back(global_index);
+    for (int i = 0; i < neighbours.rows(); ++i)
+      _marked_for_update[neighbours[i]].push_back(global_index);
   }
   return true;
 }
@@ -104,7 +107,7 @@ void ParallelRefinement::mark_all()
   _marked_edges.assign(edge_im->size_local() + edge_im->num_ghosts(), true);
 }
 //-----------------------------------------------------------------------------
-const std::map<std::int32_t, std::int64_t>&
+const std::vector<std::int64_t>&
 ParallelRefinement::edge_to_new_vertex() const
 {
   return _local_edge_to_new_vertex;
@@ -160,6 +163,88 @@ void ParallelRefinement::update_logical_edgefunction()
     _marked_edges[local_index] = true;
 }
 //-----------------------------------------------------------------------------
+std::pair<std::vector<std::int32_t>, bool>
+ParallelRefinement::exchange_marked_edges()
+{
+  // Messages of consecutive exchanges may overlap on slow processes,
+  // so alternate the tag
+  const int tag = _num_exchanges++ % 2;
+
+  // Post synchronous sends of newly marked shared edges (global
+  // index). A send completes once it has been matched by the receiver.
+  std::vector<std::vector<std::int64_t>> send_data;
+  std::vector<MPI_Request> send_requests;
+  for (std::size_t i = 0; i < _marked_for_update.size(); ++i)
+  {
+    if (_marked_for_update[i].empty())
+      continue;
+    send_data.push_back(std::move(_marked_for_update[i]));
+    _marked_for_update[i].clear();
+    send_requests.emplace_back();
+    MPI_Issend(send_data.back().data(), send_data.back().size(), MPI_INT64_T,
+               _neighbours[i], tag, _neighbour_comm, &send_requests.back());
+  }
+
+  // Receive edges until all processes have had their sends matched.
+  // The consensus is a non-blocking reduction, which also tells if any
+  // process sent edges.
+  const int sent = send_requests.empty() ? 0 : 1;
+  int any_sent = 0;
+  MPI_Request consensus = MPI_REQUEST_NULL;
+  bool consensus_started = false;
+  std::vector<std::int64_t> data_recv;
+  while (true)
+  {
+    int flag = 0;
+    MPI_Status status;
+    MPI_Iprobe(MPI_ANY_SOURCE, tag, _neighbour_comm, &flag, &status);
+    if (flag)
+    {
+      int count = 0;
+      MPI_Get_count(&status, MPI_INT64_T, &count);
+      const std::size_t pos = data_recv.size();
+      data_recv.resize(pos + count);
+      MPI_Recv(data_recv.data() + pos, count, MPI_INT64_T, status.MPI_SOURCE,
+               tag, _neighbour_comm, MPI_STATUS_IGNORE);
+    }
+
+    if (!consensus_started)
+    {
+      int sends_done = 0;
+      MPI_Testall(send_requests.size(), send_requests.data(), &sends_done,
+                  MPI_STATUSES_IGNORE);
+      if (sends_done)
+      {
+        MPI_Iallreduce(&sent, &any_sent, 1, MPI_INT, MPI_MAX, _neighbour_comm,
+                       &consensus);
+        consensus_started = true;
+      }
+    }
+    else
+    {
+      int done = 0;
+      MPI_Test(&consensus, &done, MPI_STATUS_IGNORE);
+      if (done)
+        break;
+    }
+  }
+
+  // Mark received edges
+  const std::vector<std::int32_t> local_indices
+      = _mesh.topology().index_map(1)->global_to_local(data_recv);
+  std::vector<std::int32_t> new_marked;
+  for (std::int32_t local_index : local_indices)
+  {
+    if (!_marked_edges[local_index])
+    {
+      _marked_edges[local_index] = true;
+      new_marked.push_back(local_index);
+    }
+  }
+
+  return {std::move(new_marked), any_sent > 0};
+}
+//-----------------------------------------------------------------------------
 void ParallelRefinement::create_new_vertices()
 {
   // Take marked_edges and use to create new vertices
@@ -216,14 +301,14 @@ void ParallelRefinement::create_new_vertices()
   // owned on this process. Index them sequentially from zero.
   // Locally owned edges
 
+  _local_edge_to_new_vertex.assign(num_edges, -1);
   std::int64_t n = 0;
   for (int local_i = 0; local_i < edge_index_map->size_local(); ++local_i)
   {
     if (_marked_edges[local_i] == true)
     {
       _new_vertex_coordinates.row(n + num_vertices) = midpoints.row(local_i);
-      auto it = _local_edge_to_new_vertex.insert({local_i, n});
-      assert(it.second);
+      _local_edge_to_new_vertex[local_i] = n;
       ++n;
     }
   }
@@ -239,23 +324,23 @@ void ParallelRefinement::create_new_vertices()
 
   int num_neighbours = _marked_for_update.size();
   std::vector<std::vector<std::int64_t>> values_to_send(num_neighbours);
-  for (auto& local_edge : _local_edge_to_new_vertex)
+  for (int local_i = 0; local_i < edge_index_map->size_local(); ++local_i)
   {
+    std::int64_t& new_vertex = _local_edge_to_new_vertex[local_i];
+    if (new_vertex < 0)
+      continue;
+
     // Add global_offset to map, to get new global index of new vertices
-    local_edge.second += global_offset;
+    new_vertex += global_offset;
 
-    const std::size_t local_i = local_edge.first;
     // shared, but locally owned : remote owned are not in list.
-    auto shared_edge_i = _shared_edges.find(local_i);
-    if (shared_edge_i != _shared_edges.end())
+    auto remote_processes = _shared_edges.links(local_i);
+    for (int i = 0; i < remote_processes.rows(); ++i)
     {
-      for (int remote_process : shared_edge_i->second)
-      {
-        // send map from global edge index to new global vertex index
-        values_to_send[remote_process].push_back(
-            edge_index_map->local_to_global(local_edge.first));
-        values_to_send[remote_process].push_back(local_edge.second);
-      }
+      // send map from global edge index to new global vertex index
+      values_to_send[remote_processes[i]].push_back(
+          edge_index_map->local_to_global(local_i));
+      values_to_send[remote_processes[i]].push_back(new_vertex);
     }
   }
 
@@ -282,9 +367,8 @@ void ParallelRefinement::create_new_vertices()
       = _mesh.topology().index_map(1)->global_to_local(recv_global_edge);
   for (int i = 0; i < received_values.size() / 2; ++i)
   {
-    auto it = _local_edge_to_new_vertex.insert(
-        {recv_local_edge[i], received_values[i * 2 + 1]});
-    assert(it.second);
+    assert(_local_edge_to_new_vertex[recv_local_edge[i]] == -1);
+    _local_edge_to_new_vertex[recv_local_edge[i]] = received_values[i * 2 + 1];
   }
 
   // Attach global indices to each vertex, old and new, and sort them
@@ -9,8 +9,8 @@
 #include <Eigen/Dense>
 #include <cstdint>
 #include <dolfinx/common/MPI.h>
-#include <map>
-#include <set>
+#include <dolfinx/graph/AdjacencyList.h>
+#include <utility>
 #include <vector>
 
 namespace dolfinx
@@ -67,6 +67,17 @@ public:
   /// Transfer marked edges between processes
   void update_logical_edgefunction();
 
+  /// Send shared edges that have been marked since the last exchange
+  /// to the neighbouring processes that share them, and mark the edges
+  /// received from neighbours. Only processes with newly marked
+  /// shared edges send messages, and completion is detected with a
+  /// non-blocking consensus, i.e. a single non-blocking collective
+  /// per exchange.
+  /// @return Local indices of the edges that have been newly marked by
+  ///   neighbours, and a flag that is true if any process sent marked
+  ///   edges in this exchange
+  std::pair<std::vector<std::int32_t>, bool> exchange_marked_edges();
+
   /// Add new vertex for each marked edge, and create
   /// new_vertex_coordinates and global_edge->new_vertex map.
   /// Communicate new vertices with MPI to all affected processes.
@@ -74,7 +85,9 @@ public:
 
   /// Mapping of old edge (to be removed) to new global vertex number.
   /// Useful for forming new topology
-  const std::map<std::int32_t, std::int64_t>& edge_to_new_vertex() const;
+  /// @return New global vertex index for each local edge (-1 if the
+  ///   edge is not marked)
+  const std::vector<std::int64_t>& edge_to_new_vertex() const;
 
   /// Add new cells with vertex indices
   /// @param[in] idx
@@ -93,9 +106,9 @@ private:
   // mesh::Mesh reference
   const mesh::Mesh& _mesh;
 
-  // Mapping from old local edge index to new global vertex, needed to
-  // create new topology
-  std::map<std::int32_t, std::int64_t> _local_edge_to_new_vertex;
+  // Mapping from old local edge index to new global vertex (-1 for
+  // unmarked edges), needed to create new topology
+  std::vector<std::int64_t> _local_edge_to_new_vertex;
 
   // New storage for all coordinates when creating new vertices
   Eigen::Array<double, Eigen::Dynamic, 3, Eigen::RowMajor>
@@ -111,11 +124,19 @@ private:
   // index)
   std::vector<std::vector<std::int64_t>> _marked_for_update;
 
-  // Shared edges between processes
-  std::map<std::int32_t, std::set<std::int32_t>> _shared_edges;
+  // Shared edges between processes: for each local edge, the indices
+  // of the neighbours (in the neighbourhood communicator) that share it
+  graph::AdjacencyList<std::int32_t> _shared_edges;
 
   // Neighbourhood communicator
   MPI_Comm _neighbour_comm;
+
+  // Ranks of the neighbouring processes
+  std::vector<int> _neighbours;
+
+  // Number of calls to exchange_marked_edges (used to alternate the
+  // message tag between consecutive exchanges)
+  int _num_exchanges = 0;
 };
 } // namespace refinement
 } // namespace dolfinx
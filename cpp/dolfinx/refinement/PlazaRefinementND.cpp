@@ -21,58 +21,59 @@ using namespace dolfinx::refinement;
 namespace
 {
 // Propagate edge markers according to rules (longest edge of each
-// face must be marked, if any edge of face is marked)
+// face must be marked, if any edge of face is marked). Marks are
+// propagated locally from a worklist of marked edges, and only newly
+// marked shared edges are exchanged with neighbouring processes.
 void enforce_rules(ParallelRefinement& p_ref, const mesh::Mesh& mesh,
                    const std::vector<std::int32_t>& long_edge)
 {
   common::Timer t0("PLAZA: Enforce rules");
 
-  // Enforce rule, that if any edge of a face is marked, longest edge
-  // must also be marked
-
-  auto map_f = mesh.topology().index_map(2);
-  assert(map_f);
-  const std::int32_t num_faces = map_f->size_local() + map_f->num_ghosts();
-
-  auto f_to_e = mesh.topology().connectivity(2, 1);
-  assert(f_to_e);
+  mesh.topology_mutable().create_connectivity(1, 2);
+  auto e_to_f = mesh.topology().connectivity(1, 2);
+  assert(e_to_f);
 
+  // Start from all marked edges
   const std::vector<bool>& marked_edges = p_ref.marked_edges();
-  std::int32_t update_count = 1;
-  while (update_count > 0)
+  std::vector<std::int32_t> worklist;
+  for (std::size_t e = 0; e < marked_edges.size(); ++e)
+    if (marked_edges[e])
+      worklist.push_back(e);
+
+  while (true)
   {
-    update_count = 0;
-    p_ref.update_logical_edgefunction();
-    for (int f = 0; f < num_faces; ++f)
+    // Enforce rule, that if any edge of a face is marked, longest edge
+    // must also be marked
+    while (!worklist.empty())
     {
-      const std::int32_t long_e = long_edge[f];
-      if (marked_edges[long_e])
-        continue;
-
-      bool any_marked = false;
-      auto edges = f_to_e->links(f);
-      for (int i = 0; i < edges.rows(); ++i)
-        any_marked = any_marked or marked_edges[edges[i]];
-
-      if (any_marked)
+      const std::int32_t e = worklist.back();
+      worklist.pop_back();
+      auto faces = e_to_f->links(e);
+      for (int i = 0; i < faces.rows(); ++i)
       {
-        p_ref.mark(long_e);
-        ++update_count;
+        const std::int32_t long_e = long_edge[faces[i]];
+        if (p_ref.mark(long_e))
+          worklist.push_back(long_e);
       }
     }
 
-    // FIXME: MPI call inside loop is bad. How big can loop be?
-    const std::int32_t update_count_old = update_count;
-    MPI_Allreduce(&update_count_old, &update_count, 1, MPI_INT32_T, MPI_SUM,
-                  mesh.mpi_comm());
+    // Exchange newly marked shared edges. Propagation is complete when
+    // no process has sent any edges.
+    auto [received, any_sent] = p_ref.exchange_marked_edges();
+    if (!any_sent)
+      break;
+    worklist = std::move(received);
   }
 }
 //-----------------------------------------------------------------------------
-// Convenient interface for both uniform and marker refinement
-mesh::Mesh compute_refinement(const mesh::Mesh& mesh, ParallelRefinement& p_ref,
-                              const std::vector<std::int32_t>& long_edge,
-                              const std::vector<bool>& edge_ratio_ok,
-                              bool redistribute)
+// Convenient interface for both uniform and marker refinement. Also
+// returns the parent (local index in the input mesh) of each cell of
+// the refined mesh. The map is empty if the refined mesh has been
+// redistributed.
+std::pair<mesh::Mesh, std::vector<std::int32_t>>
+compute_refinement(const mesh::Mesh& mesh, ParallelRefinement& p_ref,
+                   const std::vector<std::int32_t>& long_edge,
+                   const std::vector<bool>& edge_ratio_ok, bool redistribute)
 {
   const std::int32_t tdim = mesh.topology().dim();
   const std::int32_t num_cell_edges = tdim * 3 - 3;
@@ -80,10 +81,10 @@ mesh::Mesh compute_refinement(const mesh::Mesh& mesh, ParallelRefinement& p_ref,
 
   // Make new vertices in parallel
   p_ref.create_new_vertices();
-  const std::map<std::int32_t, std::int64_t>& new_vertex_map
+  const std::vector<std::int64_t>& new_vertex_map
       = p_ref.edge_to_new_vertex();
 
-  std::vector<std::size_t> parent_cell;
+  std::vector<std::int32_t> parent_cell;
   std::vector<std::int64_t> indices(num_cell_vertices + num_cell_edges);
   std::vector<int> marked_edge_list;
   std::vector<std::int32_t> simplex_set;
@@ -137,9 +138,8 @@ mesh::Mesh compute_refinement(const mesh::Mesh& mesh, ParallelRefinement& p_ref,
       for (int p : marked_edge_list)
       {
         markers[p] = true;
-        auto it = new_vertex_map.find(edges[p]);
-        assert(it != new_vertex_map.end());
-        indices[num_cell_vertices + p] = it->second;
+        assert(new_vertex_map[edges[p]] >= 0);
+        indices[num_cell_vertices + p] = new_vertex_map[edges[p]];
       }
 
       // Need longest edges of each face in cell local indexing
@@ -182,11 +182,15 @@ mesh::Mesh compute_refinement(const mesh::Mesh& mesh, ParallelRefinement& p_ref,
     }
   }
 
+  // New cells keep the order in which they were created, unless they
+  // are redistributed
   const bool serial = (dolfinx::MPI::size(mesh.mpi_comm()) == 1);
   if (serial)
-    return p_ref.build_local();
+    return {p_ref.build_local(), std::move(parent_cell)};
+  else if (redistribute)
+    return {p_ref.partition(true), std::vector<std::int32_t>()};
   else
-    return p_ref.partition(redistribute);
+    return {p_ref.partition(false), std::move(parent_cell)};
 }
 //-----------------------------------------------------------------------------
 // 2D version of subdivision allowing for uniform subdivision (flag)
@@ -460,7 +464,8 @@ mesh::Mesh PlazaRefinementND::refine(const mesh::Mesh& mesh, bool redistribute)
   p_ref.mark_all();
 
   return compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok,
-                            redistribute);
+                            redistribute)
+      .first;
 }
 //-----------------------------------------------------------------------------
 mesh::Mesh
@@ -483,7 +488,48 @@ PlazaRefinementND::refine(const mesh::Mesh& mesh,
   enforce_rules(p_ref, mesh, long_edge);
 
   return compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok,
-                            redistribute);
+                            redistribute)
+      .first;
+}
+//-----------------------------------------------------------------------------
+std::pair<mesh::Mesh, std::vector<std::int32_t>>
+PlazaRefinementND::refine_with_parent_cells(const mesh::Mesh& mesh)
+{
+  if (mesh.topology().cell_type() != mesh::CellType::triangle
+      and mesh.topology().cell_type() != mesh::CellType::tetrahedron)
+  {
+    throw std::runtime_error("Cell type not supported");
+  }
+
+  common::Timer t0("PLAZA: refine");
+  const auto [long_edge, edge_ratio_ok] = face_long_edge(mesh);
+
+  ParallelRefinement p_ref(mesh);
+  p_ref.mark_all();
+
+  return compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok, false);
+}
+//-----------------------------------------------------------------------------
+std::pair<mesh::Mesh, std::vector<std::int32_t>>
+PlazaRefinementND::refine_with_parent_cells(
+    const mesh::Mesh& mesh,
+    const mesh::MeshTags<std::int8_t>& refinement_marker)
+{
+  if (mesh.topology().cell_type() != mesh::CellType::triangle
+      and mesh.topology().cell_type() != mesh::CellType::tetrahedron)
+  {
+    throw std::runtime_error("Cell type not supported");
+  }
+
+  common::Timer t0("PLAZA: refine");
+  const auto [long_edge, edge_ratio_ok] = face_long_edge(mesh);
+
+  ParallelRefinement p_ref(mesh);
+  p_ref.mark(refinement_marker);
+
+  enforce_rules(p_ref, mesh, long_edge);
+
+  return compute_refinement(mesh, p_ref, long_edge, edge_ratio_ok, false);
 }
 //-----------------------------------------------------------------------------
 std::vector<std::int32_t>
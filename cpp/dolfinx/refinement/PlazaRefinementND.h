@@ -53,6 +53,29 @@ public:
                            const mesh::MeshTags<std::int8_t>& refinement_marker,
                            bool redistribute);
 
+  /// Uniform refine without redistribution, and compute the parent
+  /// cell of each cell in the refined mesh
+  ///
+  /// @param[in] mesh Input mesh to be refined
+  /// @return New mesh, and the (process-local) index in @p mesh of the
+  ///   parent of each (process-local) cell in the new mesh
+  static std::pair<mesh::Mesh, std::vector<std::int32_t>>
+  refine_with_parent_cells(const mesh::Mesh& mesh);
+
+  /// Refine with markers without redistribution, and compute the
+  /// parent cell of each cell in the refined mesh
+  ///
+  /// @param[in] mesh Input mesh to be refined
+  /// @param[in] refinement_marker MeshTags listing mesh entities
+  ///   which should be split by this refinement. Value == 1 means
+  ///   "refine", any other value means "do not refine".
+  /// @return New mesh, and the (process-local) index in @p mesh of the
+  ///   parent of each (process-local) cell in the new mesh
+  static std::pair<mesh::Mesh, std::vector<std::int32_t>>
+  refine_with_parent_cells(
+      const mesh::Mesh& mesh,
+      const mesh::MeshTags<std::int8_t>& refinement_marker);
+
   /// Get the subdivision of an original simplex into smaller simplices,
   /// for a given set of marked edges, and the longest edge of each
   /// facet (cell local indexing). A flag indicates if a uniform
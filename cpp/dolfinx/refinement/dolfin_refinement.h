@@ -12,4 +12,5 @@ namespace dolfinx
 
 // DOLFINX refinement interface
 
+#include <dolfinx/refinement/marking.h>
 #include <dolfinx/refinement/refine.h>
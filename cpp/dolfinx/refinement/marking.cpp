@@ -0,0 +1,168 @@
+// Copyright (C) 2020 agent
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#include "marking.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <dolfinx/common/IndexMap.h>
+#include <dolfinx/common/MPI.h>
+#include <dolfinx/common/Timer.h>
+#include <dolfinx/fem/DofMap.h>
+#include <dolfinx/fem/FiniteElement.h>
+#include <dolfinx/function/Function.h>
+#include <dolfinx/function/FunctionSpace.h>
+#include <dolfinx/la/PETScVector.h>
+#include <dolfinx/la/utils.h>
+#include <dolfinx/mesh/Mesh.h>
+#include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/mesh/Topology.h>
+#include <limits>
+#include <vector>
+
+using namespace dolfinx;
+
+namespace
+{
+// Number of histogram bins per threshold search iteration
+constexpr int num_bins = 64;
+
+// Maximum number of threshold search iterations
+constexpr int max_iterations = 20;
+} // namespace
+
+//-----------------------------------------------------------------------------
+mesh::MeshTags<std::int8_t>
+refinement::mark_dorfler(const function::Function& eta, double theta)
+{
+  common::Timer timer("Dorfler marking");
+
+  if (theta < 0.0 or theta > 1.0)
+    throw std::runtime_error("Dorfler parameter must be in [0, 1].");
+
+  auto V = eta.function_space();
+  assert(V);
+  assert(V->element());
+  if (V->element()->space_dimension() != 1
+      or V->element()->value_size() != 1)
+  {
+    throw std::runtime_error(
+        "Dorfler marking requires a cellwise constant scalar indicator.");
+  }
+
+  std::shared_ptr<const mesh::Mesh> mesh = V->mesh();
+  assert(mesh);
+  MPI_Comm comm = mesh->mpi_comm();
+  const int tdim = mesh->topology().dim();
+  auto map = mesh->topology().index_map(tdim);
+  assert(map);
+  const std::int32_t num_cells = map->size_local();
+
+  // Get indicator value of each owned cell
+  assert(V->dofmap());
+  const fem::DofMap& dofmap = *V->dofmap();
+  std::vector<double> values(num_cells);
+  {
+    la::VecReadWrapper v(eta.vector().vec());
+    for (std::int32_t c = 0; c < num_cells; ++c)
+      values[c] = std::real(v.x[dofmap.cell_dofs(c)[0]]);
+  }
+
+  // Global range and sum of the indicator
+  std::array<double, 2> range_local
+      = {-std::numeric_limits<double>::max(),
+         -std::numeric_limits<double>::max()};
+  double sum_local = 0.0;
+  for (double e : values)
+  {
+    range_local[0] = std::max(range_local[0], -e);
+    range_local[1] = std::max(range_local[1], e);
+    sum_local += e;
+  }
+  std::array<double, 2> range;
+  MPI_Allreduce(range_local.data(), range.data(), 2, MPI_DOUBLE, MPI_MAX,
+                comm);
+  double total = 0.0;
+  MPI_Allreduce(&sum_local, &total, 1, MPI_DOUBLE, MPI_SUM, comm);
+
+  // Search for the largest threshold t such that the sum of the values
+  // >= t reaches theta * total. Each value is above the threshold (1),
+  // below it (-1) or still undecided (0). Undecided values lie in
+  // [lo, hi], and the sum of the values above the threshold is less
+  // than the target.
+  const double target = theta * total;
+  double lo = -range[0];
+  double hi = range[1];
+  double sum_above = 0.0;
+  std::vector<std::int8_t> state(num_cells, 0);
+  std::vector<double> hist_local(2 * num_bins), hist(2 * num_bins);
+  for (int it = 0; it < max_iterations; ++it)
+  {
+    const double width = (hi - lo) / num_bins;
+    const double scale = std::max(std::abs(lo), std::abs(hi));
+    if (!(width > std::numeric_limits<double>::epsilon() * scale))
+      break;
+    auto get_bin = [lo, width](double e) {
+      return std::clamp(int((e - lo) / width), 0, num_bins - 1);
+    };
+
+    // Local sum and number of undecided values in each bin
+    std::fill(hist_local.begin(), hist_local.end(), 0.0);
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      if (state[c] == 0)
+      {
+        const int bin = get_bin(values[c]);
+        hist_local[bin] += values[c];
+        hist_local[num_bins + bin] += 1.0;
+      }
+    }
+    MPI_Allreduce(hist_local.data(), hist.data(), hist.size(), MPI_DOUBLE,
+                  MPI_SUM, comm);
+
+    // Find bin, from the top, in which the target is reached
+    int bin = num_bins - 1;
+    for (; bin > 0; --bin)
+    {
+      if (sum_above + hist[bin] >= target)
+        break;
+      sum_above += hist[bin];
+    }
+
+    // Values in bins above are marked, and values in bins below are not
+    for (std::int32_t c = 0; c < num_cells; ++c)
+    {
+      if (state[c] == 0)
+      {
+        const int b = get_bin(values[c]);
+        if (b > bin)
+          state[c] = 1;
+        else if (b < bin)
+          state[c] = -1;
+      }
+    }
+
+    // Narrow the search to the bin, and stop once it holds at most one
+    // value
+    hi = lo + (bin + 1) * width;
+    lo = lo + bin * width;
+    if (hist[num_bins + bin] <= 1.0)
+      break;
+  }
+
+  // Mark cells above the threshold, and the undecided cells at the
+  // threshold
+  std::vector<std::int32_t> indices;
+  for (std::int32_t c = 0; c < num_cells; ++c)
+    if (state[c] >= 0)
+      indices.push_back(c);
+
+  std::vector<std::int8_t> markers(indices.size(), 1);
+  return mesh::MeshTags<std::int8_t>(mesh, tdim, std::move(indices),
+                                     std::move(markers));
+}
+//-----------------------------------------------------------------------------
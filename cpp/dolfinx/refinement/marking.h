@@ -0,0 +1,48 @@
+// Copyright (C) 2020 agent
+//
+// This file is part of DOLFINX (https://www.fenicsproject.org)
+//
+// SPDX-License-Identifier:    LGPL-3.0-or-later
+
+#pragma once
+
+#include <cstdint>
+
+namespace dolfinx
+{
+
+namespace function
+{
+class Function;
+}
+
+namespace mesh
+{
+template <typename T>
+class MeshTags;
+} // namespace mesh
+
+namespace refinement
+{
+
+/// Mark cells for refinement with the Dörfler (bulk) criterion: mark a
+/// set M of cells with the largest indicator values such that
+/// sum_{T in M} eta_T >= theta sum_T eta_T.
+///
+/// The threshold is found by a distributed histogram search over the
+/// indicator values, with one reduction of the histogram per
+/// iteration, so indicator values are never gathered. Cells with an
+/// indicator equal (up to round-off) to the threshold are all marked,
+/// so the marked set may be slightly larger than the minimal set.
+///
+/// @param[in] eta Cellwise (DG0) error indicator. The values are summed
+///   as given, i.e. for the usual criterion on squared errors pass the
+///   squared indicators.
+/// @param[in] theta Bulk parameter, 0 <= theta <= 1
+/// @return Cell tags with value 1 for the cells to refine, which can be
+///   passed to refinement::refine
+mesh::MeshTags<std::int8_t> mark_dorfler(const function::Function& eta,
+                                         double theta);
+
+} // namespace refinement
+} // namespace dolfinx
@@ -61,3 +61,28 @@ dolfinx::refinement::refine(const mesh::Mesh& mesh,
   return refined_mesh;
 }
 //-----------------------------------------------------------------------------
+std::pair<mesh::Mesh, std::vector<std::int32_t>>
+dolfinx::refinement::refine_with_parent_cells(const mesh::Mesh& mesh)
+{
+  if (mesh.topology().cell_type() != mesh::CellType::triangle
+      and mesh.topology().cell_type() != mesh::CellType::tetrahedron)
+  {
+    throw std::runtime_error("Refinement only defined for simplices");
+  }
+
+  return PlazaRefinementND::refine_with_parent_cells(mesh);
+}
+//-----------------------------------------------------------------------------
+std::pair<mesh::Mesh, std::vector<std::int32_t>>
+dolfinx::refinement::refine_with_parent_cells(
+    const mesh::Mesh& mesh, const mesh::MeshTags<std::int8_t>& cell_markers)
+{
+  if (mesh.topology().cell_type() != mesh::CellType::triangle
+      and mesh.topology().cell_type() != mesh::CellType::tetrahedron)
+  {
+    throw std::runtime_error("Refinement only defined for simplices");
+  }
+
+  return PlazaRefinementND::refine_with_parent_cells(mesh, cell_markers);
+}
+//-----------------------------------------------------------------------------
@@ -7,6 +7,8 @@
 #pragma once
 
 #include <cstdint>
+#include <utility>
+#include <vector>
 
 namespace dolfinx
 {
@@ -43,5 +45,31 @@ mesh::Mesh refine(const mesh::Mesh& mesh,
                   const mesh::MeshTags<std::int8_t>& cell_markers,
                   bool redistribute = true);
 
+/// Create uniformly refined mesh, and compute the parent cell of each
+/// cell in the refined mesh. The refined mesh is not redistributed,
+/// so that each cell and its parent are on the same process. The
+/// parent-child relation can be used to build transfer operators
+/// between nested meshes, e.g. for geometric multigrid.
+///
+/// @param[in] mesh The mesh from which to build a refined Mesh
+/// @return A refined mesh, and the (process-local) index in @p mesh of
+///     the parent of each (process-local) cell in the refined mesh
+std::pair<mesh::Mesh, std::vector<std::int32_t>>
+refine_with_parent_cells(const mesh::Mesh& mesh);
+
+/// Create locally refined mesh, and compute the parent cell of each
+/// cell in the refined mesh. The refined mesh is not redistributed.
+///
+/// @param[in] mesh The mesh from which to build a refined Mesh
+/// @param[in] cell_markers A mesh function over integers specifying
+///     which cells should be refined (value == 1) (and which should not
+///     (any other integer value)).
+/// @return A locally refined mesh, and the (process-local) index in
+///     @p mesh of the parent of each (process-local) cell in the
+///     refined mesh
+std::pair<mesh::Mesh, std::vector<std::int32_t>>
+refine_with_parent_cells(const mesh::Mesh& mesh,
+                         const mesh::MeshTags<std::int8_t>& cell_markers);
+
 } // namespace refinement
 } // namespace dolfinx
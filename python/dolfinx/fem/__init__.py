@@ -8,10 +8,11 @@
 
 from dolfinx.fem.assemble import (create_vector, create_vector_block, create_vector_nest,
                                   create_matrix, create_matrix_block, create_matrix_nest,
+                                  create_prolongation_matrix,
                                   assemble_scalar,
                                   assemble_vector, assemble_vector_nest, assemble_vector_block,
                                   assemble_matrix, assemble_matrix_nest, assemble_matrix_block,
-                                  assemble_csr_matrix,
+                                  assemble_csr_matrix, assemble_system,
                                   set_bc, set_bc_nest,
                                   apply_lifting, apply_lifting_nest)
 from dolfinx.fem.coordinatemapping import create_coordinate_map
@@ -26,11 +27,11 @@ from dolfinx.fem.dirichletbc import locate_dofs_geometrical, locate_dofs_topolog
 
 __all__ = [
     "create_vector", "create_vector_block", "create_vector_nest",
-    "create_matrix", "create_matrix_block", "create_matrix_nest",
+    "create_matrix", "create_matrix_block", "create_matrix_nest", "create_prolongation_matrix",
     "apply_lifting", "apply_lifting_nest", "assemble_scalar", "assemble_vector",
     "assemble_vector_block", "assemble_vector_nest",
     "assemble_matrix_block", "assemble_matrix_nest",
-    "assemble_matrix", "assemble_csr_matrix", "set_bc", "set_bc_nest", "create_coordinate_map",
+    "assemble_matrix", "assemble_csr_matrix", "assemble_system", "set_bc", "set_bc_nest", "create_coordinate_map",
     "DirichletBC", "DofMap", "Form", "FormIntegrals",
     "derivative", "adjoint", "increase_order",
     "tear", "project", "solve", "locate_dofs_geometrical", "locate_dofs_topological"
@@ -11,7 +11,7 @@ import typing
 from petsc4py import PETSc
 
 import ufl
-from dolfinx import cpp
+from dolfinx import cpp, function
 from dolfinx.fem.dirichletbc import DirichletBC
 from dolfinx.fem.form import Form
 
@@ -61,6 +61,15 @@ def create_matrix_nest(a: typing.List[typing.List[typing.Union[Form, cpp.fem.For
     return cpp.fem.create_matrix_nest(_create_cpp_form(a))
 
 
+def create_prolongation_matrix(V0: function.FunctionSpace, V1: function.FunctionSpace,
+                               parent_cells: typing.List[int]) -> PETSc.Mat:
+    """Create the prolongation matrix from a function space on a coarse
+    mesh to a function space on a refined mesh, given the parent cell of
+    each refined cell (see ``dolfinx.mesh.refine_with_parent_cells``).
+    The restriction matrix is the transpose."""
+    return cpp.fem.create_prolongation_matrix(V0._cpp_object, V1._cpp_object, parent_cells)
+
+
 # -- Scalar assembly ---------------------------------------------------------
 
 
@@ -90,13 +99,28 @@ def assemble_vector(L: typing.Union[Form, cpp.fem.Form]) -> PETSc.Vec:
 
 
 @assemble_vector.register(PETSc.Vec)
-def _(b: PETSc.Vec, L: typing.Union[Form, cpp.fem.Form]) -> PETSc.Vec:
+def _(b: PETSc.Vec, L: typing.Union[Form, cpp.fem.Form],
+      a: typing.Optional[typing.Union[Form, cpp.fem.Form]] = None,
+      bcs: typing.List[DirichletBC] = [],
+      x0: typing.Optional[PETSc.Vec] = None,
+      scale: float = 1.0) -> PETSc.Vec:
     """Assemble linear form into an existing PETSc vector. The vector is not
     zeroed before assembly and it is not finalised, qi.e. ghost values are
     not accumulated on the owning processes.
 
+    If the bilinear form a is supplied, the lifting of the boundary
+    conditions bcs is applied in the same loop over cells, ghost
+    contributions are accumulated on the owning processes and boundary
+    condition values are set. This is equivalent to calling
+    ``apply_lifting(b, [a], [bcs], [x0], scale)``,
+    ``b.ghostUpdate(ADD, REVERSE)`` and ``set_bc(b, bcs, x0, scale)``
+    after assembly.
+
     """
-    cpp.fem.assemble_vector(b, _create_cpp_form(L))
+    if a is None:
+        cpp.fem.assemble_vector(b, _create_cpp_form(L))
+    else:
+        cpp.fem.assemble_vector(b, _create_cpp_form(L), _create_cpp_form(a), bcs, x0, scale)
     return b
 
 
@@ -290,6 +314,48 @@ def _(A: PETSc.Mat,
     return A
 
 
+# -- System assembly ---------------------------------------------------------
+
+@functools.singledispatch
+def assemble_system(a: typing.Union[Form, cpp.fem.Form],
+                    L: typing.Union[Form, cpp.fem.Form],
+                    bcs: typing.List[DirichletBC] = [],
+                    x0: typing.Optional[PETSc.Vec] = None,
+                    scale: float = 1.0) -> typing.Tuple[PETSc.Mat, PETSc.Vec]:
+    """Assemble bilinear and linear forms into a new matrix and vector,
+    with boundary conditions applied symmetrically. Contributions to
+    the matrix and the vector are computed in one loop over cells. The
+    returned matrix is not finalised. Ghost contributions to the vector
+    are accumulated and boundary condition values are set.
+
+    """
+    _a, _L = _create_cpp_form(a), _create_cpp_form(L)
+    A = cpp.fem.create_matrix(_a)
+    A.zeroEntries()
+    b = cpp.la.create_vector(_L.function_space(0).dofmap.index_map)
+    with b.localForm() as b_local:
+        b_local.set(0.0)
+    return assemble_system(A, b, _a, _L, bcs, x0, scale)
+
+
+@assemble_system.register(PETSc.Mat)
+def _(A: PETSc.Mat,
+      b: PETSc.Vec,
+      a: typing.Union[Form, cpp.fem.Form],
+      L: typing.Union[Form, cpp.fem.Form],
+      bcs: typing.List[DirichletBC] = [],
+      x0: typing.Optional[PETSc.Vec] = None,
+      scale: float = 1.0) -> typing.Tuple[PETSc.Mat, PETSc.Vec]:
+    """Assemble bilinear and linear forms into an existing matrix and
+    vector, with boundary conditions applied symmetrically. The matrix
+    and vector are not zeroed before assembly and the matrix is not
+    finalised.
+
+    """
+    cpp.fem.assemble_system(A, b, _create_cpp_form(a), _create_cpp_form(L), bcs, x0, scale)
+    return A, b
+
+
 # -- Modifiers for Dirichlet conditions ---------------------------------------
 
 def apply_lifting(b: PETSc.Vec,
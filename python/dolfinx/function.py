@@ -139,12 +139,18 @@ class Function(ufl.Coefficient):
             u = np.reshape(u, (-1, ))
         return u
 
-    def interpolate(self, u) -> None:
-        """Interpolate an expression"""
+    def interpolate(self, u, evaluator=None) -> None:
+        """Interpolate an expression. If u is a Function on a different
+        mesh, evaluator can be a cpp.function.PointEvaluator created on
+        the mesh of u for the dof coordinates of this Function, to be
+        reused for repeated interpolation."""
         @singledispatch
         def _interpolate(u):
             try:
-                self._cpp_object.interpolate(u._cpp_object)
+                if evaluator is None:
+                    self._cpp_object.interpolate(u._cpp_object)
+                else:
+                    self._cpp_object.interpolate(u._cpp_object, evaluator)
             except AttributeError:
                 self._cpp_object.interpolate(u)
 
@@ -55,7 +55,7 @@ def UnitIntervalMesh(comm, nx, ghost_mode=cpp.mesh.GhostMode.none):
 
 
 def RectangleMesh(comm, points: typing.List[numpy.array], n: list, cell_type=cpp.mesh.CellType.triangle,
-                  ghost_mode=cpp.mesh.GhostMode.none, diagonal: str = "right"):
+                  ghost_mode=cpp.mesh.GhostMode.none, diagonal: str = "right", structured: bool = False):
     """Create rectangle mesh
 
     Parameters
@@ -68,18 +68,24 @@ def RectangleMesh(comm, points: typing.List[numpy.array], n: list, cell_type=cpp
         List of number of cells in each direction
     diagonal
         Direction of diagonal
+    structured
+        If True, each process creates its own block of cells of a
+        Cartesian process grid, without graph partitioning
 
     """
     domain = ufl.Mesh(ufl.VectorElement("Lagrange", cpp.mesh.to_string(cell_type), 1))
     cmap = fem.create_coordinate_map(domain)
-    mesh = cpp.generation.RectangleMesh.create(comm, points, n, cmap, ghost_mode, diagonal)
+    if structured:
+        mesh = cpp.generation.RectangleMesh.create_structured(comm, points, n, cmap, ghost_mode, diagonal)
+    else:
+        mesh = cpp.generation.RectangleMesh.create(comm, points, n, cmap, ghost_mode, diagonal)
     domain._ufl_cargo = mesh
     mesh._ufl_domain = domain
     return mesh
 
 
 def UnitSquareMesh(comm, nx, ny, cell_type=cpp.mesh.CellType.triangle,
-                   ghost_mode=cpp.mesh.GhostMode.none, diagonal="right"):
+                   ghost_mode=cpp.mesh.GhostMode.none, diagonal="right", structured=False):
     """Create a mesh of a unit square
 
     Parameters
@@ -92,18 +98,21 @@ def UnitSquareMesh(comm, nx, ny, cell_type=cpp.mesh.CellType.triangle,
         Number of cells in "y" direction
     diagonal
         Direction of diagonal
+    structured
+        If True, create the mesh without graph partitioning
 
     """
     return RectangleMesh(comm, [numpy.array([0.0, 0.0, 0.0]),
                                 numpy.array([1.0, 1.0, 0.0])], [nx, ny], cell_type, ghost_mode,
-                         diagonal)
+                         diagonal, structured)
 
 
 def BoxMesh(comm,
             points: typing.List[numpy.array],
             n: list,
             cell_type=cpp.mesh.CellType.tetrahedron,
-            ghost_mode=cpp.mesh.GhostMode.none):
+            ghost_mode=cpp.mesh.GhostMode.none,
+            structured: bool = False):
     """Create box mesh
 
     Parameters
@@ -114,18 +123,24 @@ def BoxMesh(comm,
         List of points representing vertices
     n
         List of cells in each direction
+    structured
+        If True, each process creates its own block of cells of a
+        Cartesian process grid, without graph partitioning
 
     """
     domain = ufl.Mesh(ufl.VectorElement("Lagrange", cpp.mesh.to_string(cell_type), 1))
     cmap = fem.create_coordinate_map(domain)
-    mesh = cpp.generation.BoxMesh.create(comm, points, n, cmap, ghost_mode)
+    if structured:
+        mesh = cpp.generation.BoxMesh.create_structured(comm, points, n, cmap, ghost_mode)
+    else:
+        mesh = cpp.generation.BoxMesh.create(comm, points, n, cmap, ghost_mode)
     domain._ufl_cargo = mesh
     mesh._ufl_domain = domain
     return mesh
 
 
 def UnitCubeMesh(comm, nx, ny, nz, cell_type=cpp.mesh.CellType.tetrahedron,
-                 ghost_mode=cpp.mesh.GhostMode.none):
+                 ghost_mode=cpp.mesh.GhostMode.none, structured=False):
     """Create a mesh of a unit cube
 
     Parameters
@@ -138,7 +153,9 @@ def UnitCubeMesh(comm, nx, ny, nz, cell_type=cpp.mesh.CellType.tetrahedron,
         Number of cells in "y" direction
     nz
         Number of cells in "z" direction
+    structured
+        If True, create the mesh without graph partitioning
 
     """
     return BoxMesh(comm, [numpy.array([0.0, 0.0, 0.0]), numpy.array(
-        [1.0, 1.0, 1.0])], [nx, ny, nz], cell_type, ghost_mode)
+        [1.0, 1.0, 1.0])], [nx, ny, nz], cell_type, ghost_mode, structured)
@@ -22,25 +22,38 @@ class BoundingBoxTree:
         """Print for debugging"""
         return self._cpp_object.str()
 
+    def refit(self, mesh, rebuild_ratio=0.0):
+        """Recompute bounding boxes from the current mesh geometry,
+        keeping the tree structure. If rebuild_ratio is positive, the
+        tree is rebuilt when its cost ratio exceeds rebuild_ratio.
+        Returns True if the tree was rebuilt."""
+        return self._cpp_object.refit(mesh, rebuild_ratio)
 
-def compute_first_collision(tree: BoundingBoxTree, x):
+    def cost_ratio(self):
+        """Quality of the tree relative to when it was built (one for a
+        newly built tree, larger when boxes overlap more)"""
+        return self._cpp_object.cost_ratio()
+
+
+def compute_first_collision(tree: BoundingBoxTree, x, num_threads=1):
     """Compute first collision with the points"""
-    return cpp.geometry.compute_first_collision(tree._cpp_object, x)
+    return cpp.geometry.compute_first_collision(tree._cpp_object, x, num_threads)
 
 
-def compute_first_entity_collision(tree: BoundingBoxTree, mesh, x):
+def compute_first_entity_collision(tree: BoundingBoxTree, mesh, x, num_threads=1):
     """Compute fist collision between entities of mesh and the point"""
-    return cpp.geometry.compute_first_entity_collision(tree._cpp_object, mesh, x)
+    return cpp.geometry.compute_first_entity_collision(tree._cpp_object, mesh, x, num_threads)
 
 
-def compute_closest_entity(tree: BoundingBoxTree, tree_midpoint, mesh, x):
+def compute_closest_entity(tree: BoundingBoxTree, tree_midpoint, mesh, x, num_threads=1):
     """Compute closest entity of the mesh to the point"""
-    return cpp.geometry.compute_closest_entity(tree._cpp_object, tree_midpoint._cpp_object, mesh, x)
+    return cpp.geometry.compute_closest_entity(tree._cpp_object, tree_midpoint._cpp_object, mesh, x, num_threads)
 
 
-def compute_collisions_point(tree: BoundingBoxTree, x):
-    """Compute collisions with the point"""
-    return cpp.geometry.compute_collisions_point(tree._cpp_object, x)
+def compute_collisions_point(tree: BoundingBoxTree, x, num_threads=1):
+    """Compute collisions with the points. Returns (entities, offsets),
+    where the collisions of point i are entities[offsets[i]:offsets[i + 1]]"""
+    return cpp.geometry.compute_collisions_point(tree._cpp_object, x, num_threads)
 
 
 def compute_collisions_bb(tree0: BoundingBoxTree, tree1: BoundingBoxTree):
@@ -48,9 +61,30 @@ def compute_collisions_bb(tree0: BoundingBoxTree, tree1: BoundingBoxTree):
     return cpp.geometry.compute_collisions(tree0._cpp_object, tree1._cpp_object)
 
 
-def compute_entity_collisions_mesh(tree: BoundingBoxTree, mesh, x):
-    """Compute collisions between the point and entities of the mesh"""
-    return cpp.geometry.compute_entity_collisions_mesh(tree._cpp_object, mesh, x)
+def compute_distributed_collisions(tree0: BoundingBoxTree, mesh0, tree1: BoundingBoxTree, mesh1, num_threads=1):
+    """Compute pairs of owned cells of two distributed meshes with
+    overlapping bounding boxes. Returns a list with, for each process
+    p, an array of pairs (c0, c1) where c0 is a local cell of mesh0 on
+    this process and c1 is a local cell of mesh1 on process p"""
+    return cpp.geometry.compute_distributed_collisions(tree0._cpp_object, mesh0, tree1._cpp_object, mesh1,
+                                                       num_threads)
+
+
+def compute_distance_to_facets(V, facets, signed_distance=False, num_threads=1):
+    """Compute the distance from the degree-of-freedom coordinates of
+    the function space V to the given (local) facets of its mesh, e.g.
+    the wall distance. Facets on all processes are considered. If
+    signed_distance is True, the distance is negative on the side of
+    the facets of the attached cells (inside the domain for exterior
+    facets)"""
+    x = V.tabulate_dof_coordinates()
+    return cpp.geometry.compute_distance_to_facets(V.mesh, facets, x, signed_distance, num_threads)
+
+
+def compute_entity_collisions_mesh(tree: BoundingBoxTree, mesh, x, num_threads=1):
+    """Compute collisions between the points and entities of the mesh.
+    Returns (entities, offsets), see compute_collisions_point"""
+    return cpp.geometry.compute_entity_collisions_mesh(tree._cpp_object, mesh, x, num_threads)
 
 
 def compute_entity_collisions_bb(tree0: BoundingBoxTree, mesh0, tree1: BoundingBoxTree, mesh1):
@@ -40,18 +40,16 @@ class XDMFFile(cpp.io.XDMFFile):
         u_cpp = getattr(u, "_cpp_object", u)
         super().write_function(u_cpp, t, mesh_xpath)
 
-    def read_mesh(self, name="mesh", xpath="/Xdmf/Domain"):
-        # Read mesh data from file
-        cell_type, x, cells = super().read_mesh_data(name, xpath)
-
+    def read_mesh(self, name="mesh", xpath="/Xdmf/Domain", ghost_mode=cpp.mesh.GhostMode.none):
         # Construct the geometry map
-        cell = ufl.Cell(cpp.mesh.to_string(cell_type[0]), geometric_dimension=x.shape[1])
+        cell_type = super().read_cell_type(name, xpath)
+        gdim = super().read_geometry_dim(name, xpath)
+        cell = ufl.Cell(cpp.mesh.to_string(cell_type[0]), geometric_dimension=gdim)
         domain = ufl.Mesh(ufl.VectorElement("Lagrange", cell, cell_type[1]))
         cmap = fem.create_coordinate_map(domain)
 
-        # Build the mesh
-        mesh = cpp.mesh.create(self.comm(), cpp.graph.AdjacencyList64(cells), cmap, x, cpp.mesh.GhostMode.none)
-        mesh.name = name
+        # Read and build the mesh (uses the stored partition if available)
+        mesh = super().read_mesh(cmap, ghost_mode, name, xpath)
         domain._ufl_cargo = mesh
         mesh._ufl_domain = domain
 
@@ -14,7 +14,7 @@ __all__ = [
 ]
 
 # Import pybind11 objects into dolfinx.la
-from dolfinx.cpp.la import VectorSpaceBasis  # noqa
+from dolfinx.cpp.la import PETScKrylovSolver, VectorSpaceBasis  # noqa
 
 
 def la_index_dtype():
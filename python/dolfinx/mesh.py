@@ -58,6 +58,25 @@ def refine(mesh, cell_markers=None, redistribute=True):
     return mesh_refined
 
 
+def mark_dorfler(eta, theta):
+    """Mark cells for refinement with the Dorfler (bulk) criterion, given a
+    cellwise constant error indicator. Returns cell tags that can be
+    passed to refine."""
+    return cpp.refinement.mark_dorfler(eta._cpp_object, theta)
+
+
+def refine_with_parent_cells(mesh, cell_markers=None):
+    """Refine a mesh without redistribution, and return the refined
+    mesh and the index of the parent cell of each cell in the refined
+    mesh"""
+    if cell_markers is None:
+        mesh_refined, parent_cells = cpp.refinement.refine_with_parent_cells(mesh)
+    else:
+        mesh_refined, parent_cells = cpp.refinement.refine_with_parent_cells(mesh, cell_markers)
+    mesh_refined._ufl_domain = mesh._ufl_domain
+    return mesh_refined, parent_cells
+
+
 def Mesh(comm, cell_type, x, cells, ghosts, degree=1, ghost_mode=cpp.mesh.GhostMode.none):
     """Crete a mesh from topology and geometry data"""
     cell = ufl.Cell(cpp.mesh.to_string(cell_type), geometric_dimension=x.shape[1])
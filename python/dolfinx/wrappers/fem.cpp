@@ -137,6 +137,20 @@ void fem(py::module& m)
       },
       py::return_value_policy::take_ownership,
       "Create nested sparse matrix for bilinear forms.");
+  m.def(
+      "create_prolongation_matrix",
+      [](const dolfinx::function::FunctionSpace& V0,
+         const dolfinx::function::FunctionSpace& V1,
+         const std::vector<std::int32_t>& parent_cells) {
+        dolfinx::la::PETScMatrix P
+            = dolfinx::fem::create_prolongation_matrix(V0, V1, parent_cells);
+        Mat _P = P.mat();
+        PetscObjectReference((PetscObject)_P);
+        return _P;
+      },
+      py::return_value_policy::take_ownership,
+      "Create prolongation matrix between function spaces on nested "
+      "meshes.");
   m.def("create_element_dof_layout", &dolfinx::fem::create_element_dof_layout,
         "Create ElementDofLayout object from a ufc dofmap.");
   m.def(
@@ -282,6 +296,16 @@ void fem(py::module& m)
             const dolfinx::fem::Form&>(&dolfinx::fem::assemble_vector),
         py::arg("b"), py::arg("L"),
         "Assemble linear form into an existing Eigen vector");
+  m.def(
+      "assemble_vector",
+      py::overload_cast<
+          Vec, const dolfinx::fem::Form&, const dolfinx::fem::Form&,
+          const std::vector<std::shared_ptr<const dolfinx::fem::DirichletBC>>&,
+          const Vec, double>(&dolfinx::fem::assemble_vector),
+      py::arg("b"), py::arg("L"), py::arg("a"), py::arg("bcs"), py::arg("x0"),
+      py::arg("scale"),
+      "Assemble linear form into an existing vector, apply lifting and set "
+      "boundary condition values");
   // Matrices
   m.def(
       "assemble_matrix",
@@ -333,6 +357,12 @@ void fem(py::module& m)
           PetscScalar>(&dolfinx::fem::add_diagonal));
 
   m.def("assemble_matrix_eigen", &dolfinx::fem::assemble_matrix_eigen);
+  // Systems
+  m.def("assemble_system", &dolfinx::fem::assemble_system, py::arg("A"),
+        py::arg("b"), py::arg("a"), py::arg("L"), py::arg("bcs"),
+        py::arg("x0"), py::arg("scale"),
+        "Assemble bilinear and linear forms with symmetric application of "
+        "boundary conditions");
 
   // BC modifiers
   m.def("apply_lifting",
@@ -11,6 +11,7 @@
 #include <dolfinx/function/Constant.h>
 #include <dolfinx/function/Function.h>
 #include <dolfinx/function/FunctionSpace.h>
+#include <dolfinx/function/PointEvaluator.h>
 #include <dolfinx/geometry/BoundingBoxTree.h>
 #include <dolfinx/la/PETScVector.h>
 #include <dolfinx/mesh/Mesh.h>
@@ -54,6 +55,13 @@ void function(py::module& m)
            py::overload_cast<const dolfinx::function::Function&>(
                &dolfinx::function::Function::interpolate),
            py::arg("u"), "Interpolate a finite element function")
+      .def("interpolate",
+           py::overload_cast<const dolfinx::function::Function&,
+                             const dolfinx::function::PointEvaluator&>(
+               &dolfinx::function::Function::interpolate),
+           py::arg("u"), py::arg("evaluator"),
+           "Interpolate a finite element function on a non-matching mesh "
+           "using a cached point evaluator")
       .def("interpolate_ptr",
            [](dolfinx::function::Function& self, std::uintptr_t addr) {
              const std::function<void(PetscScalar*, int, int, const double*)> f
@@ -91,6 +99,26 @@ void function(py::module& m)
       .def_property_readonly("function_space",
                              &dolfinx::function::Function::function_space);
 
+  // dolfinx::function::PointEvaluator
+  py::class_<dolfinx::function::PointEvaluator,
+             std::shared_ptr<dolfinx::function::PointEvaluator>>(
+      m, "PointEvaluator",
+      "Evaluation of Functions at points that may lie on any process")
+      .def(py::init<std::shared_ptr<const dolfinx::mesh::Mesh>,
+                    const dolfinx::geometry::BoundingBoxTree&,
+                    const Eigen::Ref<const Eigen::Array<
+                        double, Eigen::Dynamic, 3, Eigen::RowMajor>>&>(),
+           py::arg("mesh"), py::arg("tree"), py::arg("x"))
+      .def("eval", &dolfinx::function::PointEvaluator::eval, py::arg("u"),
+           "Evaluate Function at the points")
+      .def_property_readonly("num_points",
+                             &dolfinx::function::PointEvaluator::num_points)
+      .def_property_readonly("num_owned_points",
+                             &dolfinx::function::PointEvaluator::num_owned_points)
+      .def_property_readonly(
+          "points_not_found",
+          &dolfinx::function::PointEvaluator::points_not_found);
+
   // dolfinx::function::FunctionSpace
   py::class_<dolfinx::function::FunctionSpace,
              std::shared_ptr<dolfinx::function::FunctionSpace>>(
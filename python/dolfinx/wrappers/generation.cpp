@@ -56,6 +56,17 @@ void generation(py::module& m)
                 comm.get(), p, n, element, ghost_mode, diagonal);
           },
           py::arg("comm"), py::arg("p"), py::arg("n"), py::arg("element"),
+          py::arg("ghost_mode"), py::arg("diagonal") = "right")
+      .def_static(
+          "create_structured",
+          [](const MPICommWrapper comm, std::array<Eigen::Vector3d, 2> p,
+             std::array<std::size_t, 2> n,
+             const dolfinx::fem::CoordinateElement& element,
+             dolfinx::mesh::GhostMode ghost_mode, std::string diagonal) {
+            return dolfinx::generation::RectangleMesh::create_structured(
+                comm.get(), p, n, element, ghost_mode, diagonal);
+          },
+          py::arg("comm"), py::arg("p"), py::arg("n"), py::arg("element"),
           py::arg("ghost_mode"), py::arg("diagonal") = "right");
 
   // dolfinx::UnitDiscMesh
@@ -84,6 +95,17 @@ void generation(py::module& m)
                                                         element, ghost_mode);
           },
           py::arg("comm"), py::arg("p"), py::arg("n"), py::arg("element"),
+          py::arg("ghost_mode"))
+      .def_static(
+          "create_structured",
+          [](const MPICommWrapper comm, std::array<Eigen::Vector3d, 2> p,
+             std::array<std::size_t, 3> n,
+             const dolfinx::fem::CoordinateElement& element,
+             const dolfinx::mesh::GhostMode ghost_mode) {
+            return dolfinx::generation::BoxMesh::create_structured(
+                comm.get(), p, n, element, ghost_mode);
+          },
+          py::arg("comm"), py::arg("p"), py::arg("n"), py::arg("element"),
           py::arg("ghost_mode"));
 }
 } // namespace dolfinx_wrappers
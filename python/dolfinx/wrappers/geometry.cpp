@@ -7,7 +7,9 @@
 #include <Eigen/Dense>
 #include <dolfinx/geometry/BoundingBoxTree.h>
 #include <dolfinx/geometry/CollisionPredicates.h>
+#include <dolfinx/geometry/WideBoundingBoxTree.h>
 #include <dolfinx/geometry/utils.h>
+#include <dolfinx/graph/AdjacencyList.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshEntity.h>
 #include <memory>
@@ -25,98 +27,94 @@ void geometry(py::module& m)
 {
   m.def("create_midpoint_tree", &dolfinx::geometry::create_midpoint_tree);
 
-  m.def("compute_closest_entity",
-        [](const dolfinx::geometry::BoundingBoxTree& tree,
-           const dolfinx::geometry::BoundingBoxTree& tree_midpoint,
-           const dolfinx::mesh::Mesh& mesh,
-           const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
-                                               Eigen::RowMajor>>& p) {
-          Eigen::VectorXi entities(p.rows());
-          Eigen::VectorXd distance(p.rows());
-          for (Eigen::Index i = 0; i < p.rows(); ++i)
-          {
-            const std::pair<int, double> out
-                = dolfinx::geometry::compute_closest_entity(
-                    tree, tree_midpoint, p.row(i).transpose(), mesh);
-            entities(i) = out.first;
-            distance(i) = out.second;
-          }
-          return std::make_pair(std::move(entities), std::move(distance));
-        });
-  m.def("compute_first_collision",
-        [](const dolfinx::geometry::BoundingBoxTree& tree,
-           const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
-                                               Eigen::RowMajor>>& p) {
-          Eigen::VectorXi entities(p.rows());
-          for (Eigen::Index i = 0; i < p.rows(); ++i)
-          {
-            entities(i) = dolfinx::geometry::compute_first_collision(
-                tree, p.row(i).transpose());
-          }
-          return entities;
-        });
-  m.def("compute_first_entity_collision",
-        [](const dolfinx::geometry::BoundingBoxTree& tree,
-           const dolfinx::mesh::Mesh& mesh,
-           const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
-                                               Eigen::RowMajor>>& p) {
-          Eigen::VectorXi entities(p.rows());
-          for (Eigen::Index i = 0; i < p.rows(); ++i)
-          {
-            entities(i) = dolfinx::geometry::compute_first_entity_collision(
-                tree, p.row(i).transpose(), mesh);
-          }
-          return entities;
-        });
-  m.def("compute_collisions_point",
-        [](const dolfinx::geometry::BoundingBoxTree& tree,
-           const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
-                                               Eigen::RowMajor>>& p) {
-          std::vector<int> entities;
-          std::vector<int> offset(p.rows() + 1, 0);
-          for (Eigen::Index i = 0; i < p.rows(); ++i)
-          {
-            const std::vector<int> collisions
-                = dolfinx::geometry::compute_collisions(tree,
-                                                       p.row(i).transpose());
-            entities.insert(entities.end(), collisions.begin(),
-                            collisions.end());
-            offset[i + 1] = offset[i + 1] + collisions.size();
-          }
-          return py::make_tuple(
-              py::array_t<int>(entities.size(), entities.data()),
-              py::array_t<int>(offset.size(), offset.data()));
-        });
+  m.def(
+      "compute_closest_entity",
+      [](const dolfinx::geometry::BoundingBoxTree& tree,
+         const dolfinx::geometry::BoundingBoxTree& tree_midpoint,
+         const dolfinx::mesh::Mesh& mesh,
+         const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                             Eigen::RowMajor>>& p,
+         int num_threads) {
+        return dolfinx::geometry::compute_closest_entity_batch(
+            tree, tree_midpoint, p, mesh, num_threads);
+      },
+      py::arg("tree"), py::arg("tree_midpoint"), py::arg("mesh"),
+      py::arg("x"), py::arg("num_threads") = 1);
+  m.def(
+      "compute_first_collision",
+      [](const dolfinx::geometry::BoundingBoxTree& tree,
+         const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                             Eigen::RowMajor>>& p,
+         int num_threads) {
+        return dolfinx::geometry::compute_first_collision_batch(tree, p,
+                                                               num_threads);
+      },
+      py::arg("tree"), py::arg("x"), py::arg("num_threads") = 1);
+  m.def(
+      "compute_first_entity_collision",
+      [](const dolfinx::geometry::BoundingBoxTree& tree,
+         const dolfinx::mesh::Mesh& mesh,
+         const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                             Eigen::RowMajor>>& p,
+         int num_threads) {
+        return dolfinx::geometry::compute_first_entity_collision_batch(
+            tree, p, mesh, num_threads);
+      },
+      py::arg("tree"), py::arg("mesh"), py::arg("x"),
+      py::arg("num_threads") = 1);
+  m.def(
+      "compute_collisions_point",
+      [](const dolfinx::geometry::BoundingBoxTree& tree,
+         const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                             Eigen::RowMajor>>& p,
+         int num_threads) {
+        const dolfinx::graph::AdjacencyList<std::int32_t> collisions
+            = dolfinx::geometry::compute_collisions_batch(tree, p,
+                                                          num_threads);
+        return py::make_tuple(collisions.array(), collisions.offsets());
+      },
+      py::arg("tree"), py::arg("x"), py::arg("num_threads") = 1);
   m.def("compute_collisions",
         py::overload_cast<const dolfinx::geometry::BoundingBoxTree&,
                           const dolfinx::geometry::BoundingBoxTree&>(
             &dolfinx::geometry::compute_collisions));
-  m.def("compute_entity_collisions_mesh",
-        [](const dolfinx::geometry::BoundingBoxTree& tree,
-           const dolfinx::mesh::Mesh& mesh,
-           const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
-                                               Eigen::RowMajor>>& p) {
-          std::vector<int> entities;
-          std::vector<int> offset(p.rows() + 1, 0);
-          for (Eigen::Index i = 0; i < p.rows(); ++i)
-          {
-            const std::vector<int> collisions
-                = dolfinx::geometry::compute_entity_collisions(
-                    tree, p.row(i).transpose(), mesh);
-            entities.insert(entities.end(), collisions.begin(),
-                            collisions.end());
-            offset[i + 1] = offset[i + 1] + collisions.size();
-          }
-          return py::make_tuple(
-              py::array_t<int>(entities.size(), entities.data()),
-              py::array_t<int>(offset.size(), offset.data()));
-        });
+  m.def(
+      "compute_entity_collisions_mesh",
+      [](const dolfinx::geometry::BoundingBoxTree& tree,
+         const dolfinx::mesh::Mesh& mesh,
+         const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                             Eigen::RowMajor>>& p,
+         int num_threads) {
+        const dolfinx::graph::AdjacencyList<std::int32_t> collisions
+            = dolfinx::geometry::compute_entity_collisions_batch(
+                tree, p, mesh, num_threads);
+        return py::make_tuple(collisions.array(), collisions.offsets());
+      },
+      py::arg("tree"), py::arg("mesh"), py::arg("x"),
+      py::arg("num_threads") = 1);
   m.def("compute_entity_collisions_bb",
         py::overload_cast<const dolfinx::geometry::BoundingBoxTree&,
                           const dolfinx::geometry::BoundingBoxTree&,
                           const dolfinx::mesh::Mesh&, const dolfinx::mesh::Mesh&>(
             &dolfinx::geometry::compute_entity_collisions));
+  // Single point version, wrapped to be able to test the batch version
+  // against it
+  m.def("compute_closest_entity_point",
+        py::overload_cast<const dolfinx::geometry::BoundingBoxTree&,
+                          const dolfinx::geometry::BoundingBoxTree&,
+                          const Eigen::Vector3d&, const dolfinx::mesh::Mesh&>(
+            &dolfinx::geometry::compute_closest_entity));
   m.def("squared_distance", &dolfinx::geometry::squared_distance);
+  m.def("compute_distance_to_facets",
+        &dolfinx::geometry::compute_distance_to_facets, py::arg("mesh"),
+        py::arg("facets"), py::arg("x"), py::arg("signed_distance") = false,
+        py::arg("num_threads") = 1);
+  m.def("compute_process_collisions",
+        &dolfinx::geometry::compute_process_collisions);
+  m.def("compute_distributed_collisions",
+        &dolfinx::geometry::compute_distributed_collisions, py::arg("tree0"),
+        py::arg("mesh0"), py::arg("tree1"), py::arg("mesh1"),
+        py::arg("num_threads") = 1);
 
   // dolfinx::geometry::BoundingBoxTree
   py::class_<dolfinx::geometry::BoundingBoxTree,
@@ -124,7 +122,46 @@ void geometry(py::module& m)
       m, "BoundingBoxTree")
       .def(py::init<const dolfinx::mesh::Mesh&, int>())
       .def(py::init<const std::vector<Eigen::Vector3d>&>())
-      .def("str", &dolfinx::geometry::BoundingBoxTree::str);
+      .def("str", &dolfinx::geometry::BoundingBoxTree::str)
+      .def("refit", &dolfinx::geometry::BoundingBoxTree::refit,
+           py::arg("mesh"), py::arg("rebuild_ratio") = 0.0)
+      .def("cost_ratio", &dolfinx::geometry::BoundingBoxTree::cost_ratio);
+
+  // dolfinx::geometry::WideBoundingBoxTree
+  py::class_<dolfinx::geometry::WideBoundingBoxTree,
+             std::shared_ptr<dolfinx::geometry::WideBoundingBoxTree>>
+      wide_tree(m, "WideBoundingBoxTree");
+
+  py::enum_<dolfinx::geometry::WideBoundingBoxTree::Construction>(
+      wide_tree, "Construction")
+      .value("sah", dolfinx::geometry::WideBoundingBoxTree::Construction::sah)
+      .value("morton",
+             dolfinx::geometry::WideBoundingBoxTree::Construction::morton);
+
+  wide_tree
+      .def(py::init<const dolfinx::mesh::Mesh&, int,
+                    dolfinx::geometry::WideBoundingBoxTree::Construction>(),
+           py::arg("mesh"), py::arg("tdim"),
+           py::arg("construction")
+           = dolfinx::geometry::WideBoundingBoxTree::Construction::sah)
+      .def("num_leaves", &dolfinx::geometry::WideBoundingBoxTree::num_leaves)
+      .def("num_nodes", &dolfinx::geometry::WideBoundingBoxTree::num_nodes)
+      .def(
+          "compute_collisions",
+          [](const dolfinx::geometry::WideBoundingBoxTree& self,
+             const Eigen::Ref<const Eigen::Array<double, Eigen::Dynamic, 3,
+                                                 Eigen::RowMajor>>& p) {
+            const dolfinx::graph::AdjacencyList<std::int32_t> collisions
+                = self.compute_collisions(p);
+            return py::make_tuple(collisions.array(), collisions.offsets());
+          },
+          py::arg("x"))
+      .def("compute_box_collisions",
+           &dolfinx::geometry::WideBoundingBoxTree::compute_box_collisions,
+           py::arg("box"))
+      .def("compute_entity_collisions",
+           &dolfinx::geometry::WideBoundingBoxTree::compute_entity_collisions,
+           py::arg("x"), py::arg("mesh"));
 
   // These classes are wrapped only to be able to write tests in python.
   // They are not imported into the dolfinx namespace in python, but must
@@ -141,6 +178,15 @@ void geometry(py::module& m)
           &dolfinx::geometry::CollisionPredicates::collides_triangle_triangle_2d)
       .def_static(
           "collides_segment_segment_2d",
-          &dolfinx::geometry::CollisionPredicates::collides_segment_segment_2d);
+          &dolfinx::geometry::CollisionPredicates::collides_segment_segment_2d)
+      .def_static(
+          "collides_hexahedron_point_3d",
+          &dolfinx::geometry::CollisionPredicates::collides_hexahedron_point_3d)
+      .def_static("collides_triangle_point_2d_batch",
+                  &dolfinx::geometry::CollisionPredicates::
+                      collides_triangle_point_2d_batch)
+      .def_static("collides_tetrahedron_point_3d_batch",
+                  &dolfinx::geometry::CollisionPredicates::
+                      collides_tetrahedron_point_3d_batch);
 }
 } // namespace dolfinx_wrappers
@@ -6,9 +6,11 @@
 
 #include "caster_mpi.h"
 #include "caster_petsc.h"
+#include <dolfinx/fem/CoordinateElement.h>
 #include <dolfinx/function/Function.h>
 #include <dolfinx/function/FunctionSpace.h>
 #include <dolfinx/io/HDF5File.h>
+#include <dolfinx/io/HDF5WriteQueue.h>
 #include <dolfinx/io/VTKFile.h>
 #include <dolfinx/io/XDMFFile.h>
 #include <dolfinx/io/cells.h>
@@ -36,6 +38,34 @@ void io(py::module& m)
   m.def("permutation_dolfin_to_vtk", &dolfinx::io::cells::dolfin_to_vtk);
   m.def("permute_cell_ordering", &dolfinx::io::cells::permute_ordering);
 
+  m.def(
+      "asynchronous_writes_supported",
+      [](const MPICommWrapper comm) {
+        return dolfinx::io::HDF5WriteQueue::supported(comm.get());
+      },
+      "Check if asynchronous HDF5 writes are possible on a communicator.");
+
+  // dolfinx::io::HDF5Policy
+  py::class_<dolfinx::io::HDF5Policy>(m, "HDF5Policy")
+      .def(py::init<>())
+      .def_readwrite("chunk_rows", &dolfinx::io::HDF5Policy::chunk_rows)
+      .def_readwrite("alignment", &dolfinx::io::HDF5Policy::alignment)
+      .def_readwrite("collective_metadata_write",
+                     &dolfinx::io::HDF5Policy::collective_metadata_write)
+      .def_readwrite("collective_metadata_ops",
+                     &dolfinx::io::HDF5Policy::collective_metadata_ops)
+      .def_readwrite("sieve_buffer_size",
+                     &dolfinx::io::HDF5Policy::sieve_buffer_size)
+      .def_readwrite("collective_transfer",
+                     &dolfinx::io::HDF5Policy::collective_transfer)
+      .def_readwrite("mpi_info", &dolfinx::io::HDF5Policy::mpi_info)
+      .def_readwrite("float32", &dolfinx::io::HDF5Policy::float32)
+      .def_readwrite("deflate_level", &dolfinx::io::HDF5Policy::deflate_level)
+      .def_readwrite("shuffle", &dolfinx::io::HDF5Policy::shuffle)
+      .def_readwrite("filter_id", &dolfinx::io::HDF5Policy::filter_id)
+      .def_readwrite("filter_parameters",
+                     &dolfinx::io::HDF5Policy::filter_parameters);
+
   // dolfinx::io::XDMFFile
   py::class_<dolfinx::io::XDMFFile, std::shared_ptr<dolfinx::io::XDMFFile>>
       xdmf_file(m, "XDMFFile");
@@ -48,25 +78,38 @@ void io(py::module& m)
   xdmf_file
       .def(py::init([](const MPICommWrapper comm, const std::string filename,
                        const std::string file_mode,
-                       dolfinx::io::XDMFFile::Encoding encoding) {
+                       dolfinx::io::XDMFFile::Encoding encoding,
+                       const dolfinx::io::HDF5Policy& policy) {
              return std::make_unique<dolfinx::io::XDMFFile>(
-                 comm.get(), filename, file_mode, encoding);
+                 comm.get(), filename, file_mode, encoding, policy);
            }),
            py::arg("comm"), py::arg("filename"), py::arg("file_mode"),
-           py::arg("encoding") = dolfinx::io::XDMFFile::Encoding::HDF5)
+           py::arg("encoding") = dolfinx::io::XDMFFile::Encoding::HDF5,
+           py::arg("policy") = dolfinx::io::HDF5Policy())
       .def("__enter__",
            [](std::shared_ptr<dolfinx::io::XDMFFile>& self) { return self; })
       .def("__exit__",
            [](dolfinx::io::XDMFFile& self, py::object exc_type,
               py::object exc_value, py::object traceback) { self.close(); })
       .def("close", &dolfinx::io::XDMFFile::close)
+      .def("set_asynchronous", &dolfinx::io::XDMFFile::set_asynchronous,
+           py::arg("enable"), py::arg("max_staged_bytes") = 0)
+      .def("wait", &dolfinx::io::XDMFFile::wait)
+      .def("asynchronous", &dolfinx::io::XDMFFile::asynchronous)
       .def("write_mesh", &dolfinx::io::XDMFFile::write_mesh, py::arg("mesh"),
            py::arg("xpath") = "/Xdmf/Domain")
       .def("write_geometry", &dolfinx::io::XDMFFile::write_geometry,
            py::arg("geometry"), py::arg("name") = "geometry",
            py::arg("xpath") = "/Xdmf/Domain")
+      .def("read_mesh", &dolfinx::io::XDMFFile::read_mesh,
+           py::arg("element"), py::arg("mode"), py::arg("name") = "mesh",
+           py::arg("xpath") = "/Xdmf/Domain")
       .def("read_mesh_data", &dolfinx::io::XDMFFile::read_mesh_data,
            py::arg("name") = "mesh", py::arg("xpath") = "/Xdmf/Domain")
+      .def("read_cell_type", &dolfinx::io::XDMFFile::read_cell_type,
+           py::arg("name") = "mesh", py::arg("xpath") = "/Xdmf/Domain")
+      .def("read_geometry_dim", &dolfinx::io::XDMFFile::read_geometry_dim,
+           py::arg("name") = "mesh", py::arg("xpath") = "/Xdmf/Domain")
       .def("write_function", &dolfinx::io::XDMFFile::write_function,
            py::arg("function"), py::arg("t"), py::arg("mesh_xpath"))
       .def("write_meshtags", &dolfinx::io::XDMFFile::write_meshtags,
@@ -7,6 +7,7 @@
 #include "caster_mpi.h"
 #include "caster_petsc.h"
 #include <dolfinx/common/IndexMap.h>
+#include <dolfinx/la/PETScKrylovSolver.h>
 #include <dolfinx/la/PETScVector.h>
 #include <dolfinx/la/SparsityPattern.h>
 #include <dolfinx/la/VectorSpaceBasis.h>
@@ -58,6 +59,19 @@ void la(py::module& m)
       .def("insert", &dolfinx::la::SparsityPattern::insert)
       .def("insert_diagonal", &dolfinx::la::SparsityPattern::insert_diagonal);
 
+  // dolfinx::la::PETScKrylovSolver
+  py::class_<dolfinx::la::PETScKrylovSolver,
+             std::shared_ptr<dolfinx::la::PETScKrylovSolver>>(
+      m, "PETScKrylovSolver")
+      .def(py::init([](const MPICommWrapper comm) {
+        return std::make_unique<dolfinx::la::PETScKrylovSolver>(comm.get());
+      }))
+      .def(py::init<KSP>(), py::arg("ksp"))
+      .def("set_multigrid_interpolation",
+           &dolfinx::la::PETScKrylovSolver::set_multigrid_interpolation,
+           py::arg("interpolation"))
+      .def("ksp", &dolfinx::la::PETScKrylovSolver::ksp);
+
   // dolfinx::la::VectorSpaceBasis
   py::class_<dolfinx::la::VectorSpaceBasis,
              std::shared_ptr<dolfinx::la::VectorSpaceBasis>>(m,
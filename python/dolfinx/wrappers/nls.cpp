@@ -69,8 +69,17 @@ void nls(py::module& m)
 
   // dolfinx::NewtonSolver
   py::class_<dolfinx::nls::NewtonSolver,
-             std::shared_ptr<dolfinx::nls::NewtonSolver>, PyNewtonSolver>(
-      m, "NewtonSolver")
+             std::shared_ptr<dolfinx::nls::NewtonSolver>, PyNewtonSolver>
+      newton_solver(m, "NewtonSolver");
+
+  // dolfinx::NewtonSolver::LineSearch enums
+  py::enum_<dolfinx::nls::NewtonSolver::LineSearch>(newton_solver,
+                                                     "LineSearch")
+      .value("basic", dolfinx::nls::NewtonSolver::LineSearch::basic)
+      .value("backtracking",
+             dolfinx::nls::NewtonSolver::LineSearch::backtracking);
+
+  newton_solver
       .def(py::init([](const MPICommWrapper comm) {
         return std::make_unique<PyNewtonSolver>(comm.get());
       }))
@@ -79,9 +88,44 @@ void nls(py::module& m)
       .def("update_solution", &PyPublicNewtonSolver::update_solution)
       .def_readwrite("atol", &dolfinx::nls::NewtonSolver::atol)
       .def_readwrite("rtol", &dolfinx::nls::NewtonSolver::rtol)
+      .def_readwrite("relaxation_parameter",
+                     &dolfinx::nls::NewtonSolver::relaxation_parameter)
       .def_readwrite("max_it", &dolfinx::nls::NewtonSolver::max_it)
       .def_readwrite("convergence_criterion",
-                     &dolfinx::nls::NewtonSolver::convergence_criterion);
+                     &dolfinx::nls::NewtonSolver::convergence_criterion)
+      .def_readwrite("jacobian_update_frequency",
+                     &dolfinx::nls::NewtonSolver::jacobian_update_frequency)
+      .def_readwrite(
+          "preconditioner_update_frequency",
+          &dolfinx::nls::NewtonSolver::preconditioner_update_frequency)
+      .def_readwrite("lagged_rate_max",
+                     &dolfinx::nls::NewtonSolver::lagged_rate_max)
+      .def_readwrite("eisenstat_walker",
+                     &dolfinx::nls::NewtonSolver::eisenstat_walker)
+      .def_readwrite("eisenstat_walker_rtol0",
+                     &dolfinx::nls::NewtonSolver::eisenstat_walker_rtol0)
+      .def_readwrite("eisenstat_walker_rtol_max",
+                     &dolfinx::nls::NewtonSolver::eisenstat_walker_rtol_max)
+      .def_readwrite("eisenstat_walker_gamma",
+                     &dolfinx::nls::NewtonSolver::eisenstat_walker_gamma)
+      .def_readwrite("eisenstat_walker_alpha",
+                     &dolfinx::nls::NewtonSolver::eisenstat_walker_alpha)
+      .def_readwrite("line_search", &dolfinx::nls::NewtonSolver::line_search)
+      .def_readwrite("line_search_max_it",
+                     &dolfinx::nls::NewtonSolver::line_search_max_it)
+      .def_readwrite("line_search_alpha",
+                     &dolfinx::nls::NewtonSolver::line_search_alpha)
+      .def("jacobian_updates", &dolfinx::nls::NewtonSolver::jacobian_updates)
+      .def("preconditioner_updates",
+           &dolfinx::nls::NewtonSolver::preconditioner_updates)
+      .def("residual_evaluations",
+           &dolfinx::nls::NewtonSolver::residual_evaluations)
+      .def("jacobian_evaluations",
+           &dolfinx::nls::NewtonSolver::jacobian_evaluations)
+      .def_property_readonly("krylov_solver",
+                             [](const dolfinx::nls::NewtonSolver& self) {
+                               return self.get_krylov_solver().ksp();
+                             });
 
   // dolfinx::NonlinearProblem 'trampoline' for overloading from
   // Python
@@ -107,6 +151,13 @@ void nls(py::module& m)
           "Tried to call pure virtual function dolfinx::NonlinearProblem::F");
     }
 
+    std::pair<Vec, Mat> FJ(const Vec x) override
+    {
+      PYBIND11_OVERLOAD_INT(std::pair<Vec, Mat>,
+                            dolfinx::nls::NonlinearProblem, "FJ", x);
+      return dolfinx::nls::NonlinearProblem::FJ(x);
+    }
+
     void form(Vec x) override
     {
       PYBIND11_OVERLOAD_INT(void, dolfinx::nls::NonlinearProblem, "form", x);
@@ -122,6 +173,7 @@ void nls(py::module& m)
       .def("F", &dolfinx::nls::NonlinearProblem::F)
       .def("J", &dolfinx::nls::NonlinearProblem::J)
       .def("P", &dolfinx::nls::NonlinearProblem::P)
+      .def("FJ", &dolfinx::nls::NonlinearProblem::FJ)
       .def("form", &dolfinx::nls::NonlinearProblem::form);
 }
 } // namespace dolfinx_wrappers
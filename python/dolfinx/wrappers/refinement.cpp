@@ -4,10 +4,13 @@
 //
 // SPDX-License-Identifier:    LGPL-3.0-or-later
 
+#include <dolfinx/function/Function.h>
 #include <dolfinx/mesh/Mesh.h>
 #include <dolfinx/mesh/MeshTags.h>
+#include <dolfinx/refinement/marking.h>
 #include <dolfinx/refinement/refine.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 namespace py = pybind11;
 
@@ -28,6 +31,22 @@ void refinement(py::module& m)
                           const dolfinx::mesh::MeshTags<std::int8_t>&, bool>(
             &dolfinx::refinement::refine),
         py::arg("mesh"), py::arg("marker"), py::arg("redistribute") = true);
+
+  // dolfinx::refinement::refine_with_parent_cells
+  m.def("refine_with_parent_cells",
+        py::overload_cast<const dolfinx::mesh::Mesh&>(
+            &dolfinx::refinement::refine_with_parent_cells),
+        py::arg("mesh"));
+
+  m.def("refine_with_parent_cells",
+        py::overload_cast<const dolfinx::mesh::Mesh&,
+                          const dolfinx::mesh::MeshTags<std::int8_t>&>(
+            &dolfinx::refinement::refine_with_parent_cells),
+        py::arg("mesh"), py::arg("marker"));
+
+  // dolfinx::refinement::mark_dorfler
+  m.def("mark_dorfler", &dolfinx::refinement::mark_dorfler, py::arg("eta"),
+        py::arg("theta"), "Mark cells with the Dorfler (bulk) criterion.");
 }
 
 } // namespace dolfinx_wrappers
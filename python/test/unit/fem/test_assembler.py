@@ -193,6 +193,72 @@ def test_assembly_bcs():
     assert (f - b_bc).norm() == pytest.approx(0.0, rel=1e-12, abs=1e-12)
 
 
+def test_assembly_bcs_fused():
+    mesh = dolfinx.generation.UnitSquareMesh(MPI.COMM_WORLD, 12, 12)
+    V = dolfinx.FunctionSpace(mesh, ("Lagrange", 2))
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    x = SpatialCoordinate(mesh)
+    a = inner(x[0] * u, v) * dx + inner(u, v) * ds
+    L = inner(x[1], v) * dx + inner(1.0, v) * ds
+
+    def boundary(x):
+        return numpy.logical_or(x[0] < 1.0e-6, x[1] > 1.0 - 1.0e-6)
+
+    u_bc = dolfinx.function.Function(V)
+    u_bc.interpolate(lambda x: 1.0 + x[0] * x[1])
+    bc = dolfinx.fem.DirichletBC(u_bc, dolfinx.fem.locate_dofs_geometrical(V, boundary))
+
+    x0 = dolfinx.function.Function(V)
+    x0.interpolate(lambda x: x[0] - x[1])
+    x0.vector.ghostUpdate(addv=PETSc.InsertMode.INSERT, mode=PETSc.ScatterMode.FORWARD)
+
+    # Assemble vector and apply lifting and bcs in separate steps
+    b = dolfinx.fem.assemble_vector(L)
+    dolfinx.fem.apply_lifting(b, [a], [[bc]], [x0.vector], scale=-2.0)
+    b.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+    dolfinx.fem.set_bc(b, [bc], x0.vector, scale=-2.0)
+
+    # Assemble vector, apply lifting and set bcs in one call
+    b_fused = b.duplicate()
+    with b_fused.localForm() as b_local:
+        b_local.set(0.0)
+    dolfinx.fem.assemble_vector(b_fused, L, a, [bc], x0.vector, -2.0)
+
+    assert (b - b_fused).norm() == pytest.approx(0.0, rel=1e-12, abs=1e-12)
+
+
+def test_assemble_system():
+    mesh = dolfinx.generation.UnitSquareMesh(MPI.COMM_WORLD, 12, 12)
+    V = dolfinx.FunctionSpace(mesh, ("Lagrange", 2))
+    u, v = ufl.TrialFunction(V), ufl.TestFunction(V)
+    x = SpatialCoordinate(mesh)
+    a = inner(ufl.grad(u), ufl.grad(v)) * dx + inner(x[0] * u, v) * dx + inner(u, v) * ds
+    L = inner(x[1], v) * dx + inner(1.0, v) * ds
+
+    def boundary(x):
+        return numpy.logical_or(x[0] < 1.0e-6, x[1] > 1.0 - 1.0e-6)
+
+    u_bc = dolfinx.function.Function(V)
+    u_bc.interpolate(lambda x: 1.0 + x[0] * x[1])
+    bc = dolfinx.fem.DirichletBC(u_bc, dolfinx.fem.locate_dofs_geometrical(V, boundary))
+
+    # Assemble matrix and vector separately
+    A = dolfinx.fem.assemble_matrix(a, [bc])
+    A.assemble()
+    b = dolfinx.fem.assemble_vector(L)
+    dolfinx.fem.apply_lifting(b, [a], [[bc]])
+    b.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+    dolfinx.fem.set_bc(b, [bc])
+
+    # Assemble system
+    A_sys, b_sys = dolfinx.fem.assemble_system(a, L, [bc])
+    A_sys.assemble()
+
+    assert (A - A_sys).norm() == pytest.approx(0.0, abs=1e-12)
+    assert (b - b_sys).norm() == pytest.approx(0.0, abs=1e-12)
+    assert A_sys.isSymmetric(1.0e-12)
+
+
 @skip_in_parallel
 def test_assemble_manifold():
     """Test assembly of poisson problem on a mesh with topological dimension 1
@@ -354,3 +354,97 @@ def test_interpolation_function(mesh):
     uh = Function(Vh)
     uh.interpolate(u)
     assert np.allclose(uh.vector.array, 1)
+
+
+def test_point_evaluator(V):
+    """Evaluate at points that lie on other processes"""
+    u = Function(V)
+    mesh = V.mesh
+    tree = geometry.BoundingBoxTree(mesh, mesh.topology.dim)
+
+    # All processes request the same points, one of which is outside
+    # the mesh
+    x = np.random.RandomState(1).rand(20, 3)
+    x[5] = [2.0, 0.0, 0.0]
+    evaluator = cpp.function.PointEvaluator(mesh, tree._cpp_object, x)
+    assert list(evaluator.points_not_found) == [5]
+    assert mesh.mpi_comm().allreduce(evaluator.num_owned_points, op=MPI.SUM) \
+        == 19 * mesh.mpi_comm().size
+
+    # Evaluate twice to check the reuse of the communication pattern
+    for scale in [1.0, 2.0]:
+        u.interpolate(lambda x: scale * (x[0] + 2 * x[1] + 3 * x[2]))
+        values = evaluator.eval(u._cpp_object)
+        exact = scale * (x[:, 0] + 2 * x[:, 1] + 3 * x[:, 2])
+        exact[5] = 0.0
+        assert np.allclose(values[:, 0], exact)
+
+
+def test_point_evaluator_one_process(V):
+    """Evaluate at points requested by one process only, so that the
+    processes that evaluate do not receive values"""
+    u = Function(V)
+    mesh = V.mesh
+    tree = geometry.BoundingBoxTree(mesh, mesh.topology.dim)
+
+    comm = mesh.mpi_comm()
+    if comm.rank == 0:
+        x = np.random.RandomState(1).rand(20, 3)
+    else:
+        x = np.zeros((0, 3))
+    evaluator = cpp.function.PointEvaluator(mesh, tree._cpp_object, x)
+    assert len(evaluator.points_not_found) == 0
+    assert comm.allreduce(evaluator.num_owned_points, op=MPI.SUM) == 20
+
+    u.interpolate(lambda x: x[0] + 2 * x[1] + 3 * x[2])
+    values = evaluator.eval(u._cpp_object)
+    assert values.shape[0] == x.shape[0]
+    assert np.allclose(values[:, 0], x[:, 0] + 2 * x[:, 1] + 3 * x[:, 2])
+
+
+def test_interpolation_non_matching_meshes():
+    mesh0 = UnitCubeMesh(MPI.COMM_WORLD, 3, 4, 5)
+    mesh1 = UnitCubeMesh(MPI.COMM_WORLD, 5, 3, 2)
+    V0 = VectorFunctionSpace(mesh0, ("Lagrange", 1))
+    V1 = VectorFunctionSpace(mesh1, ("Lagrange", 2))
+    u0, u1, w = Function(V0), Function(V1), Function(V1)
+
+    def f(x, t=1.0):
+        return np.stack((x[0] + t * x[1], 2 * x[2], t * np.ones(x.shape[1])))
+
+    # Linear functions are interpolated exactly
+    u0.interpolate(f)
+    u1.interpolate(u0)
+    w.interpolate(f)
+    assert np.allclose(u1.vector.array, w.vector.array)
+
+    # Reuse point location for repeated transfers
+    tree = geometry.BoundingBoxTree(mesh0, mesh0.topology.dim)
+    evaluator = cpp.function.PointEvaluator(mesh0, tree._cpp_object, V1.tabulate_dof_coordinates())
+    for t in [2.0, 3.0]:
+        u0.interpolate(lambda x: f(x, t))
+        u1.interpolate(u0, evaluator)
+        w.interpolate(lambda x: f(x, t))
+        assert np.allclose(u1.vector.array, w.vector.array)
+
+
+@pytest.mark.parametrize("ghost_mode", [cpp.mesh.GhostMode.none, cpp.mesh.GhostMode.shared_facet])
+def test_interpolation_non_matching_cell_types(ghost_mode):
+    """Interpolate between a tetrahedral and a hexahedral mesh. In
+    parallel the meshes are partitioned differently, so many points are
+    located on other processes."""
+    mesh0 = UnitCubeMesh(MPI.COMM_WORLD, 4, 3, 5, ghost_mode=ghost_mode)
+    mesh1 = UnitCubeMesh(MPI.COMM_WORLD, 3, 5, 2, cpp.mesh.CellType.hexahedron)
+    V0 = FunctionSpace(mesh0, ("Lagrange", 1))
+    V1 = FunctionSpace(mesh1, ("Lagrange", 2))
+
+    def f(x):
+        return 1.0 + x[0] - 2 * x[1] + 3 * x[2]
+
+    # Linear functions are interpolated exactly in both directions
+    for V, W in [(V0, V1), (V1, V0)]:
+        u, w, w_exact = Function(V), Function(W), Function(W)
+        u.interpolate(f)
+        w.interpolate(u)
+        w_exact.interpolate(f)
+        assert np.allclose(w.vector.array, w_exact.vector.array)
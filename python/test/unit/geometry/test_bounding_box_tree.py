@@ -9,9 +9,10 @@ import numpy
 import pytest
 from mpi4py import MPI
 
-from dolfinx import (UnitCubeMesh, UnitIntervalMesh, UnitSquareMesh, cpp,
-                     geometry)
+from dolfinx import (FunctionSpace, UnitCubeMesh, UnitIntervalMesh,
+                     UnitSquareMesh, cpp, geometry)
 from dolfinx.geometry import BoundingBoxTree
+from dolfinx.mesh import locate_entities_geometrical
 from dolfinx_utils.test.skips import skip_in_parallel
 
 # --- compute_collisions with point ---
@@ -362,3 +363,204 @@ def test_compute_closest_entity_3d():
     entity, distance = geometry.compute_closest_entity(tree, tree_mid, mesh, p)
     assert entity == reference[0]
     assert distance[0] == pytest.approx(reference[1], 1.0e-12)
+
+
+@skip_in_parallel
+def test_compute_collisions_batch_threaded():
+    mesh = UnitCubeMesh(MPI.COMM_WORLD, 6, 6, 6)
+    tree = BoundingBoxTree(mesh, mesh.topology.dim)
+    tree_mid = geometry.BoundingBoxTree.create_midpoint_tree(mesh)
+    points = numpy.random.RandomState(1).rand(50, 3) * 1.2 - 0.1
+
+    entities, offsets = geometry.compute_entity_collisions_mesh(tree, mesh, points, 4)
+    first = geometry.compute_first_entity_collision(tree, mesh, points, 4)
+    closest, distance = geometry.compute_closest_entity(tree, tree_mid, mesh, points, 4)
+    assert len(offsets) == len(points) + 1
+    for i, p in enumerate(points):
+        e, _ = geometry.compute_entity_collisions_mesh(tree, mesh, p)
+        assert set(entities[offsets[i]:offsets[i + 1]]) == set(e)
+        if len(e) > 0:
+            assert first[i] in e
+        else:
+            assert first[i] == -1
+        c, d = cpp.geometry.compute_closest_entity_point(tree._cpp_object, tree_mid._cpp_object, p, mesh)
+        assert distance[i] == pytest.approx(d, 1.0e-12)
+        if closest[i] != c:
+            # Several cells can be closest to a point outside the mesh
+            cell = cpp.mesh.MeshEntity(mesh, mesh.topology.dim, closest[i])
+            assert cpp.geometry.squared_distance(cell, p) == pytest.approx(d**2, 1.0e-12)
+
+
+@skip_in_parallel
+def test_compute_closest_entity_empty_tree():
+    mesh = UnitCubeMesh(MPI.COMM_WORLD, 2, 2, 2)
+    tree = BoundingBoxTree(mesh, mesh.topology.dim)
+    tree_mid = BoundingBoxTree.__new__(BoundingBoxTree)
+    tree_mid._cpp_object = cpp.geometry.BoundingBoxTree([])
+    points = numpy.array([[0.5, 0.5, 0.5], [2.0, 0.0, 0.0]])
+
+    closest, distance = geometry.compute_closest_entity(tree, tree_mid, mesh, points, 2)
+    assert (closest == -1).all()
+    assert (distance == numpy.finfo(numpy.float64).max).all()
+    c, d = cpp.geometry.compute_closest_entity_point(tree._cpp_object, tree_mid._cpp_object, points[0], mesh)
+    assert c == -1
+    assert d == numpy.finfo(numpy.float64).max
+
+
+def test_refit():
+    mesh = UnitCubeMesh(MPI.COMM_WORLD, 4, 4, 4)
+    tree = BoundingBoxTree(mesh, mesh.topology.dim)
+    assert tree.cost_ratio() == pytest.approx(1.0)
+
+    # Deform mesh and refit
+    x = mesh.geometry.x
+    x[:, 0] = x[:, 0] + 0.5 * x[:, 1] ** 2
+    x[:, 2] = 2.0 * x[:, 2]
+    assert not tree.refit(mesh)
+
+    points = numpy.random.RandomState(2).rand(30, 3) * [1.5, 1.0, 2.0]
+    tree_new = BoundingBoxTree(mesh, mesh.topology.dim)
+    for p in points:
+        entities, _ = geometry.compute_entity_collisions_mesh(tree, mesh, p)
+        entities_new, _ = geometry.compute_entity_collisions_mesh(tree_new, mesh, p)
+        assert set(entities) == set(entities_new)
+
+        procs = cpp.geometry.compute_process_collisions(tree._cpp_object, p)
+        procs_new = cpp.geometry.compute_process_collisions(tree_new._cpp_object, p)
+        assert set(procs) == set(procs_new)
+
+    # Force rebuild
+    assert tree.refit(mesh, 1.0e-6)
+    assert tree.cost_ratio() == pytest.approx(1.0)
+
+
+def test_refit_empty_partition():
+    # With fewer cells than processes, at least one process has no cells
+    comm = MPI.COMM_WORLD
+    mesh = UnitIntervalMesh(comm, max(comm.size - 1, 1))
+    tree = BoundingBoxTree(mesh, mesh.topology.dim)
+
+    # Stretch mesh and refit on all processes
+    mesh.geometry.x[:, 0] *= 2.0
+    tree.refit(mesh)
+
+    tree_new = BoundingBoxTree(mesh, mesh.topology.dim)
+    for p in numpy.linspace([-0.1, 0, 0], [2.1, 0, 0], 12):
+        entities, _ = geometry.compute_entity_collisions_mesh(tree, mesh, p)
+        entities_new, _ = geometry.compute_entity_collisions_mesh(tree_new, mesh, p)
+        assert set(entities) == set(entities_new)
+
+        procs = cpp.geometry.compute_process_collisions(tree._cpp_object, p)
+        procs_new = cpp.geometry.compute_process_collisions(tree_new._cpp_object, p)
+        assert set(procs) == set(procs_new)
+
+    # Force rebuild of the local trees, including empty ones
+    tree.refit(mesh, 1.0e-6)
+    assert tree.cost_ratio() == pytest.approx(1.0)
+
+
+def test_compute_distributed_collisions():
+    mesh0 = UnitCubeMesh(MPI.COMM_WORLD, 4, 4, 4)
+    mesh1 = UnitCubeMesh(MPI.COMM_WORLD, 3, 3, 3)
+    mesh1.geometry.x[:] += 0.45
+    tree0 = BoundingBoxTree(mesh0, mesh0.topology.dim)
+    tree1 = BoundingBoxTree(mesh1, mesh1.topology.dim)
+
+    pairs = geometry.compute_distributed_collisions(tree0, mesh0, tree1, mesh1, 3)
+    comm = mesh0.mpi_comm()
+    assert len(pairs) == comm.size
+
+    # Check against local tree-tree collisions for the pairs found on
+    # this process
+    if comm.size == 1:
+        cells0, cells1 = geometry.compute_collisions_bb(tree0, tree1)
+        assert set(map(tuple, pairs[0])) == set(zip(cells0, cells1))
+    num_pairs = comm.allreduce(sum(len(p) for p in pairs), op=MPI.SUM)
+    assert num_pairs > 0
+
+
+def test_collides_point_batch():
+    rng = numpy.random.RandomState(3)
+    n = 200
+    triangles = rng.rand(n, 9)
+    triangles[:, 2::3] = 0.0
+    points = rng.rand(n, 3)
+    points[:, 2] = 0.0
+
+    # Points on vertices and edges must be found exactly
+    points[:20] = triangles[:20, 3:6]
+    points[20:40] = 0.5 * (triangles[20:40, 0:3] + triangles[20:40, 6:9])
+
+    collides = cpp.geometry.CollisionPredicates.collides_triangle_point_2d_batch(triangles, points)
+    for i in range(n):
+        p0, p1, p2 = triangles[i, 0:3], triangles[i, 3:6], triangles[i, 6:9]
+        assert collides[i] == cpp.geometry.CollisionPredicates.collides_triangle_point_2d(p0, p1, p2, points[i])
+    assert collides[:20].all()
+
+    # Tetrahedra: vertices and centroids collide, reflected centroids
+    # do not
+    tets = rng.rand(n, 12)
+    x = tets.reshape(n, 4, 3)
+    collides = cpp.geometry.CollisionPredicates.collides_tetrahedron_point_3d_batch(tets, x[:, 2, :].copy())
+    assert collides.all()
+    centroid = x.mean(axis=1)
+    collides = cpp.geometry.CollisionPredicates.collides_tetrahedron_point_3d_batch(tets, centroid)
+    assert collides.all()
+    outside = 2.0 * x[:, 0, :] - centroid
+    collides = cpp.geometry.CollisionPredicates.collides_tetrahedron_point_3d_batch(tets, outside)
+    assert not collides.any()
+
+
+def test_collides_hexahedron_point():
+    # Parallelepiped with vertices A * (i, j, k), in DOLFINX ordering
+    A = numpy.array([[1.0, 0.3, -0.2], [0.1, 0.8, 0.4], [0.0, -0.3, 1.2]])
+    ref = numpy.array([[0, 0, 0], [1, 0, 0], [0, 1, 0], [1, 1, 0],
+                       [0, 0, 1], [1, 0, 1], [0, 1, 1], [1, 1, 1]], dtype=numpy.float64)
+    vertices = ref.dot(A.T)
+
+    # Vertices collide, and interior points collide if and only if their
+    # reference coordinates are in the unit cube
+    for v in vertices:
+        assert cpp.geometry.CollisionPredicates.collides_hexahedron_point_3d(vertices, v)
+    X = numpy.random.RandomState(4).rand(100, 3) * 1.4 - 0.2
+    for Xi in X:
+        inside = (Xi >= 0.0).all() and (Xi <= 1.0).all()
+        collides = cpp.geometry.CollisionPredicates.collides_hexahedron_point_3d(vertices, A.dot(Xi))
+        assert collides == inside
+
+
+def test_compute_entity_collisions_hexahedron():
+    mesh = UnitCubeMesh(MPI.COMM_WORLD, 3, 2, 4, cpp.mesh.CellType.hexahedron)
+    tree = BoundingBoxTree(mesh, mesh.topology.dim)
+    num_cells = mesh.topology.index_map(mesh.topology.dim).size_local
+    x = mesh.geometry.x
+
+    # Each point is in exactly one owned cell across all processes, and
+    # in the box of every cell found
+    points = numpy.random.RandomState(5).rand(50, 3)
+    num_found = numpy.zeros(len(points), dtype=numpy.int32)
+    for i, p in enumerate(points):
+        entities, _ = geometry.compute_entity_collisions_mesh(tree, mesh, p)
+        for c in entities:
+            coords = x[mesh.geometry.dofmap.links(c)]
+            assert (coords.min(axis=0) <= p).all() and (p <= coords.max(axis=0)).all()
+        num_found[i] = sum(1 for c in entities if c < num_cells)
+    assert (MPI.COMM_WORLD.allreduce(num_found, op=MPI.SUM) == 1).all()
+
+
+def test_compute_distance_to_facets():
+    mesh = UnitSquareMesh(MPI.COMM_WORLD, 8, 8)
+    V = FunctionSpace(mesh, ("Lagrange", 2))
+    facets = locate_entities_geometrical(mesh, 1, lambda x: numpy.full(x.shape[1], True), boundary_only=True)
+
+    x = V.tabulate_dof_coordinates()
+    d_exact = numpy.min([x[:, 0], 1.0 - x[:, 0], x[:, 1], 1.0 - x[:, 1]], axis=0)
+    d = geometry.compute_distance_to_facets(V, facets, num_threads=2)
+    assert numpy.allclose(d, d_exact)
+    d = geometry.compute_distance_to_facets(V, facets, signed_distance=True)
+    assert numpy.allclose(d, -d_exact)
+
+    # Points outside the domain
+    points = numpy.array([[1.5, 0.5, 0.0], [-0.3, -0.4, 0.0]])
+    d = cpp.geometry.compute_distance_to_facets(mesh, facets, points, True)
+    assert numpy.allclose(d, [0.5, 0.5])
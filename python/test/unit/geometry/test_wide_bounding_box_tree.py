@@ -0,0 +1,80 @@
+# Copyright (C) 2020 agent
+#
+# This file is part of DOLFINX (https://www.fenicsproject.org)
+#
+# SPDX-License-Identifier:    LGPL-3.0-or-later
+"""Unit tests for WideBoundingBoxTree, checked against BoundingBoxTree"""
+
+import numpy
+import pytest
+from mpi4py import MPI
+
+from dolfinx import UnitCubeMesh, UnitSquareMesh, cpp, geometry
+from dolfinx.geometry import BoundingBoxTree
+
+constructions = [cpp.geometry.WideBoundingBoxTree.Construction.sah,
+                 cpp.geometry.WideBoundingBoxTree.Construction.morton]
+
+
+def create_mesh(gdim):
+    if gdim == 2:
+        return UnitSquareMesh(MPI.COMM_WORLD, 7, 5)
+    else:
+        return UnitCubeMesh(MPI.COMM_WORLD, 4, 3, 5)
+
+
+def random_points(gdim, n, seed):
+    points = numpy.zeros((n, 3))
+    points[:, :gdim] = numpy.random.RandomState(seed).rand(n, gdim) * 1.2 - 0.1
+    return points
+
+
+def split(array, offsets):
+    return [set(array[offsets[i]:offsets[i + 1]]) for i in range(len(offsets) - 1)]
+
+
+@pytest.mark.parametrize("construction", constructions)
+@pytest.mark.parametrize("gdim", [2, 3])
+def test_point_collisions(gdim, construction):
+    mesh = create_mesh(gdim)
+    tdim = mesh.topology.dim
+    tree = BoundingBoxTree(mesh, tdim)
+    wide_tree = cpp.geometry.WideBoundingBoxTree(mesh, tdim, construction)
+    assert wide_tree.num_leaves() == mesh.topology.index_map(tdim).size_local \
+        + mesh.topology.index_map(tdim).num_ghosts
+
+    points = random_points(gdim, 50, 5)
+    reference = split(*geometry.compute_collisions_point(tree, points))
+    entities = split(*wide_tree.compute_collisions(points))
+    assert entities == reference
+
+    for p in points:
+        reference, _ = geometry.compute_entity_collisions_mesh(tree, mesh, p)
+        entities = wide_tree.compute_entity_collisions(p, mesh)
+        assert set(entities) == set(reference)
+
+
+@pytest.mark.parametrize("construction", constructions)
+@pytest.mark.parametrize("gdim", [2, 3])
+def test_box_collisions(gdim, construction):
+    mesh_A = create_mesh(gdim)
+    mesh_B = create_mesh(gdim)
+    mesh_B.geometry.x[:, :gdim] += numpy.array([0.31, 0.27, 0.23])[:gdim]
+    tdim = mesh_A.topology.dim
+
+    tree_A = BoundingBoxTree(mesh_A, tdim)
+    tree_B = BoundingBoxTree(mesh_B, tdim)
+    entities_A, entities_B = geometry.compute_collisions_bb(tree_A, tree_B)
+    reference = set(zip(entities_A, entities_B))
+
+    wide_tree = cpp.geometry.WideBoundingBoxTree(mesh_A, tdim, construction)
+    x = mesh_B.geometry.x
+    dofmap = mesh_B.geometry.dofmap
+    num_cells = mesh_B.topology.index_map(tdim).size_local + mesh_B.topology.index_map(tdim).num_ghosts
+    pairs = set()
+    for c in range(num_cells):
+        coords = x[dofmap.links(c)]
+        box = numpy.array([coords.min(axis=0), coords.max(axis=0)])
+        pairs.update((a, c) for a in wide_tree.compute_box_collisions(box))
+
+    assert pairs == reference
@@ -11,6 +11,7 @@ from mpi4py import MPI
 
 import ufl
 from dolfinx import UnitCubeMesh, UnitIntervalMesh, UnitSquareMesh, fem, cpp
+from dolfinx.cpp.io import HDF5Policy
 from dolfinx.cpp.mesh import CellType
 from dolfinx.io import XDMFFile
 from dolfinx_utils.test.fixtures import tempdir
@@ -79,6 +80,69 @@ def test_save_and_load_2d_mesh(tempdir, encoding, cell_type):
     assert mesh.topology.index_map(dim).size_global == mesh2.topology.index_map(dim).size_global
 
 
+@pytest.mark.skipif(not cpp.io.asynchronous_writes_supported(MPI.COMM_WORLD),
+                    reason="HDF5 is not threadsafe or MPI does not support MPI_THREAD_MULTIPLE")
+def test_save_and_load_mesh_asynchronous(tempdir):
+    filename = os.path.join(tempdir, "mesh_async.xdmf")
+    mesh = UnitCubeMesh(MPI.COMM_WORLD, 6, 5, 4)
+    with XDMFFile(mesh.mpi_comm(), filename, "w") as file:
+        file.set_asynchronous(True)
+        assert file.asynchronous()
+        file.write_mesh(mesh)
+        file.write_geometry(mesh.geometry)
+        file.wait()
+
+    with XDMFFile(MPI.COMM_WORLD, filename, "r") as file:
+        mesh2 = file.read_mesh()
+
+    assert mesh.topology.index_map(0).size_global == mesh2.topology.index_map(0).size_global
+    dim = mesh.topology.dim
+    assert mesh.topology.index_map(dim).size_global == mesh2.topology.index_map(dim).size_global
+
+
+@pytest.mark.parametrize("ghost_mode", [cpp.mesh.GhostMode.none, cpp.mesh.GhostMode.shared_facet])
+@pytest.mark.parametrize("cell_type", celltypes_3D)
+def test_save_and_load_mesh_partition(tempdir, cell_type, ghost_mode):
+    """Mesh read on the same number of processes should use the stored
+    partition"""
+    filename = os.path.join(tempdir, "mesh_partition.xdmf")
+    mesh = UnitCubeMesh(MPI.COMM_WORLD, 6, 5, 4, cell_type)
+    with XDMFFile(mesh.mpi_comm(), filename, "w") as file:
+        file.write_mesh(mesh)
+
+    with XDMFFile(MPI.COMM_WORLD, filename, "r") as file:
+        mesh2 = file.read_mesh(ghost_mode=ghost_mode)
+
+    dim = mesh.topology.dim
+    assert mesh.topology.index_map(dim).size_local == mesh2.topology.index_map(dim).size_local
+    assert mesh.topology.index_map(dim).size_global == mesh2.topology.index_map(dim).size_global
+    assert mesh.topology.index_map(0).size_global == mesh2.topology.index_map(0).size_global
+    if ghost_mode == cpp.mesh.GhostMode.none or MPI.COMM_WORLD.size == 1:
+        assert mesh2.topology.index_map(dim).num_ghosts == 0
+    else:
+        num_ghosts = MPI.COMM_WORLD.allreduce(mesh2.topology.index_map(dim).num_ghosts, op=MPI.SUM)
+        assert num_ghosts > 0
+
+
+def test_save_and_load_mesh_compressed(tempdir):
+    filename = os.path.join(tempdir, "mesh_compressed.xdmf")
+    mesh = UnitCubeMesh(MPI.COMM_WORLD, 6, 5, 4)
+    policy = HDF5Policy()
+    policy.float32 = True
+    policy.shuffle = True
+    policy.deflate_level = 4
+    with XDMFFile(mesh.mpi_comm(), filename, "w", policy=policy) as file:
+        file.write_mesh(mesh)
+
+    with XDMFFile(MPI.COMM_WORLD, filename, "r") as file:
+        mesh2 = file.read_mesh()
+
+    assert mesh.topology.index_map(0).size_global == mesh2.topology.index_map(0).size_global
+    dim = mesh.topology.dim
+    assert mesh.topology.index_map(dim).size_global == mesh2.topology.index_map(dim).size_global
+    assert mesh.mpi_comm().allreduce(mesh2.geometry.x[:, :dim].max(), op=MPI.MAX) == pytest.approx(1.0)
+
+
 @pytest.mark.parametrize("cell_type", celltypes_3D)
 @pytest.mark.parametrize("encoding", encodings)
 def test_save_and_load_3d_mesh(tempdir, encoding, cell_type):
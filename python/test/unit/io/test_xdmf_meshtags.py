@@ -10,7 +10,8 @@ import numpy as np
 import pytest
 from mpi4py import MPI
 
-from dolfinx.cpp.mesh import CellType
+from dolfinx import cpp
+from dolfinx.cpp.mesh import CellType, GhostMode
 from dolfinx.generation import UnitCubeMesh
 from dolfinx.io import XDMFFile
 from dolfinx.mesh import MeshTags, locate_entities_geometrical
@@ -77,3 +78,52 @@ def test_3d(tempdir, cell_type, encoding):
         (mt_lines_in.indices < mesh_in.topology.index_map(1).size_local).sum(), op=MPI.SUM)
 
     assert lines_local == lines_local_in
+
+
+def midpoint_tags(mesh, dim, entities):
+    """Tag value computed from the midpoint of each entity, so that tags
+    can be checked after the mesh has been redistributed"""
+    x = cpp.mesh.midpoints(mesh, dim, entities)
+    return np.floor(1000 * (x[:, 0] + 2 * x[:, 1] + 4 * x[:, 2]) + 0.25).astype(np.intc)
+
+
+@pytest.mark.parametrize("ghost_mode", [GhostMode.none, GhostMode.shared_facet])
+@pytest.mark.parametrize("cell_type", celltypes_3D)
+def test_facet_cell_roundtrip(tempdir, cell_type, ghost_mode):
+    """Tags written in parallel must be read back on the same facets
+    and cells"""
+    filename = os.path.join(tempdir, "meshtags_roundtrip.xdmf")
+    comm = MPI.COMM_WORLD
+    mesh = UnitCubeMesh(comm, 4, 3, 4, cell_type)
+    mesh.topology.create_connectivity_all()
+
+    # Tag the facets in the lower half (interior and boundary) and all cells
+    facets = locate_entities_geometrical(mesh, 2, lambda x: x[2] <= 0.5)
+    mt_facets = MeshTags(mesh, 2, facets, midpoint_tags(mesh, 2, facets))
+    mt_facets.name = "facets"
+    map_c = mesh.topology.index_map(3)
+    cells = np.arange(map_c.size_local + map_c.num_ghosts, dtype=np.intc)
+    mt_cells = MeshTags(mesh, 3, cells, midpoint_tags(mesh, 3, cells))
+    mt_cells.name = "cells"
+
+    with XDMFFile(comm, filename, "w") as file:
+        file.write_mesh(mesh)
+        file.write_meshtags(mt_facets)
+        file.write_meshtags(mt_cells)
+
+    with XDMFFile(comm, filename, "r") as file:
+        mesh_in = file.read_mesh(ghost_mode=ghost_mode)
+        mesh_in.topology.create_connectivity_all()
+        mt_facets_in = file.read_meshtags(mesh_in, "facets")
+        mt_cells_in = file.read_meshtags(mesh_in, "cells")
+
+    for dim, mt, mt_in in ((2, mt_facets, mt_facets_in), (3, mt_cells, mt_cells_in)):
+        # Each tag is attached to the entity it was written for
+        assert mt_in.dim == dim
+        assert np.all(mt_in.values == midpoint_tags(mesh_in, dim, mt_in.indices))
+
+        # Every owned entity that was tagged is tagged after reading
+        num_owned = comm.allreduce((mt.indices < mesh.topology.index_map(dim).size_local).sum(), op=MPI.SUM)
+        num_owned_in = comm.allreduce((mt_in.indices < mesh_in.topology.index_map(dim).size_local).sum(),
+                                      op=MPI.SUM)
+        assert num_owned == num_owned_in
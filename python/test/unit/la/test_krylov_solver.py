@@ -15,9 +15,10 @@ import ufl
 from dolfinx import (DirichletBC, Function, FunctionSpace,
                      UnitSquareMesh, VectorFunctionSpace)
 from dolfinx.fem import (apply_lifting, assemble_matrix, assemble_vector,
-                         locate_dofs_topological, set_bc)
-from dolfinx.la import VectorSpaceBasis
-from dolfinx.mesh import locate_entities_geometrical
+                         create_prolongation_matrix, locate_dofs_topological,
+                         set_bc)
+from dolfinx.la import PETScKrylovSolver, VectorSpaceBasis
+from dolfinx.mesh import locate_entities_geometrical, refine_with_parent_cells
 from mpi4py import MPI
 from petsc4py import PETSc
 from ufl import (Identity, TestFunction, TrialFunction, dot, dx, grad, inner,
@@ -53,6 +54,74 @@ def test_krylov_solver_lu():
     assert x.norm(PETSc.NormType.N2) == pytest.approx(norm, abs=1.0e-12)
 
 
+def test_krylov_solver_gmg():
+    """Solve Poisson problem with geometric multigrid on a hierarchy of
+    uniformly refined meshes"""
+
+    # Build hierarchy of function spaces and prolongation matrices
+    mesh = UnitSquareMesh(MPI.COMM_WORLD, 8, 8)
+    mesh.topology.create_entities(1)
+    V = FunctionSpace(mesh, ("Lagrange", 1))
+    prolongation = []
+    for i in range(3):
+        mesh, parent_cells = refine_with_parent_cells(mesh)
+        mesh.topology.create_entities(1)
+        V_fine = FunctionSpace(mesh, ("Lagrange", 1))
+        prolongation.append(create_prolongation_matrix(V, V_fine, parent_cells))
+        V = V_fine
+
+    u, v = TrialFunction(V), TestFunction(V)
+    a = inner(grad(u), grad(v)) * dx
+    L = inner(1.0, v) * dx
+
+    def boundary(x):
+        return np.full(x.shape[1], True)
+
+    facetdim = mesh.topology.dim - 1
+    bndry_facets = locate_entities_geometrical(mesh, facetdim, boundary, boundary_only=True)
+    u0 = Function(V)
+    bc = DirichletBC(u0, locate_dofs_topological(V, facetdim, bndry_facets))
+
+    A = assemble_matrix(a, [bc])
+    A.assemble()
+    b = assemble_vector(L)
+    apply_lifting(b, [a], [[bc]])
+    b.ghostUpdate(addv=PETSc.InsertMode.ADD, mode=PETSc.ScatterMode.REVERSE)
+    set_bc(b, [bc])
+
+    # Reference solution
+    solver = PETSc.KSP().create(mesh.mpi_comm())
+    solver.setOptionsPrefix("test_gmg_lu_")
+    opts = PETSc.Options("test_gmg_lu_")
+    opts["ksp_type"] = "preonly"
+    opts["pc_type"] = "lu"
+    solver.setFromOptions()
+    solver.setOperators(A)
+    x_ref = A.createVecRight()
+    solver.solve(b, x_ref)
+
+    # Geometric multigrid, with coarse operators by Galerkin projection
+    solver = PETSc.KSP().create(mesh.mpi_comm())
+    solver.setOptionsPrefix("test_gmg_")
+    opts = PETSc.Options("test_gmg_")
+    opts["ksp_type"] = "cg"
+    opts["ksp_rtol"] = 1.0e-10
+    opts["mg_levels_ksp_type"] = "chebyshev"
+    opts["mg_levels_pc_type"] = "jacobi"
+    opts["mg_coarse_ksp_type"] = "preonly"
+    opts["mg_coarse_pc_type"] = "redundant"
+    PETScKrylovSolver(solver).set_multigrid_interpolation(prolongation)
+    solver.setFromOptions()
+    assert solver.getPC().getType() == "mg"
+    assert solver.getPC().getMGLevels() == len(prolongation) + 1
+    solver.setOperators(A)
+    x = A.createVecRight()
+    solver.solve(b, x)
+
+    assert solver.getIterationNumber() < 15
+    assert (x - x_ref).norm() < 1.0e-8 * x_ref.norm()
+
+
 @pytest.mark.skip
 def test_krylov_samg_solver_elasticity():
     "Test PETScKrylovSolver with smoothed aggregation AMG"
@@ -272,6 +272,52 @@ def test_UnitHexMesh():
     assert mesh.mpi_comm().allreduce(mesh.topology.index_map(0).size_local, MPI.SUM) == 480
 
 
+@pytest.mark.parametrize("ghost_mode", [cpp.mesh.GhostMode.none,
+                                        cpp.mesh.GhostMode.shared_facet,
+                                        cpp.mesh.GhostMode.shared_vertex])
+@pytest.mark.parametrize("cell_type, diagonal", [(CellType.triangle, "right"),
+                                                 (CellType.triangle, "crossed"),
+                                                 (CellType.quadrilateral, "right"),
+                                                 (CellType.tetrahedron, None),
+                                                 (CellType.hexahedron, None)])
+def test_structured_mesh(cell_type, diagonal, ghost_mode):
+    """Create meshes on a process grid and compare with the partitioned
+    meshes"""
+    if diagonal is None:
+        mesh0 = UnitCubeMesh(MPI.COMM_WORLD, 5, 7, 9, cell_type, ghost_mode)
+        mesh1 = UnitCubeMesh(MPI.COMM_WORLD, 5, 7, 9, cell_type, ghost_mode, structured=True)
+    else:
+        mesh0 = UnitSquareMesh(MPI.COMM_WORLD, 5, 7, cell_type, ghost_mode, diagonal)
+        mesh1 = UnitSquareMesh(MPI.COMM_WORLD, 5, 7, cell_type, ghost_mode, diagonal, structured=True)
+
+    tdim = mesh1.topology.dim
+    for d in (0, tdim):
+        assert mesh1.topology.index_map(d).size_global == mesh0.topology.index_map(d).size_global
+    mesh1.topology.create_entities(tdim - 1)
+    mesh0.topology.create_entities(tdim - 1)
+    assert mesh1.topology.index_map(tdim - 1).size_global == mesh0.topology.index_map(tdim - 1).size_global
+
+    vol = mesh1.mpi_comm().allreduce(assemble_scalar(1 * dx(mesh1)), MPI.SUM)
+    assert vol == pytest.approx(1, rel=1e-9)
+
+    if ghost_mode != cpp.mesh.GhostMode.none and MPI.COMM_WORLD.size > 1:
+        assert mesh1.mpi_comm().allreduce(mesh1.topology.index_map(tdim).num_ghosts, MPI.SUM) > 0
+
+
+def test_structured_mesh_thin():
+    """Create meshes with fewer blocks than processes in some
+    directions"""
+    size = MPI.COMM_WORLD.size
+    mesh = UnitCubeMesh(MPI.COMM_WORLD, 2 * size, 1, 1, CellType.hexahedron, cpp.mesh.GhostMode.shared_facet,
+                        structured=True)
+    assert mesh.topology.index_map(3).size_global == 2 * size
+    assert mesh.topology.index_map(3).size_local > 0
+
+    if size > 1:
+        with pytest.raises(RuntimeError):
+            UnitSquareMesh(MPI.COMM_WORLD, 1, 1, CellType.quadrilateral, structured=True)
+
+
 def test_hash():
     h1 = UnitSquareMesh(MPI.COMM_WORLD, 4, 4).hash()
     h2 = UnitSquareMesh(MPI.COMM_WORLD, 4, 5).hash()
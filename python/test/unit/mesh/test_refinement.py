@@ -4,10 +4,14 @@
 #
 # SPDX-License-Identifier:    LGPL-3.0-or-later
 
+import numpy as np
+import pytest
 from mpi4py import MPI
 
-from dolfinx import FunctionSpace, UnitCubeMesh, UnitSquareMesh
-from dolfinx.mesh import refine
+import ufl
+from dolfinx import Constant, Function, FunctionSpace, UnitCubeMesh, UnitSquareMesh, VectorFunctionSpace
+from dolfinx.fem import assemble_scalar, create_prolongation_matrix
+from dolfinx.mesh import MeshTags, locate_entities_geometrical, mark_dorfler, refine, refine_with_parent_cells
 
 
 def test_RefineUnitSquareMesh():
@@ -41,6 +45,88 @@ def test_RefineUnitCubeMesh_keep_partition():
     assert(Q)
 
 
+@pytest.mark.parametrize("redistribute", [True, False])
+def test_refine_marked_conforming(redistribute):
+    """Local refinement propagates markers so that the refined mesh is
+    conforming"""
+    mesh = UnitSquareMesh(MPI.COMM_WORLD, 8, 8)
+    mesh.topology.create_entities(1)
+    cells = locate_entities_geometrical(mesh, 2, lambda x: np.logical_and(x[0] < 0.3, x[1] < 0.3))
+    marker = MeshTags(mesh, 2, cells, np.ones(len(cells), dtype=np.int8))
+    mesh_refined = refine(mesh, marker, redistribute=redistribute)
+    assert mesh_refined.topology.index_map(2).size_global > mesh.topology.index_map(2).size_global
+
+    # Hanging nodes would show up as extra exterior facets
+    one = Constant(mesh_refined, 1.0)
+    area = mesh.mpi_comm().allreduce(assemble_scalar(one * ufl.dx(mesh_refined)), op=MPI.SUM)
+    perimeter = mesh.mpi_comm().allreduce(assemble_scalar(one * ufl.ds(mesh_refined)), op=MPI.SUM)
+    assert area == pytest.approx(1.0, rel=1.0e-10)
+    assert perimeter == pytest.approx(4.0, rel=1.0e-10)
+
+
+@pytest.mark.parametrize("theta", [0.0, 0.3, 0.7, 1.0])
+def test_mark_dorfler(theta):
+    """Dorfler marking selects the smallest set of cells with the
+    largest indicators whose sum reaches the bulk fraction"""
+    mesh = UnitSquareMesh(MPI.COMM_WORLD, 8, 8)
+    mesh.topology.create_entities(1)
+    Q = FunctionSpace(mesh, ("DG", 0))
+    eta = Function(Q)
+    eta.interpolate(lambda x: np.exp(-10.0 * (x[0]**2 + 2.3 * x[1]**2)) + 0.01 * x[0])
+
+    marker = mark_dorfler(eta, theta)
+    assert marker.dim == 2
+
+    # Compare with a serial selection on the gathered values
+    num_cells = mesh.topology.index_map(2).size_local
+    values = eta.vector.array[:num_cells]
+    comm = mesh.mpi_comm()
+    all_values = np.sort(np.concatenate(comm.allgather(values)))[::-1]
+    num_required = np.searchsorted(np.cumsum(all_values), theta * all_values.sum() * (1.0 - 1.0e-12)) + 1
+    num_marked = comm.allreduce(len(marker.indices), op=MPI.SUM)
+    assert num_marked == min(num_required, len(all_values))
+    marked_dofs = [Q.dofmap.cell_dofs(c)[0] for c in marker.indices]
+    marked_sum = comm.allreduce(values[marked_dofs].sum(), op=MPI.SUM)
+    assert marked_sum >= theta * all_values.sum() * (1.0 - 1.0e-12)
+
+    mesh_refined = refine(mesh, marker, redistribute=False)
+    assert mesh_refined.topology.index_map(2).size_global > mesh.topology.index_map(2).size_global
+
+
+@pytest.mark.parametrize("degree", [1, 2])
+def test_prolongation(degree):
+    """Prolongation between nested meshes is exact for functions in the
+    coarse space"""
+    mesh0 = UnitSquareMesh(MPI.COMM_WORLD, 4, 5)
+    mesh0.topology.create_entities(1)
+    mesh1, parent_cells = refine_with_parent_cells(mesh0)
+    assert len(parent_cells) == mesh1.topology.index_map(2).size_local
+
+    def f(x):
+        return x[0]**degree + 2.0 * x[1]
+
+    V0 = FunctionSpace(mesh0, ("Lagrange", degree))
+    V1 = FunctionSpace(mesh1, ("Lagrange", degree))
+    P = create_prolongation_matrix(V0, V1, parent_cells)
+    assert P.getSize() == (V1.dim, V0.dim)
+
+    u0, u1, u1_ref = Function(V0), Function(V1), Function(V1)
+    u0.interpolate(f)
+    u1_ref.interpolate(f)
+    P.mult(u0.vector, u1.vector)
+    assert np.allclose(u1.vector.array, u1_ref.vector.array)
+
+    # Vector-valued space
+    W0 = VectorFunctionSpace(mesh0, ("Lagrange", degree))
+    W1 = VectorFunctionSpace(mesh1, ("Lagrange", degree))
+    P = create_prolongation_matrix(W0, W1, parent_cells)
+    w0, w1, w1_ref = Function(W0), Function(W1), Function(W1)
+    w0.interpolate(lambda x: np.row_stack((f(x), -x[1])))
+    w1_ref.interpolate(lambda x: np.row_stack((f(x), -x[1])))
+    P.mult(w0.vector, w1.vector)
+    assert np.allclose(w1.vector.array, w1_ref.vector.array)
+
+
 def xtest_refinement_gdim():
     """Test that 2D refinement is still 2D"""
     mesh = UnitSquareMesh(MPI.COMM_WORLD, 3, 4)
@@ -6,6 +6,7 @@
 """Unit tests for Newton solver assembly"""
 
 import numpy as np
+import pytest
 from mpi4py import MPI
 from petsc4py import PETSc
 
@@ -161,6 +162,147 @@ def test_nonlinear_pde():
     assert n < 6
 
 
+def create_nonlinear_pde(problem_class=NonlinearPDEProblem):
+    """Create the nonlinear PDE problem used to test variants of the
+    Newton solver. Returns the solution function and the problem."""
+    mesh = dolfinx.generation.UnitSquareMesh(MPI.COMM_WORLD, 12, 5)
+    V = function.FunctionSpace(mesh, ("Lagrange", 1))
+    u = dolfinx.function.Function(V)
+    v = TestFunction(V)
+    F = inner(5.0, v) * dx - ufl.sqrt(u * u) * inner(
+        grad(u), grad(v)) * dx - inner(u, v) * dx
+
+    def boundary(x):
+        """Define Dirichlet boundary (x = 0 or x = 1)."""
+        return np.logical_or(x[0] < 1.0e-8, x[0] > 1.0 - 1.0e-8)
+
+    u_bc = function.Function(V)
+    u_bc.vector.set(1.0)
+    u_bc.vector.ghostUpdate(addv=PETSc.InsertMode.INSERT, mode=PETSc.ScatterMode.FORWARD)
+    bc = fem.DirichletBC(u_bc, fem.locate_dofs_geometrical(V, boundary))
+    return u, problem_class(F, u, bc)
+
+
+def set_initial_guess(u):
+    u.vector.set(0.9)
+    u.vector.ghostUpdate(addv=PETSc.InsertMode.INSERT, mode=PETSc.ScatterMode.FORWARD)
+
+
+def solve_reference(u, problem):
+    """Solve with the default Newton solver and return the solution"""
+    set_initial_guess(u)
+    solver = dolfinx.cpp.nls.NewtonSolver(MPI.COMM_WORLD)
+    n, converged = solver.solve(problem, u.vector)
+    assert converged
+    return u.vector.copy()
+
+
+@pytest.mark.parametrize("jacobian_update_frequency, preconditioner_update_frequency, jacobian_updates, "
+                         "preconditioner_updates",
+                         [(0, 1, lambda n: 1, lambda n: 1),
+                          (1, 2, lambda n: n, lambda n: (n + 1) // 2)])
+def test_nonlinear_pde_lagged(jacobian_update_frequency, preconditioner_update_frequency, jacobian_updates,
+                              preconditioner_updates):
+    """Test modified and lagged Newton solver for a simple nonlinear PDE"""
+    u, problem = create_nonlinear_pde()
+    u0 = solve_reference(u, problem)
+
+    # With jacobian_update_frequency = 0 (modified Newton), the Jacobian
+    # is computed once only. Otherwise the preconditioner is lagged.
+    set_initial_guess(u)
+    solver = dolfinx.cpp.nls.NewtonSolver(MPI.COMM_WORLD)
+    solver.jacobian_update_frequency = jacobian_update_frequency
+    solver.preconditioner_update_frequency = preconditioner_update_frequency
+    solver.lagged_rate_max = 1.0
+    n, converged = solver.solve(problem, u.vector)
+    assert converged
+    assert solver.jacobian_updates() == jacobian_updates(n)
+    assert solver.preconditioner_updates() == preconditioner_updates(n)
+    assert np.allclose(u.vector.array, u0.array, rtol=1.0e-6)
+
+
+@pytest.mark.parametrize("line_search, relaxation_parameter",
+                         [(dolfinx.cpp.nls.NewtonSolver.LineSearch.basic, 1.0),
+                          (dolfinx.cpp.nls.NewtonSolver.LineSearch.backtracking, 2.0)])
+def test_nonlinear_pde_inexact_line_search(line_search, relaxation_parameter):
+    """Test Newton solver with forcing terms and line search for a
+    simple nonlinear PDE"""
+    u, problem = create_nonlinear_pde()
+    u0 = solve_reference(u, problem)
+
+    class RecordingNewtonSolver(dolfinx.cpp.nls.NewtonSolver):
+        """Record the step length and the Krylov solver tolerance of
+        each (trial) update"""
+
+        def __init__(self, comm):
+            super().__init__(comm)
+            self.steps, self.ksp_rtols = [], []
+
+        def update_solution(self, x, dx, relaxation, problem, it):
+            self.steps.append(relaxation)
+            self.ksp_rtols.append(self.krylov_solver.getTolerances()[0])
+            return super().update_solution(x, dx, relaxation, problem, it)
+
+    # Inexact Newton needs an iterative linear solver (block Jacobi
+    # uses ILU on each process)
+    set_initial_guess(u)
+    solver = RecordingNewtonSolver(MPI.COMM_WORLD)
+    ksp = solver.krylov_solver
+    ksp.setType("gmres")
+    ksp.getPC().setType("bjacobi")
+    rtol = ksp.getTolerances()[0]
+
+    # With backtracking, over-relax so that the line search has to damp
+    # steps
+    solver.eisenstat_walker = True
+    solver.line_search = line_search
+    solver.relaxation_parameter = relaxation_parameter
+    n, converged = solver.solve(problem, u.vector)
+    assert converged
+    assert np.allclose(u.vector.array, u0.array, rtol=1.0e-6)
+
+    # The linear solver tolerance follows the forcing terms, and is
+    # restored after the solve
+    assert solver.ksp_rtols[0] == pytest.approx(solver.eisenstat_walker_rtol0)
+    assert len(set(solver.ksp_rtols)) > 1
+    assert ksp.getTolerances()[0] == rtol
+
+    if line_search == dolfinx.cpp.nls.NewtonSolver.LineSearch.backtracking:
+        assert min(solver.steps) < relaxation_parameter
+    else:
+        assert solver.steps == [relaxation_parameter] * n
+
+
+class FusedProblem(NonlinearPDEProblem):
+    """Problem that counts the evaluations of F and J together"""
+    num_fused = 0
+
+    def FJ(self, x):
+        self.num_fused += 1
+        return self.F(x), self.J(x)
+
+
+@pytest.mark.parametrize("convergence_criterion", ["residual", "incremental"])
+def test_nonlinear_pde_evaluations(convergence_criterion):
+    """Test that F is only evaluated where needed, and together with J
+    where possible"""
+    u, problem = create_nonlinear_pde(FusedProblem)
+    set_initial_guess(u)
+    solver = dolfinx.cpp.nls.NewtonSolver(MPI.COMM_WORLD)
+    solver.convergence_criterion = convergence_criterion
+    n, converged = solver.solve(problem, u.vector)
+    assert converged
+    assert solver.jacobian_evaluations() == n
+    if convergence_criterion == "residual":
+        # F after every update
+        assert solver.residual_evaluations() == n + 1
+        assert problem.num_fused == 0
+    else:
+        # No F after the last update, and F and J computed together
+        assert solver.residual_evaluations() == n
+        assert problem.num_fused == n
+
+
 def test_nonlinear_pde_snes():
     """Test Newton solver for a simple nonlinear PDE"""
     # Create mesh and function space